@@ -64,8 +64,7 @@ template <int D> class BiCGStab
 			ms = vg->getNewVector();
 			mp = vg->getNewVector();
 		}
-		A->apply(x, resid);
-		resid->scaleThenAdd(-1, b);
+		A->residual(b, x, resid);
 		double                     r0_norm = b->twoNorm();
 		std::shared_ptr<Vector<D>> rhat    = vg->getNewVector();
 		rhat->copy(resid);
@@ -74,14 +73,17 @@ template <int D> class BiCGStab
 		std::shared_ptr<Vector<D>> ap = vg->getNewVector();
 		std::shared_ptr<Vector<D>> as = vg->getNewVector();
 
-		std::shared_ptr<Vector<D>> s   = vg->getNewVector();
-		double                     rho = rhat->dot(resid);
+		std::shared_ptr<Vector<D>> s = vg->getNewVector();
+
+		// rho and the residual norm share a single reduction
+		std::vector<double> resid_dots = resid->multiDotAndTwoNorm({rhat});
+		double              rho        = resid_dots[0];
 
 		int num_its = 0;
 		if (r0_norm == 0) {
 			return num_its;
 		}
-		double residual = resid->twoNorm() / r0_norm;
+		double residual = resid_dots[1] / r0_norm;
 		if (output) {
 			char buf[100];
 			sprintf(buf, "%5d %16.8e\n", num_its, residual);
@@ -106,20 +108,24 @@ template <int D> class BiCGStab
 			double alpha = rho / rhat->dot(ap);
 			s->copy(resid);
 			s->addScaled(-alpha, ap);
-			if (s->twoNorm() / r0_norm <= tolerance) {
-				x->addScaled(alpha, p);
-				if (timer) {
-					timer->stop("Iteration");
-				}
-				break;
-			}
+			// overlap the reduction for the norm of s with the next operator application
+			ReductionRequest s_norm_request = s->twoNormStart();
 			if (Mr != nullptr) {
 				Mr->apply(s, ms);
 				A->apply(ms, as);
 			} else {
 				A->apply(s, as);
 			}
-			double omega = as->dot(s) / as->dot(as);
+			if (s->twoNormFinish(s_norm_request) / r0_norm <= tolerance) {
+				x->addScaled(alpha, p);
+				if (timer) {
+					timer->stop("Iteration");
+				}
+				break;
+			}
+			// as.s and as.as share a single pass and reduction
+			std::vector<double> as_dots = as->multiDotAndSelfDot({s});
+			double              omega   = as_dots[0] / as_dots[1];
 
 			// update x and residual
 			if (Mr != nullptr) {
@@ -129,14 +135,15 @@ template <int D> class BiCGStab
 			}
 			resid->addScaled(-alpha, ap, -omega, as);
 
-			double rho_new = resid->dot(rhat);
+			resid_dots     = resid->multiDotAndTwoNorm({rhat});
+			double rho_new = resid_dots[0];
 			double beta    = rho_new * alpha / (rho * omega);
 			p->addScaled(-omega, ap);
 			p->scaleThenAdd(beta, resid);
 
 			num_its++;
 			rho      = rho_new;
-			residual = resid->twoNorm() / r0_norm;
+			residual = resid_dots[1] / r0_norm;
 
 			if (residual > 1e6) {
 				throw DivergenceError("BiCGStab reached divergence criteria on iteration "
@@ -27,9 +27,11 @@
 #include <ThunderEgg/GMG/Level.h>
 #include <ThunderEgg/PatchOperator.h>
 #include <ThunderEgg/PatchSolver.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
 #include <bitset>
 #include <map>
+#include <vector>
 
 namespace ThunderEgg
 {
@@ -59,6 +61,10 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 		 * @brief The number of components for each cell
 		 */
 		int num_components;
+		/**
+		 * @brief The communicator of the vectors
+		 */
+		MPI_Comm comm;
 
 		public:
 		/**
@@ -66,10 +72,11 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 		 *
 		 * @param pinfo the PatchInfo object for the patch
 		 * @param num_components the number of components for each cell
+		 * @param comm the communicator of the vectors, has to contain only this rank
 		 */
-		SingleVG(std::shared_ptr<const PatchInfo<D>> pinfo, int num_components)
+		SingleVG(std::shared_ptr<const PatchInfo<D>> pinfo, int num_components, MPI_Comm comm)
 		: lengths(pinfo->ns), num_ghost_cells(pinfo->num_ghost_cells),
-		  num_components(num_components)
+		  num_components(num_components), comm(comm)
 		{
 		}
 		/**
@@ -80,7 +87,7 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 		std::shared_ptr<Vector<D>> getNewVector() const override
 		{
 			return std::shared_ptr<Vector<D>>(
-			new ValVector<D>(MPI_COMM_SELF, lengths, num_ghost_cells, num_components, 1));
+			new ValVector<D>(comm, lengths, num_ghost_cells, num_components, 1));
 		}
 	};
 	/**
@@ -114,9 +121,10 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 		 * @brief Construct a new SinglePatchVec object
 		 *
 		 * @param ld_in the localdata for the patch
+		 * @param comm the communicator of the vector, has to contain only this rank
 		 */
-		SinglePatchVec(const std::vector<LocalData<D>> &lds)
-		: Vector<D>(MPI_COMM_SELF, lds.size(), 1, GetNumLocalCells(lds[0])), lds(lds)
+		SinglePatchVec(const std::vector<LocalData<D>> &lds, MPI_Comm comm)
+		: Vector<D>(comm, lds.size(), 1, GetNumLocalCells(lds[0])), lds(lds)
 		{
 		}
 		LocalData<D> getLocalData(int component_index, int local_patch_id) override
@@ -181,6 +189,13 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 	 * @brief whether or not to continue on BreakDownError
 	 */
 	bool continue_on_breakdown;
+	/**
+	 * @brief A duplicate of MPI_COMM_SELF for each thread of a patch loop
+	 *
+	 * Concurrent reductions on the same communicator are erroneous even with MPI_THREAD_MULTIPLE,
+	 * so the solves on each thread use their own communicator.
+	 */
+	std::vector<MPI_Comm> thread_comms;
 
 	public:
 	/**
@@ -196,16 +211,58 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 	: PatchSolver<D>(op_in->getDomain(), op_in->getGhostFiller()), op(op_in), max_it(max_it_in),
 	  tol(tol_in), continue_on_breakdown(continue_on_breakdown)
 	{
+		thread_comms.resize(GetNumPatchLoopThreads());
+		for (MPI_Comm &comm : thread_comms) {
+			MPI_Comm_dup(MPI_COMM_SELF, &comm);
+		}
+	}
+	BiCGStabPatchSolver(const BiCGStabPatchSolver<D> &) = delete;
+	BiCGStabPatchSolver<D> &operator=(const BiCGStabPatchSolver<D> &) = delete;
+	/**
+	 * @brief Destroy the BiCGStabPatchSolver object, freeing the communicators
+	 */
+	~BiCGStabPatchSolver()
+	{
+		int finalized;
+		MPI_Finalized(&finalized);
+		if (!finalized) {
+			for (MPI_Comm &comm : thread_comms) {
+				MPI_Comm_free(&comm);
+			}
+		}
+	}
+	/**
+	 * @brief Check if patches can be solved on several threads
+	 *
+	 * The iterations on each patch do reductions on a communicator for the thread, so this also
+	 * needs MPI to be initialized with MPI_THREAD_MULTIPLE.
+	 *
+	 * @return true if the PatchOperator is thread safe, MPI allows calls from any thread, and
+	 * there is a communicator for each of the threads
+	 */
+	bool isThreadSafe() const override
+	{
+		int provided;
+		MPI_Query_thread(&provided);
+		return provided == MPI_THREAD_MULTIPLE && op->isThreadSafe()
+		       && GetNumPatchLoopThreads() <= (int) thread_comms.size();
 	}
 	void solveSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
 	                      const std::vector<LocalData<D>> &   fs,
 	                      std::vector<LocalData<D>> &         us) const override
 	{
+		int thread = GetPatchLoopThreadNum();
+		if (thread >= (int) thread_comms.size()) {
+			throw RuntimeError("BiCGStabPatchSolver has no communicator for thread "
+			                   + std::to_string(thread));
+		}
+		MPI_Comm comm = thread_comms[thread];
+
 		std::shared_ptr<SinglePatchOp>      single_op(new SinglePatchOp(pinfo, op));
-		std::shared_ptr<VectorGenerator<D>> vg(new SingleVG(pinfo, fs.size()));
+		std::shared_ptr<VectorGenerator<D>> vg(new SingleVG(pinfo, fs.size(), comm));
 
-		std::shared_ptr<Vector<D>> f_single(new SinglePatchVec(fs));
-		std::shared_ptr<Vector<D>> u_single(new SinglePatchVec(us));
+		std::shared_ptr<Vector<D>> f_single(new SinglePatchVec(fs, comm));
+		std::shared_ptr<Vector<D>> u_single(new SinglePatchVec(us, comm));
 
 		auto f_copy = vg->getNewVector();
 		f_copy->copy(f_single);
@@ -220,7 +277,7 @@ template <int D> class BiCGStabPatchSolver : public PatchSolver<D>
 				throw err;
 			}
 		}
-		if (this->getDomain()->hasTimer()) {
+		if (this->getDomain()->hasTimer() && !InThreadedPatchLoop()) {
 			this->getDomain()->getTimer()->addIntInfo("Iterations", iterations);
 		}
 	}
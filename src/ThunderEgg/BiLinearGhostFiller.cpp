@@ -25,57 +25,106 @@ namespace ThunderEgg
 {
 namespace
 {
-void FillGhostForNormalNbr(const std::vector<LocalData<2>> &local_datas,
-                           const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+/**
+ * @brief Get the number of components to fill together for each cell
+ *
+ * @return int the number of components if the components of each cell are next to each other in
+ * both the local and neighbor data, 1 otherwise
+ */
+template <typename T>
+int NumCellComponents(const std::vector<LocalData<2, T>> &local_datas,
+                      const std::vector<LocalData<2, T>> &nbr_datas)
 {
-	for (size_t c = 0; c < local_datas.size(); c++) {
-		auto local_slice = local_datas[c].getSliceOnSide(side);
-		auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-		nested_loop<1>(
-		nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-		[&](const std::array<int, 1> &coord) { nbr_ghosts[coord] = local_slice[coord]; });
+	for (size_t c = 1; c < local_datas.size(); c++) {
+		if (local_datas[c].getPtr() != local_datas[0].getPtr() + c
+		    || nbr_datas[c].getPtr() != nbr_datas[0].getPtr() + c
+		    || local_datas[c].getStrides() != local_datas[0].getStrides()
+		    || nbr_datas[c].getStrides() != nbr_datas[0].getStrides()) {
+			return 1;
+		}
+	}
+	return local_datas.size();
+}
+template <typename T>
+void FillGhostForNormalNbr(const std::vector<LocalData<2, T>> &local_datas,
+                           const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
+{
+	int num_cell_components = NumCellComponents(local_datas, nbr_datas);
+	for (size_t c = 0; c < local_datas.size(); c += num_cell_components) {
+		auto local_slice  = local_datas[c].getSliceOnSide(side);
+		auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+		int  n            = nbr_ghosts.getLengths()[0];
+		int  ghost_stride = nbr_ghosts.getStrides()[0];
+		int  local_stride = local_slice.getStrides()[0];
+		nbr_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+			const T *local = local_slice.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				for (int cc = 0; cc < num_cell_components; cc++) {
+					ghosts[i * ghost_stride + cc] = local[i * local_stride + cc];
+				}
+			}
+		});
 	}
 }
+template <typename T>
 void FillGhostForCoarseNbr(std::shared_ptr<const PatchInfo<2>> pinfo,
-                           const std::vector<LocalData<2>> &   local_datas,
-                           const std::vector<LocalData<2>> &nbr_datas, const Side<2> side,
+                           const std::vector<LocalData<2, T>> &local_datas,
+                           const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side,
                            const Orthant<2> orthant)
 {
-	auto nbr_info = pinfo->getCoarseNbrInfo(side);
-	int  offset   = 0;
+	int offset = 0;
 	if (orthant.collapseOnAxis(side.getAxisIndex()) == Orthant<1>::upper()) {
 		offset = pinfo->ns[!side.getAxisIndex()];
 	}
-	for (size_t c = 0; c < local_datas.size(); c++) {
-		auto local_slice = local_datas[c].getSliceOnSide(side);
-		auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-		nested_loop<1>(nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-		               [&](const std::array<int, 1> &coord) {
-			               nbr_ghosts[{(coord[0] + offset) / 2}] += 2.0 / 3.0 * local_slice[coord];
-		               });
+	int num_cell_components = NumCellComponents(local_datas, nbr_datas);
+	for (size_t c = 0; c < local_datas.size(); c += num_cell_components) {
+		auto local_slice  = local_datas[c].getSliceOnSide(side);
+		auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+		int  n            = nbr_ghosts.getLengths()[0];
+		int  ghost_stride = nbr_ghosts.getStrides()[0];
+		int  local_stride = local_slice.getStrides()[0];
+		nbr_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+			const T *local = local_slice.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				for (int cc = 0; cc < num_cell_components; cc++) {
+					ghosts[(i + offset) / 2 * ghost_stride + cc]
+					+= 2.0 / 3.0 * local[i * local_stride + cc];
+				}
+			}
+		});
 	}
 }
+template <typename T>
 void FillGhostForFineNbr(std::shared_ptr<const PatchInfo<2>> pinfo,
-                         const std::vector<LocalData<2>> &   local_datas,
-                         const std::vector<LocalData<2>> &nbr_datas, const Side<2> side,
+                         const std::vector<LocalData<2, T>> &local_datas,
+                         const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side,
                          const Orthant<2> orthant)
 {
-	auto nbr_info = pinfo->getFineNbrInfo(side);
-	int  offset   = 0;
+	int offset = 0;
 	if (orthant.collapseOnAxis(side.getAxisIndex()) == Orthant<1>::upper()) {
 		offset = pinfo->ns[!side.getAxisIndex()];
 	}
-	for (size_t c = 0; c < local_datas.size(); c++) {
-		auto local_slice = local_datas[c].getSliceOnSide(side);
-		auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-		nested_loop<1>(nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-		               [&](const std::array<int, 1> &coord) {
-			               nbr_ghosts[coord] += 2.0 / 3.0 * local_slice[{(coord[0] + offset) / 2}];
-		               });
+	int num_cell_components = NumCellComponents(local_datas, nbr_datas);
+	for (size_t c = 0; c < local_datas.size(); c += num_cell_components) {
+		auto local_slice  = local_datas[c].getSliceOnSide(side);
+		auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+		int  n            = nbr_ghosts.getLengths()[0];
+		int  ghost_stride = nbr_ghosts.getStrides()[0];
+		int  local_stride = local_slice.getStrides()[0];
+		nbr_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+			const T *local = local_slice.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				for (int cc = 0; cc < num_cell_components; cc++) {
+					ghosts[i * ghost_stride + cc]
+					+= 2.0 / 3.0 * local[(i + offset) / 2 * local_stride + cc];
+				}
+			}
+		});
 	}
 }
+template <typename T>
 void FillLocalGhostsForCoarseNbr(std::shared_ptr<const PatchInfo<2>> pinfo,
-                                 const LocalData<2> &local_data, const Side<2> side)
+                                 const LocalData<2, T> &local_data, const Side<2> side)
 {
 	auto local_slice  = local_data.getSliceOnSide(side);
 	auto local_ghosts = local_data.getGhostSliceOnSide(side, 1);
@@ -83,31 +132,49 @@ void FillLocalGhostsForCoarseNbr(std::shared_ptr<const PatchInfo<2>> pinfo,
 	if (pinfo->getCoarseNbrInfo(side).orth_on_coarse == Orthant<1>::upper()) {
 		offset = pinfo->ns[!side.getAxisIndex()];
 	}
-	nested_loop<1>(local_ghosts.getStart(), local_ghosts.getEnd(),
-	               [&](const std::array<int, 1> &coord) {
-		               local_ghosts[coord] += 2.0 / 3.0 * local_slice[coord];
-		               if ((coord[0] + offset) % 2 == 0) {
-			               local_ghosts[{coord[0] + 1}] += -1.0 / 3.0 * local_slice[coord];
-		               } else {
-			               local_ghosts[{coord[0] - 1}] += -1.0 / 3.0 * local_slice[coord];
-		               }
-	               });
+	int n            = local_ghosts.getLengths()[0];
+	int ghost_stride = local_ghosts.getStrides()[0];
+	int local_stride = local_slice.getStrides()[0];
+	local_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+		const T *local = local_slice.getPtr(coord);
+		for (int i = 0; i < n; i++) {
+			ghosts[i * ghost_stride] += 2.0 / 3.0 * local[i * local_stride];
+			if ((i + offset) % 2 == 0) {
+				ghosts[(i + 1) * ghost_stride] += -1.0 / 3.0 * local[i * local_stride];
+			} else {
+				ghosts[(i - 1) * ghost_stride] += -1.0 / 3.0 * local[i * local_stride];
+			}
+		}
+	});
 }
-void FillLocalGhostsForFineNbr(const LocalData<2> &local_data, const Side<2> side)
+template <typename T>
+void FillLocalGhostsForFineNbr(const LocalData<2, T> &local_data, const Side<2> side)
 {
 	auto local_slice  = local_data.getSliceOnSide(side);
 	auto local_ghosts = local_data.getGhostSliceOnSide(side, 1);
-	nested_loop<1>(local_ghosts.getStart(), local_ghosts.getEnd(),
-	               [&](const std::array<int, 1> &coord) {
-		               local_ghosts[coord] += -1.0 / 3.0 * local_slice[coord];
-	               });
+	int  n            = local_ghosts.getLengths()[0];
+	int  ghost_stride = local_ghosts.getStrides()[0];
+	int  local_stride = local_slice.getStrides()[0];
+	local_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+		const T *local = local_slice.getPtr(coord);
+		for (int i = 0; i < n; i++) {
+			ghosts[i * ghost_stride] += -1.0 / 3.0 * local[i * local_stride];
+		}
+	});
+}
+/**
+ * @brief Get the coordinate of a cell in a slice on a side of a patch
+ */
+std::array<int, 2> Coord(std::shared_ptr<const PatchInfo<2>> pinfo, Side<2> side, int offset, int i)
+{
+	return GhostFillTerm<2>::CoordOnSide(pinfo->ns, side, offset, {i});
 }
 } // namespace
-void BiLinearGhostFiller::fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<2>> pinfo,
-                                                    const std::vector<LocalData<2>> &   local_datas,
-                                                    const std::vector<LocalData<2>> &   nbr_datas,
-                                                    const Side<2> side, const NbrType nbr_type,
-                                                    const Orthant<2> orthant) const
+template <typename T>
+void BasicBiLinearGhostFiller<T>::fillGhostCellsForNbrPatch(
+std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2, T>> &local_datas,
+const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side, const NbrType nbr_type,
+const Orthant<2> orthant) const
 {
 	switch (nbr_type) {
 		case NbrType::Normal:
@@ -124,8 +191,9 @@ void BiLinearGhostFiller::fillGhostCellsForNbrPatch(std::shared_ptr<const PatchI
 	}
 }
 
-void BiLinearGhostFiller::fillGhostCellsForLocalPatch(
-std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2>> &local_datas) const
+template <typename T>
+void BasicBiLinearGhostFiller<T>::fillGhostCellsForLocalPatch(
+std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2, T>> &local_datas) const
 {
 	for (auto &local_data : local_datas) {
 		for (Side<2> side : Side<2>::getValues()) {
@@ -147,4 +215,75 @@ std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2>> &loca
 		}
 	}
 }
-} // namespace ThunderEgg
\ No newline at end of file
+template <typename T>
+bool BasicBiLinearGhostFiller<T>::getNbrPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo,
+                                                     const Side<2> side, const NbrType nbr_type,
+                                                     const Orthant<2>               orthant,
+                                                     std::vector<GhostFillTerm<2>> &terms) const
+{
+	int n      = pinfo->ns[!side.getAxisIndex()];
+	int offset = 0;
+	if (orthant.collapseOnAxis(side.getAxisIndex()) == Orthant<1>::upper()) {
+		offset = n;
+	}
+	for (int i = 0; i < n; i++) {
+		switch (nbr_type) {
+			case NbrType::Normal:
+				terms.push_back(
+				{Coord(pinfo, side, 0, i), Coord(pinfo, side.opposite(), -1, i), 1});
+				break;
+			case NbrType::Coarse:
+				terms.push_back({Coord(pinfo, side, 0, i),
+				                 Coord(pinfo, side.opposite(), -1, (i + offset) / 2), 2.0 / 3.0});
+				break;
+			case NbrType::Fine:
+				terms.push_back({Coord(pinfo, side, 0, (i + offset) / 2),
+				                 Coord(pinfo, side.opposite(), -1, i), 2.0 / 3.0});
+				break;
+			default:
+				throw RuntimeError("Unsupported Nbr Type");
+		}
+	}
+	return true;
+}
+template <typename T>
+bool BasicBiLinearGhostFiller<T>::getLocalPatchStencil(
+std::shared_ptr<const PatchInfo<2>> pinfo, std::vector<GhostFillTerm<2>> &terms) const
+{
+	for (Side<2> side : Side<2>::getValues()) {
+		if (pinfo->hasNbr(side)) {
+			int n = pinfo->ns[!side.getAxisIndex()];
+			switch (pinfo->getNbrType(side)) {
+				case NbrType::Normal:
+					// nothing needs to be done
+					break;
+				case NbrType::Coarse: {
+					int offset = 0;
+					if (pinfo->getCoarseNbrInfo(side).orth_on_coarse == Orthant<1>::upper()) {
+						offset = n;
+					}
+					for (int i = 0; i < n; i++) {
+						int nbr_i = (i + offset) % 2 == 0 ? i + 1 : i - 1;
+						terms.push_back(
+						{Coord(pinfo, side, 0, i), Coord(pinfo, side, -1, i), 2.0 / 3.0});
+						terms.push_back(
+						{Coord(pinfo, side, 0, i), Coord(pinfo, side, -1, nbr_i), -1.0 / 3.0});
+					}
+				} break;
+				case NbrType::Fine:
+					for (int i = 0; i < n; i++) {
+						terms.push_back(
+						{Coord(pinfo, side, 0, i), Coord(pinfo, side, -1, i), -1.0 / 3.0});
+					}
+					break;
+				default:
+					throw RuntimeError("Unsupported Nbr Type");
+			}
+		}
+	}
+	return true;
+}
+} // namespace ThunderEgg
+// explicit instantiation
+template class ThunderEgg::BasicBiLinearGhostFiller<double>;
+template class ThunderEgg::BasicBiLinearGhostFiller<float>;
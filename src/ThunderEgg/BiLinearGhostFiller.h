@@ -28,25 +28,46 @@ namespace ThunderEgg
 /**
  * @brief Exchanges ghost cells on patches, uses a BiLinear interpolation scheme for refinement
  * boundaries
+ *
+ * @tparam T the scalar type of the vector values
  */
-class BiLinearGhostFiller : public MPIGhostFiller<2>
+template <typename T> class BasicBiLinearGhostFiller : public MPIGhostFiller<2, T>
 {
 	public:
 	/**
-	 * @brief Construct a new BiLinearGhostFiller object
+	 * @brief Construct a new BasicBiLinearGhostFiller object
 	 *
 	 * @param domain_in the domain to fill ghosts for
+	 * @param backend the backend used to exchange ghost values with other ranks
+	 * @param fill_diagonal_ghosts also fill the corner ghost cells
 	 */
-	BiLinearGhostFiller(std::shared_ptr<const Domain<2>> domain_in)
-	: MPIGhostFiller<2>(domain_in, 1)
+	BasicBiLinearGhostFiller(
+	std::shared_ptr<const Domain<2>> domain_in,
+	GhostExchangeBackend             backend              = GhostExchangeBackend::PointToPoint,
+	bool                             fill_diagonal_ghosts = false)
+	: MPIGhostFiller<2, T>(domain_in, 1, backend, fill_diagonal_ghosts)
 	{
 	}
 	void fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<2>> pinfo,
-	                               const std::vector<LocalData<2>> &   local_datas,
-	                               const std::vector<LocalData<2>> &nbr_datas, const Side<2> side,
-	                               const NbrType nbr_type, const Orthant<2> orthant) const override;
-	void fillGhostCellsForLocalPatch(std::shared_ptr<const PatchInfo<2>> pinfo,
-	                                 const std::vector<LocalData<2>> &local_datas) const override;
+	                               const std::vector<LocalData<2, T>> &local_datas,
+	                               const std::vector<LocalData<2, T>> &nbr_datas,
+	                               const Side<2> side, const NbrType nbr_type,
+	                               const Orthant<2> orthant) const override;
+	void
+	fillGhostCellsForLocalPatch(std::shared_ptr<const PatchInfo<2>> pinfo,
+	                            const std::vector<LocalData<2, T>> &local_datas) const override;
+	bool getNbrPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo, const Side<2> side,
+	                        const NbrType nbr_type, const Orthant<2> orthant,
+	                        std::vector<GhostFillTerm<2>> &terms) const override;
+	bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo,
+	                          std::vector<GhostFillTerm<2>> &     terms) const override;
 };
+/**
+ * @brief BasicBiLinearGhostFiller for double vectors
+ */
+using BiLinearGhostFiller = BasicBiLinearGhostFiller<double>;
 } // namespace ThunderEgg
+// explicit instantiation
+extern template class ThunderEgg::BasicBiLinearGhostFiller<double>;
+extern template class ThunderEgg::BasicBiLinearGhostFiller<float>;
 #endif
@@ -25,7 +25,8 @@ namespace ThunderEgg
 {
 namespace
 {
-void FillGhostForLocalWithCoarseNbr(const LocalData<2> &local_data, const Side<2> side)
+template <typename T>
+void FillGhostForLocalWithCoarseNbr(const LocalData<2, T> &local_data, const Side<2> side)
 {
 	auto inner_slice = local_data.getSliceOnSide(side, 1);
 	auto slice       = local_data.getSliceOnSide(side);
@@ -35,7 +36,8 @@ void FillGhostForLocalWithCoarseNbr(const LocalData<2> &local_data, const Side<2
 		ghost[{idx}] += 2 * slice[{idx}] / 3 - inner_slice[{idx}] / 5;
 	}
 }
-void FillGhostForLocalWithFineNbr(const LocalData<2> &local_data, const Side<2> side)
+template <typename T>
+void FillGhostForLocalWithFineNbr(const LocalData<2, T> &local_data, const Side<2> side)
 {
 	auto slice = local_data.getSliceOnSide(side);
 	auto ghost = local_data.getGhostSliceOnSide(side, 1);
@@ -46,19 +48,27 @@ void FillGhostForLocalWithFineNbr(const LocalData<2> &local_data, const Side<2>
 	}
 	ghost[{n - 1}] += -slice[{n - 1}] / 10 + slice[{n - 2}] / 15 - slice[{n - 3}] / 30;
 }
-void FillGhostForNormalNbr(const std::vector<LocalData<2>> &local_datas,
-                           const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+template <typename T>
+void FillGhostForNormalNbr(const std::vector<LocalData<2, T>> &local_datas,
+                           const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
 {
 	for (size_t c = 0; c < local_datas.size(); c++) {
-		auto local_slice = local_datas[c].getSliceOnSide(side);
-		auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-		nested_loop<1>(
-		nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-		[&](const std::array<int, 1> &coord) { nbr_ghosts[coord] = local_slice[coord]; });
+		auto local_slice  = local_datas[c].getSliceOnSide(side);
+		auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+		int  n            = nbr_ghosts.getLengths()[0];
+		int  ghost_stride = nbr_ghosts.getStrides()[0];
+		int  local_stride = local_slice.getStrides()[0];
+		nbr_ghosts.forEachLine([&](const std::array<int, 1> &coord, T *ghosts) {
+			const T *local = local_slice.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				ghosts[i * ghost_stride] = local[i * local_stride];
+			}
+		});
 	}
 }
-void FillGhostForCoarseNbrLower(const std::vector<LocalData<2>> &local_datas,
-                                const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+template <typename T>
+void FillGhostForCoarseNbrLower(const std::vector<LocalData<2, T>> &local_datas,
+                                const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
 {
 	for (size_t c = 0; c < local_datas.size(); c++) {
 		auto slice       = local_datas[c].getSliceOnSide(side);
@@ -70,8 +80,9 @@ void FillGhostForCoarseNbrLower(const std::vector<LocalData<2>> &local_datas,
 		}
 	}
 }
-void FillGhostForCoarseNbrUpper(const std::vector<LocalData<2>> &local_datas,
-                                const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+template <typename T>
+void FillGhostForCoarseNbrUpper(const std::vector<LocalData<2, T>> &local_datas,
+                                const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
 {
 	for (size_t c = 0; c < local_datas.size(); c++) {
 		auto slice       = local_datas[c].getSliceOnSide(side);
@@ -83,8 +94,9 @@ void FillGhostForCoarseNbrUpper(const std::vector<LocalData<2>> &local_datas,
 		}
 	}
 }
-void FillGhostForFineNbrLower(const std::vector<LocalData<2>> &local_datas,
-                              const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+template <typename T>
+void FillGhostForFineNbrLower(const std::vector<LocalData<2, T>> &local_datas,
+                              const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
 {
 	for (size_t c = 0; c < local_datas.size(); c++) {
 		auto slice = local_datas[c].getSliceOnSide(side);
@@ -103,8 +115,9 @@ void FillGhostForFineNbrLower(const std::vector<LocalData<2>> &local_datas,
 		}
 	}
 }
-void FillGhostForFineNbrUpper(const std::vector<LocalData<2>> &local_datas,
-                              const std::vector<LocalData<2>> &nbr_datas, const Side<2> side)
+template <typename T>
+void FillGhostForFineNbrUpper(const std::vector<LocalData<2, T>> &local_datas,
+                              const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side)
 {
 	for (size_t c = 0; c < local_datas.size(); c++) {
 		auto slice = local_datas[c].getSliceOnSide(side);
@@ -123,13 +136,106 @@ void FillGhostForFineNbrUpper(const std::vector<LocalData<2>> &local_datas,
 		ghost[{n - 1}] += 3 * slice[{n - 1}] / 4 - 3 * slice[{n - 2}] / 10 + slice[{n - 3}] / 12;
 	}
 }
+/**
+ * @brief Appends the terms for a single ghost cell
+ */
+class GhostTerms
+{
+	private:
+	std::shared_ptr<const PatchInfo<2>> pinfo;
+	std::vector<GhostFillTerm<2>> &     terms;
+	Side<2>                             src_side;
+	Side<2>                             dst_side;
+
+	public:
+	GhostTerms(std::shared_ptr<const PatchInfo<2>> pinfo, std::vector<GhostFillTerm<2>> &terms,
+	           Side<2> src_side, Side<2> dst_side)
+	: pinfo(pinfo), terms(terms), src_side(src_side), dst_side(dst_side)
+	{
+	}
+	/**
+	 * @brief add weight times the value in slice src_offset at src_i to the ghost cell dst_i
+	 */
+	void add(int dst_i, int src_offset, int src_i, double weight)
+	{
+		terms.push_back({GhostFillTerm<2>::CoordOnSide(pinfo->ns, src_side, src_offset, {src_i}),
+		                 GhostFillTerm<2>::CoordOnSide(pinfo->ns, dst_side, -1, {dst_i}), weight});
+	}
+};
+void AddTermsForLocalWithCoarseNbr(GhostTerms &ghost, int n)
+{
+	for (int idx = 0; idx < n; idx++) {
+		ghost.add(idx, 0, idx, 2.0 / 3.0);
+		ghost.add(idx, 1, idx, -1.0 / 5.0);
+	}
+}
+void AddTermsForLocalWithFineNbr(GhostTerms &ghost, int n)
+{
+	ghost.add(0, 0, 0, -1.0 / 10.0);
+	ghost.add(0, 0, 1, 1.0 / 15.0);
+	ghost.add(0, 0, 2, -1.0 / 30.0);
+	for (int idx = 1; idx < n - 1; idx++) {
+		ghost.add(idx, 0, idx - 1, -1.0 / 30.0);
+		ghost.add(idx, 0, idx + 1, -1.0 / 30.0);
+	}
+	ghost.add(n - 1, 0, n - 1, -1.0 / 10.0);
+	ghost.add(n - 1, 0, n - 2, 1.0 / 15.0);
+	ghost.add(n - 1, 0, n - 3, -1.0 / 30.0);
+}
+void AddTermsForCoarseNbr(GhostTerms &ghost, int n, int offset)
+{
+	for (int idx = 0; idx < n; idx++) {
+		ghost.add((idx + offset) / 2, 0, idx, 1.0 / 3.0);
+		ghost.add((idx + offset) / 2, 1, idx, 1.0 / 5.0);
+	}
+}
+void AddTermsForFineNbrLower(GhostTerms &ghost, int n)
+{
+	ghost.add(0, 0, 0, 3.0 / 4.0);
+	ghost.add(0, 0, 1, -3.0 / 10.0);
+	ghost.add(0, 0, 2, 1.0 / 12.0);
+	ghost.add(1, 0, 0, 7.0 / 20.0);
+	ghost.add(1, 0, 1, 7.0 / 30.0);
+	ghost.add(1, 0, 2, -1.0 / 20.0);
+	for (int idx = 2; idx < n; idx++) {
+		if (idx % 2 == 0) {
+			ghost.add(idx, 0, idx / 2 - 1, 1.0 / 12.0);
+			ghost.add(idx, 0, idx / 2, 1.0 / 2.0);
+			ghost.add(idx, 0, idx / 2 + 1, -1.0 / 20.0);
+		} else {
+			ghost.add(idx, 0, idx / 2 - 1, -1.0 / 20.0);
+			ghost.add(idx, 0, idx / 2, 1.0 / 2.0);
+			ghost.add(idx, 0, idx / 2 + 1, 1.0 / 12.0);
+		}
+	}
+}
+void AddTermsForFineNbrUpper(GhostTerms &ghost, int n)
+{
+	for (int idx = 0; idx < n - 2; idx++) {
+		if ((idx + n) % 2 == 0) {
+			ghost.add(idx, 0, (idx + n) / 2 - 1, 1.0 / 12.0);
+			ghost.add(idx, 0, (idx + n) / 2, 1.0 / 2.0);
+			ghost.add(idx, 0, (idx + n) / 2 + 1, -1.0 / 20.0);
+		} else {
+			ghost.add(idx, 0, (idx + n) / 2 - 1, -1.0 / 20.0);
+			ghost.add(idx, 0, (idx + n) / 2, 1.0 / 2.0);
+			ghost.add(idx, 0, (idx + n) / 2 + 1, 1.0 / 12.0);
+		}
+	}
+	ghost.add(n - 2, 0, n - 1, 7.0 / 20.0);
+	ghost.add(n - 2, 0, n - 2, 7.0 / 30.0);
+	ghost.add(n - 2, 0, n - 3, -1.0 / 20.0);
+	ghost.add(n - 1, 0, n - 1, 3.0 / 4.0);
+	ghost.add(n - 1, 0, n - 2, -3.0 / 10.0);
+	ghost.add(n - 1, 0, n - 3, 1.0 / 12.0);
+}
 } // namespace
 
-void BiQuadraticGhostFiller::fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<2>> pinfo,
-                                                       const std::vector<LocalData<2>> &local_datas,
-                                                       const std::vector<LocalData<2>> &nbr_datas,
-                                                       const Side<2> side, const NbrType nbr_type,
-                                                       const Orthant<2> orthant) const
+template <typename T>
+void BasicBiQuadraticGhostFiller<T>::fillGhostCellsForNbrPatch(
+std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2, T>> &local_datas,
+const std::vector<LocalData<2, T>> &nbr_datas, const Side<2> side, const NbrType nbr_type,
+const Orthant<2> orthant) const
 {
 	switch (nbr_type) {
 		case NbrType::Normal:
@@ -154,8 +260,9 @@ void BiQuadraticGhostFiller::fillGhostCellsForNbrPatch(std::shared_ptr<const Pat
 	}
 }
 
-void BiQuadraticGhostFiller::fillGhostCellsForLocalPatch(
-std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2>> &local_datas) const
+template <typename T>
+void BasicBiQuadraticGhostFiller<T>::fillGhostCellsForLocalPatch(
+std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2, T>> &local_datas) const
 {
 	for (const auto &local_data : local_datas) {
 		for (Side<2> side : Side<2>::getValues()) {
@@ -177,4 +284,63 @@ std::shared_ptr<const PatchInfo<2>> pinfo, const std::vector<LocalData<2>> &loca
 		}
 	}
 }
+template <typename T>
+bool BasicBiQuadraticGhostFiller<T>::getNbrPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo,
+                                                        const Side<2> side, const NbrType nbr_type,
+                                                        const Orthant<2>               orthant,
+                                                        std::vector<GhostFillTerm<2>> &terms) const
+{
+	GhostTerms ghost(pinfo, terms, side, side.opposite());
+	int        n     = pinfo->ns[!side.getAxisIndex()];
+	bool       lower = orthant.collapseOnAxis(side.getAxisIndex()) == Orthant<1>::lower();
+	switch (nbr_type) {
+		case NbrType::Normal:
+			for (int idx = 0; idx < n; idx++) {
+				ghost.add(idx, 0, idx, 1);
+			}
+			break;
+		case NbrType::Coarse:
+			AddTermsForCoarseNbr(ghost, n, lower ? 0 : n);
+			break;
+		case NbrType::Fine:
+			if (lower) {
+				AddTermsForFineNbrLower(ghost, n);
+			} else {
+				AddTermsForFineNbrUpper(ghost, n);
+			}
+			break;
+		default:
+			throw RuntimeError("Unsupported NbrType");
+	}
+	return true;
+}
+
+template <typename T>
+bool BasicBiQuadraticGhostFiller<T>::getLocalPatchStencil(
+std::shared_ptr<const PatchInfo<2>> pinfo, std::vector<GhostFillTerm<2>> &terms) const
+{
+	for (Side<2> side : Side<2>::getValues()) {
+		if (pinfo->hasNbr(side)) {
+			GhostTerms ghost(pinfo, terms, side, side);
+			int        n = pinfo->ns[!side.getAxisIndex()];
+			switch (pinfo->getNbrType(side)) {
+				case NbrType::Normal:
+					// nothing need to be done
+					break;
+				case NbrType::Coarse:
+					AddTermsForLocalWithCoarseNbr(ghost, n);
+					break;
+				case NbrType::Fine:
+					AddTermsForLocalWithFineNbr(ghost, n);
+					break;
+				default:
+					throw RuntimeError("Unsupported NbrType");
+			}
+		}
+	}
+	return true;
+}
 } // namespace ThunderEgg
+// explicit instantiation
+template class ThunderEgg::BasicBiQuadraticGhostFiller<double>;
+template class ThunderEgg::BasicBiQuadraticGhostFiller<float>;
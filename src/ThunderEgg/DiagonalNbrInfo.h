@@ -0,0 +1,144 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+#ifndef THUNDEREGG_DIAGONALNBRINFO_H
+#define THUNDEREGG_DIAGONALNBRINFO_H
+#include <ThunderEgg/LocalData.h>
+#include <ThunderEgg/NbrType.h>
+
+namespace ThunderEgg
+{
+/**
+ * @brief Represents a patch that fills some of the edge or corner ghost cells of another patch.
+ *
+ * The edge and corner ghost cells of a patch are the ghost cells that are outside of the patch on
+ * more than one axis. In 2D these are the corner ghost cells, in 3D these are the edge and corner
+ * ghost cells.
+ *
+ * @tparam D the number of Cartesian dimensions on a patch.
+ */
+template <int D> class DiagonalNbrInfo
+{
+	public:
+	/**
+	 * @brief The id of the patch that the ghost cells are on
+	 */
+	int id = 0;
+	/**
+	 * @brief The mpi rank of the patch that the ghost cells are on
+	 */
+	int rank = 0;
+	/**
+	 * @brief The local index of the patch that the ghost cells are on, -1 if the patch is on a
+	 * different rank
+	 */
+	int local_index = -1;
+	/**
+	 * @brief The id of the neighbor that fills the ghost cells
+	 */
+	int nbr_id = 0;
+	/**
+	 * @brief The mpi rank of the neighbor that fills the ghost cells
+	 */
+	int nbr_rank = 0;
+	/**
+	 * @brief The local index of the neighbor, -1 if the neighbor is on a different rank
+	 */
+	int nbr_local_index = -1;
+	/**
+	 * @brief The direction of the ghost cells from the patch.
+	 *
+	 * Each value is -1, 0, or 1, and at least two values are nonzero.
+	 */
+	std::array<int, D> direction;
+	/**
+	 * @brief The refinement level of the neighbor relative to the patch
+	 */
+	NbrType nbr_type = NbrType::Normal;
+	/**
+	 * @brief The coordinate of the first ghost cell that is filled, in the patch's coordinates
+	 */
+	std::array<int, D> start;
+	/**
+	 * @brief The coordinate of the last ghost cell that is filled, in the patch's coordinates
+	 */
+	std::array<int, D> end;
+	/**
+	 * @brief Offset between the patch's coordinates and the neighbor's coordinates.
+	 *
+	 * For Normal neighbors, the cell at coord in the patch is the cell at coord+offset in the
+	 * neighbor. For Coarse neighbors, it lies in the cell at (coord+offset)/2 of the neighbor. For
+	 * Fine neighbors, it covers the cells from 2*coord+offset to 2*coord+offset+1 of the neighbor.
+	 */
+	std::array<int, D> offset;
+	/**
+	 * @brief Get the number of ghost cells that are filled
+	 */
+	int getNumCells() const
+	{
+		int num_cells = 1;
+		for (int i = 0; i < D; i++) {
+			num_cells *= end[i] - start[i] + 1;
+		}
+		return num_cells;
+	}
+	/**
+	 * @brief Get the value of a ghost cell from the neighbor's values
+	 *
+	 * Values from a Normal neighbor are copied, values from a Coarse neighbor are the value of the
+	 * coarse cell that the ghost cell lies in, and values from Fine neighbors are the average of
+	 * the fine cells that cover the ghost cell.
+	 *
+	 * @tparam T the scalar type of the values
+	 * @param nbr_data the neighbor's values
+	 * @param coord the coordinate of the ghost cell, in the patch's coordinates
+	 * @return double the value of the ghost cell
+	 */
+	template <typename T>
+	double getGhostValue(const LocalData<D, T> &nbr_data, const std::array<int, D> &coord) const
+	{
+		std::array<int, D> nbr_coord;
+		switch (nbr_type) {
+			case NbrType::Normal:
+				for (int i = 0; i < D; i++) {
+					nbr_coord[i] = coord[i] + offset[i];
+				}
+				return nbr_data[nbr_coord];
+			case NbrType::Coarse:
+				for (int i = 0; i < D; i++) {
+					nbr_coord[i] = (coord[i] + offset[i]) / 2;
+				}
+				return nbr_data[nbr_coord];
+			case NbrType::Fine: {
+				double sum = 0;
+				for (int child = 0; child < (1 << D); child++) {
+					for (int i = 0; i < D; i++) {
+						nbr_coord[i] = 2 * coord[i] + offset[i] + ((child >> i) & 1);
+					}
+					sum += nbr_data[nbr_coord];
+				}
+				return sum / (1 << D);
+			}
+		}
+		return 0;
+	}
+};
+} // namespace ThunderEgg
+#endif
@@ -21,9 +21,12 @@
 
 #ifndef THUNDEREGG_DOMAIN_H
 #define THUNDEREGG_DOMAIN_H
+#include <ThunderEgg/DiagonalNbrInfo.h>
 #include <ThunderEgg/PatchInfo.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/Timer.h>
 #include <ThunderEgg/Vector.h>
+#include <algorithm>
 #include <cmath>
 #include <deque>
 #include <map>
@@ -319,6 +322,20 @@ template <int D> class Domain
 	{
 		return num_ghost_cells;
 	}
+	/**
+	 * @brief Find the patches that fill the edge and corner ghost cells of patches
+	 *
+	 * The faces of patches only give the neighbors that fill the ghost cells on each side. An edge
+	 * or corner neighbor is at most D faces away, so the patches that overlap the edge and corner
+	 * ghost cells are found among the neighbors of the face neighbors. The locations of the patches
+	 * near the rank boundaries are shared with the neighboring ranks.
+	 *
+	 * This has to be called on all ranks. Patch sizes on refinement boundaries have to be even.
+	 *
+	 * @return std::vector<DiagonalNbrInfo<D>> all the pairs of patches where either the patch or
+	 * the neighbor is on this rank, sorted by the patch id, the direction, and the neighbor id
+	 */
+	std::vector<DiagonalNbrInfo<D>> findDiagonalNbrs() const;
 	/**
 	 * @brief Get the volume of the domain.
 	 *
@@ -626,6 +643,245 @@ template <int D> void Domain<D>::indexBCGlobal()
 		}
 	}
 }
+template <int D> std::vector<DiagonalNbrInfo<D>> Domain<D>::findDiagonalNbrs() const
+{
+	int my_rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+	// id -> (rank, starts, spacings) and the face neighbor ids of every patch that is known on
+	// this rank
+	using Location = std::tuple<int, std::array<double, D>, std::array<double, D>>;
+	std::map<int, Location>         known;
+	std::map<int, std::vector<int>> known_nbr_ids;
+	// for each neighboring rank, the patches on this rank that have a face neighbor on that rank
+	std::map<int, std::set<int>> boundary_ids;
+	for (auto pinfo : pinfo_vector) {
+		known[pinfo->id] = Location(my_rank, pinfo->starts, pinfo->spacings);
+		std::deque<int> nbr_ids   = pinfo->getNbrIds();
+		std::deque<int> nbr_ranks = pinfo->getNbrRanks();
+		known_nbr_ids[pinfo->id].assign(nbr_ids.begin(), nbr_ids.end());
+		for (size_t i = 0; i < nbr_ranks.size(); i++) {
+			if (nbr_ranks[i] != my_rank) {
+				boundary_ids[nbr_ranks[i]].insert(pinfo->id);
+			}
+		}
+	}
+
+	// the ids of the patches that are at most max_hops faces away from the given patches, in the
+	// part of the face neighbor graph that is known on this rank
+	auto withinHops = [&](const std::set<int> &start_ids, int max_hops) {
+		std::set<int>    found = start_ids;
+		std::vector<int> frontier(start_ids.begin(), start_ids.end());
+		for (int hop = 0; hop < max_hops; hop++) {
+			std::vector<int> next;
+			for (int id : frontier) {
+				auto iter = known_nbr_ids.find(id);
+				if (iter != known_nbr_ids.end()) {
+					for (int nbr_id : iter->second) {
+						if (found.insert(nbr_id).second) {
+							next.push_back(nbr_id);
+						}
+					}
+				}
+			}
+			frontier.swap(next);
+		}
+		return found;
+	};
+
+	// an edge or corner neighbor is at most D faces away. Each round, a neighboring rank is sent
+	// the patches that are at most D - 1 faces away from its boundary with this rank, so after D
+	// rounds every rank knows the patches that are at most D faces away from its own patches.
+	const int max_nbrs    = D * (1 << D);
+	const int record_size = 2 + 2 * D + max_nbrs;
+	std::map<int, std::set<int>> sent_ids;
+	for (int round = 0; round < D; round++) {
+		std::vector<std::vector<double>> outs;
+		for (const auto &p : boundary_ids) {
+			int                 nbr_rank = p.first;
+			std::vector<double> out;
+			for (int id : withinHops(p.second, D - 1)) {
+				auto iter = known.find(id);
+				if (iter == known.end() || std::get<0>(iter->second) == nbr_rank
+				    || !sent_ids[nbr_rank].insert(id).second) {
+					continue;
+				}
+				out.push_back(id);
+				out.push_back(std::get<0>(iter->second));
+				for (int i = 0; i < D; i++) {
+					out.push_back(std::get<1>(iter->second)[i]);
+				}
+				for (int i = 0; i < D; i++) {
+					out.push_back(std::get<2>(iter->second)[i]);
+				}
+				const std::vector<int> &nbr_ids = known_nbr_ids.at(id);
+				for (int i = 0; i < max_nbrs; i++) {
+					out.push_back(i < (int) nbr_ids.size() ? nbr_ids[i] : -1);
+				}
+			}
+			outs.push_back(out);
+		}
+		std::vector<int>         out_sizes(outs.size());
+		std::vector<int>         in_sizes(outs.size());
+		std::vector<MPI_Request> requests;
+		int                      index = 0;
+		for (const auto &p : boundary_ids) {
+			out_sizes[index] = outs[index].size();
+			requests.emplace_back();
+			MPI_Irecv(&in_sizes[index], 1, MPI_INT, p.first, 0, MPI_COMM_WORLD, &requests.back());
+			requests.emplace_back();
+			MPI_Isend(&out_sizes[index], 1, MPI_INT, p.first, 0, MPI_COMM_WORLD, &requests.back());
+			index++;
+		}
+		MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+		requests.clear();
+		std::vector<std::vector<double>> ins(outs.size());
+		index = 0;
+		for (const auto &p : boundary_ids) {
+			ins[index].resize(in_sizes[index]);
+			requests.emplace_back();
+			MPI_Irecv(ins[index].data(), in_sizes[index], MPI_DOUBLE, p.first, 0, MPI_COMM_WORLD,
+			          &requests.back());
+			requests.emplace_back();
+			MPI_Isend(outs[index].data(), out_sizes[index], MPI_DOUBLE, p.first, 0,
+			          MPI_COMM_WORLD, &requests.back());
+			index++;
+		}
+		MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+		for (const std::vector<double> &in : ins) {
+			for (size_t pos = 0; pos < in.size(); pos += record_size) {
+				int      id = in[pos];
+				Location location;
+				std::get<0>(location) = in[pos + 1];
+				for (int i = 0; i < D; i++) {
+					std::get<1>(location)[i] = in[pos + 2 + i];
+					std::get<2>(location)[i] = in[pos + 2 + D + i];
+				}
+				if (known.emplace(id, location).second) {
+					std::vector<int> &nbr_ids = known_nbr_ids[id];
+					for (int i = 0; i < max_nbrs; i++) {
+						int nbr_id = in[pos + 2 + 2 * D + i];
+						if (nbr_id != -1) {
+							nbr_ids.push_back(nbr_id);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// the directions of the edge and corner ghost cells
+	std::vector<std::array<int, D>> directions;
+	std::array<int, D>              dir_start;
+	std::array<int, D>              dir_end;
+	dir_start.fill(-1);
+	dir_end.fill(1);
+	nested_loop<D>(dir_start, dir_end, [&](const std::array<int, D> &dir) {
+		int num_nonzero = 0;
+		for (int i = 0; i < D; i++) {
+			num_nonzero += dir[i] != 0;
+		}
+		if (num_nonzero >= 2) {
+			directions.push_back(dir);
+		}
+	});
+
+	auto getLocalIndex = [&](int id) -> int {
+		auto iter = pinfo_id_map.find(id);
+		return iter == pinfo_id_map.end() ? -1 : iter->second->local_index;
+	};
+	auto toInt = [](double value) -> int {
+		int rounded = (int) std::round(value);
+		if (std::abs(value - rounded) > 1e-6) {
+			throw RuntimeError("Edge and corner neighbors do not line up with cells, patch "
+			                   "sizes on refinement boundaries have to be even");
+		}
+		return rounded;
+	};
+
+	std::vector<DiagonalNbrInfo<D>> infos;
+	auto addOverlaps = [&](int id, const Location &location, int nbr_id,
+	                       const Location &nbr_location) {
+		const std::array<double, D> &starts       = std::get<1>(location);
+		const std::array<double, D> &spacings     = std::get<2>(location);
+		const std::array<double, D> &nbr_starts   = std::get<1>(nbr_location);
+		const std::array<double, D> &nbr_spacings = std::get<2>(nbr_location);
+		for (const std::array<int, D> &dir : directions) {
+			std::array<double, D> lower;
+			std::array<double, D> upper;
+			bool                  overlaps = true;
+			for (int i = 0; i < D; i++) {
+				double patch_upper = starts[i] + ns[i] * spacings[i];
+				double ghost_lower = starts[i];
+				double ghost_upper = patch_upper;
+				if (dir[i] == -1) {
+					ghost_lower = starts[i] - num_ghost_cells * spacings[i];
+					ghost_upper = starts[i];
+				} else if (dir[i] == 1) {
+					ghost_lower = patch_upper;
+					ghost_upper = patch_upper + num_ghost_cells * spacings[i];
+				}
+				lower[i] = std::max(ghost_lower, nbr_starts[i]);
+				upper[i] = std::min(ghost_upper, nbr_starts[i] + ns[i] * nbr_spacings[i]);
+				double min_spacing = std::min(spacings[i], nbr_spacings[i]);
+				overlaps           = overlaps && upper[i] - lower[i] > 0.5 * min_spacing;
+			}
+			if (!overlaps) {
+				continue;
+			}
+			DiagonalNbrInfo<D> info;
+			info.id              = id;
+			info.rank            = std::get<0>(location);
+			info.local_index     = getLocalIndex(id);
+			info.nbr_id          = nbr_id;
+			info.nbr_rank        = std::get<0>(nbr_location);
+			info.nbr_local_index = getLocalIndex(nbr_id);
+			info.direction       = dir;
+			double ratio         = nbr_spacings[0] / spacings[0];
+			if (std::abs(ratio - 1) < 1e-6) {
+				info.nbr_type = NbrType::Normal;
+			} else if (std::abs(ratio - 2) < 1e-6) {
+				info.nbr_type = NbrType::Coarse;
+			} else if (std::abs(ratio - 0.5) < 1e-6) {
+				info.nbr_type = NbrType::Fine;
+			} else {
+				throw RuntimeError("Edge and corner neighbors have to be within one refinement "
+				                   "level");
+			}
+			for (int i = 0; i < D; i++) {
+				info.start[i] = toInt((lower[i] - starts[i]) / spacings[i]);
+				info.end[i]   = toInt((upper[i] - starts[i]) / spacings[i]) - 1;
+				if (info.nbr_type == NbrType::Fine) {
+					info.offset[i] = toInt((starts[i] - nbr_starts[i]) / nbr_spacings[i]);
+				} else {
+					info.offset[i] = toInt((starts[i] - nbr_starts[i]) / spacings[i]);
+				}
+			}
+			infos.push_back(info);
+		}
+	};
+
+	// only the patches that are at most D faces away can overlap the edge and corner ghost cells
+	for (auto pinfo : pinfo_vector) {
+		const Location &location = known.at(pinfo->id);
+		for (int nbr_id : withinHops({pinfo->id}, D)) {
+			auto iter = known.find(nbr_id);
+			if (nbr_id == pinfo->id || iter == known.end()) {
+				continue;
+			}
+			addOverlaps(pinfo->id, location, nbr_id, iter->second);
+			if (std::get<0>(iter->second) != my_rank) {
+				addOverlaps(nbr_id, iter->second, pinfo->id, location);
+			}
+		}
+	}
+	std::sort(infos.begin(), infos.end(),
+	          [](const DiagonalNbrInfo<D> &a, const DiagonalNbrInfo<D> &b) {
+		          return std::tie(a.id, a.direction, a.nbr_id)
+		                 < std::tie(b.id, b.direction, b.nbr_id);
+	          });
+	return infos;
+}
 template <int D> void to_json(nlohmann::json &j, const Domain<D> &domain)
 {
 	for (auto pinfo : domain.getPatchInfoVector()) {
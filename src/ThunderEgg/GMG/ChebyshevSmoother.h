@@ -0,0 +1,241 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_GMG_CHEBYSHEVSMOOTHER_H
+#define THUNDEREGG_GMG_CHEBYSHEVSMOOTHER_H
+#include <ThunderEgg/GMG/Smoother.h>
+#include <ThunderEgg/PatchLoop.h>
+#include <ThunderEgg/PatchOperator.h>
+#include <ThunderEgg/RuntimeError.h>
+#include <ThunderEgg/ValVector.h>
+#include <memory>
+#include <random>
+namespace ThunderEgg
+{
+namespace GMG
+{
+/**
+ * @brief Chebyshev polynomial smoother on the diagonally scaled operator
+ *
+ * Each call to smooth applies a Chebyshev polynomial of the given degree in D^-1 A, where D is the
+ * diagonal of the operator. The polynomial targets the eigenvalues in
+ * [lower_factor * lambda, upper_factor * lambda], where lambda is an estimate of the largest
+ * eigenvalue of D^-1 A computed with power iterations when the smoother is constructed.
+ *
+ * A sweep only needs residual evaluations and pointwise vector updates, so there are no global
+ * reductions after setup. The PatchOperator has to provide getDiagonalSinglePatch.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
+ */
+template <int D, typename T = double> class ChebyshevSmoother : public Smoother<D, T>
+{
+	private:
+	/**
+	 * @brief the operator that is being smoothed
+	 */
+	std::shared_ptr<const PatchOperator<D, T>> op;
+	/**
+	 * @brief the degree of the polynomial
+	 */
+	int degree;
+	/**
+	 * @brief the lower end of the targeted eigenvalues, relative to the largest eigenvalue
+	 */
+	double lower_factor = 0.1;
+	/**
+	 * @brief the upper end of the targeted eigenvalues, relative to the largest eigenvalue
+	 */
+	double upper_factor = 1.1;
+	/**
+	 * @brief the estimate of the largest eigenvalue of D^-1 A
+	 */
+	double max_eigenvalue = 0;
+	/**
+	 * @brief the inverse of the diagonal of the operator
+	 */
+	std::shared_ptr<ValVector<D, T>> inv_diagonal;
+	/**
+	 * @brief storage for the scaled residual
+	 */
+	std::shared_ptr<ValVector<D, T>> resid;
+	/**
+	 * @brief storage for the update to the solution
+	 */
+	std::shared_ptr<ValVector<D, T>> update;
+	/**
+	 * @brief Multiply a vector by the inverse of the diagonal
+	 *
+	 * @param v the vector
+	 */
+	void scaleByInverseDiagonal(std::shared_ptr<Vector<D, T>> v) const
+	{
+		auto scale_patch = [&](int i) {
+			LocalData<D, T>       v_ld     = v->getLocalData(0, i);
+			const LocalData<D, T> d_ld     = inv_diagonal->getLocalData(0, i);
+			int                   n        = v_ld.getLengths()[0];
+			int                   v_stride = v_ld.getStrides()[0];
+			int                   d_stride = d_ld.getStrides()[0];
+			v_ld.forEachLine([&](const std::array<int, D> &coord, T *v_line) {
+				const T *d_line = d_ld.getPtr(coord);
+				for (int j = 0; j < n; j++) {
+					v_line[j * v_stride] *= d_line[j * d_stride];
+				}
+			});
+		};
+		ParallelPatchLoop(v->getNumLocalPatches(), v->hasThreadSafeLocalData(), scale_patch,
+		                  PatchSchedule::Static);
+	}
+	/**
+	 * @brief Estimate the largest eigenvalue of D^-1 A with power iterations
+	 *
+	 * The iterations start from a pseudo-random vector that is seeded with the patch ids, so the
+	 * estimate does not depend on the number of ranks.
+	 *
+	 * @param iterations the number of power iterations
+	 * @return double the estimate
+	 */
+	double estimateMaxEigenvalue(int iterations) const
+	{
+		auto domain = op->getDomain();
+		auto x      = ValVector<D, T>::GetNewVector(domain, 1);
+		auto y      = ValVector<D, T>::GetNewVector(domain, 1);
+		for (auto pinfo : domain->getPatchInfoVector()) {
+			std::minstd_rand                       gen(pinfo->id + 1);
+			std::uniform_real_distribution<double> dist(0, 1);
+			LocalData<D, T>                        x_ld = x->getLocalData(0, pinfo->local_index);
+			nested_loop<D>(x_ld.getStart(), x_ld.getEnd(),
+			               [&](const std::array<int, D> &coord) { x_ld[coord] = dist(gen); });
+		}
+		x->scale(1 / x->twoNorm());
+
+		double estimate = 0;
+		for (int i = 0; i < iterations; i++) {
+			op->apply(x, y);
+			scaleByInverseDiagonal(y);
+			estimate = y->twoNorm();
+			if (estimate == 0) {
+				break;
+			}
+			x->copy(y);
+			x->scale(1 / estimate);
+		}
+		return estimate;
+	}
+
+	public:
+	/**
+	 * @brief Construct a new ChebyshevSmoother object
+	 *
+	 * This estimates the largest eigenvalue of the diagonally scaled operator.
+	 *
+	 * @param op_in the operator to smooth, has to provide getDiagonalSinglePatch
+	 * @param degree_in the degree of the polynomial
+	 * @param power_iterations the number of power iterations for the eigenvalue estimate
+	 * @exception RuntimeError if the degree is less than 1 or the diagonal has a zero
+	 */
+	explicit ChebyshevSmoother(std::shared_ptr<const PatchOperator<D, T>> op_in,
+	                           int degree_in = 2, int power_iterations = 10)
+	: op(op_in), degree(degree_in)
+	{
+		if (degree < 1) {
+			throw RuntimeError("ChebyshevSmoother degree has to be at least 1");
+		}
+		auto domain  = op->getDomain();
+		inv_diagonal = ValVector<D, T>::GetNewVector(domain, 1);
+		resid        = ValVector<D, T>::GetNewVector(domain, 1);
+		update       = ValVector<D, T>::GetNewVector(domain, 1);
+		for (auto pinfo : domain->getPatchInfoVector()) {
+			auto ds = inv_diagonal->getLocalDatas(pinfo->local_index);
+			op->getDiagonalSinglePatch(pinfo, ds);
+			nested_loop<D>(ds[0].getStart(), ds[0].getEnd(), [&](const std::array<int, D> &coord) {
+				if (ds[0][coord] == 0) {
+					throw RuntimeError("ChebyshevSmoother operator has a zero on the diagonal");
+				}
+				ds[0][coord] = 1 / ds[0][coord];
+			});
+		}
+		max_eigenvalue = estimateMaxEigenvalue(power_iterations);
+	}
+	/**
+	 * @brief Get the degree of the polynomial
+	 *
+	 * @return int the degree
+	 */
+	int getDegree() const
+	{
+		return degree;
+	}
+	/**
+	 * @brief Get the estimate of the largest eigenvalue of the diagonally scaled operator
+	 *
+	 * @return double the estimate
+	 */
+	double getMaxEigenvalueEstimate() const
+	{
+		return max_eigenvalue;
+	}
+	/**
+	 * @brief Apply the Chebyshev polynomial
+	 *
+	 * @param f the rhs vector
+	 * @param u the lhs vector, updated upon return
+	 */
+	void smooth(std::shared_ptr<const Vector<D, T>> f,
+	            std::shared_ptr<Vector<D, T>>       u) const override
+	{
+		auto domain = op->getDomain();
+		if (domain->hasTimer()) {
+			domain->getTimer()->startDomainTiming(domain->getId(), "Total Chebyshev Smooth");
+		}
+		double lower = lower_factor * max_eigenvalue;
+		double upper = upper_factor * max_eigenvalue;
+		double theta = (upper + lower) / 2;
+		double delta = (upper - lower) / 2;
+		double sigma = theta / delta;
+		double rho   = 1 / sigma;
+
+		op->residual(f, u, resid);
+		scaleByInverseDiagonal(resid);
+		update->copy(resid);
+		update->scale(1 / theta);
+		for (int k = 1; k < degree; k++) {
+			u->add(update);
+			op->residual(f, u, resid);
+			scaleByInverseDiagonal(resid);
+			double rho_new = 1 / (2 * sigma - rho);
+			update->scaleThenAddScaled(rho_new * rho, 2 * rho_new / delta, resid);
+			rho = rho_new;
+		}
+		u->add(update);
+		if (domain->hasTimer()) {
+			domain->getTimer()->stopDomainTiming(domain->getId(), "Total Chebyshev Smooth");
+		}
+	}
+};
+} // namespace GMG
+} // namespace ThunderEgg
+// explicit instantiation
+extern template class ThunderEgg::GMG::ChebyshevSmoother<2>;
+extern template class ThunderEgg::GMG::ChebyshevSmoother<3>;
+extern template class ThunderEgg::GMG::ChebyshevSmoother<2, float>;
+extern template class ThunderEgg::GMG::ChebyshevSmoother<3, float>;
+#endif
@@ -34,32 +34,36 @@ namespace GMG
  * @brief Base class for cycles. Includes functions for preparing vectors for finer and coarser
  * levels, and a function to run an iteration of smoothing on a level. Derived cycle classes
  * need to implement the visit function.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Cycle : public Operator<D>
+template <int D, typename T = double> class Cycle : public Operator<D, T>
 {
 	private:
 	/**
 	 * @brief pointer to the finest level
 	 */
-	std::shared_ptr<Level<D>> finest_level;
+	std::shared_ptr<Level<D, T>> finest_level;
 
 	protected:
-	using VecList      = std::list<std::shared_ptr<Vector<D>>>;
-	using ConstVecList = std::list<std::shared_ptr<const Vector<D>>>;
+	using VecList      = std::list<std::shared_ptr<Vector<D, T>>>;
+	using ConstVecList = std::list<std::shared_ptr<const Vector<D, T>>>;
 	/**
 	 * @brief Prepare vectors for coarser level.
 	 *
 	 * @param level the current level
 	 */
-	void prepCoarser(const Level<D> &level, VecList &u_vectors, ConstVecList &f_vectors) const
+	void prepCoarser(const Level<D, T> &level, VecList &u_vectors, ConstVecList &f_vectors) const
 	{
 		// calculate residual
-		std::shared_ptr<Vector<D>> r = level.getVectorGenerator()->getNewVector();
-		level.getOperator()->apply(u_vectors.front(), r);
-		r->scaleThenAdd(-1, f_vectors.front());
+		std::shared_ptr<Vector<D, T>> r = level.getVectorGenerator()->getNewVector();
+		level.getOperator()->residual(f_vectors.front(), u_vectors.front(), r);
 		// create vectors for coarser levels
-		std::shared_ptr<Vector<D>> new_u = level.getCoarser()->getVectorGenerator()->getNewVector();
-		std::shared_ptr<Vector<D>> new_f = level.getCoarser()->getVectorGenerator()->getNewVector();
+		std::shared_ptr<Vector<D, T>> new_u
+		= level.getCoarser()->getVectorGenerator()->getNewVector();
+		std::shared_ptr<Vector<D, T>> new_f
+		= level.getCoarser()->getVectorGenerator()->getNewVector();
 		level.getRestrictor()->restrict(r, new_f);
 		u_vectors.push_front(new_u);
 		f_vectors.push_front(new_f);
@@ -69,9 +73,9 @@ template <int D> class Cycle : public Operator<D>
 	 *
 	 * @param level the current level
 	 */
-	void prepFiner(const Level<D> &level, VecList &u_vectors, ConstVecList &f_vectors) const
+	void prepFiner(const Level<D, T> &level, VecList &u_vectors, ConstVecList &f_vectors) const
 	{
-		std::shared_ptr<Vector<D>> old_u = u_vectors.front();
+		std::shared_ptr<Vector<D, T>> old_u = u_vectors.front();
 		u_vectors.pop_front();
 		f_vectors.pop_front();
 		level.getInterpolator()->interpolate(old_u, u_vectors.front());
@@ -82,7 +86,7 @@ template <int D> class Cycle : public Operator<D>
 	 *
 	 * @param level the current level
 	 */
-	void smooth(const Level<D> &level, VecList &u_vectors, ConstVecList &f_vectors) const
+	void smooth(const Level<D, T> &level, VecList &u_vectors, ConstVecList &f_vectors) const
 	{
 		level.getSmoother()->smooth(f_vectors.front(), u_vectors.front());
 	}
@@ -92,7 +96,7 @@ template <int D> class Cycle : public Operator<D>
 	 *
 	 * @param level the level currently begin visited.
 	 */
-	virtual void visit(const Level<D> &level, VecList &u_vectors,
+	virtual void visit(const Level<D, T> &level, VecList &u_vectors,
 	                   ConstVecList &f_vectors) const = 0;
 
 	public:
@@ -101,7 +105,7 @@ template <int D> class Cycle : public Operator<D>
 	 *
 	 * @param finest_level pointer to the finest level object.
 	 */
-	Cycle(std::shared_ptr<Level<D>> finest_level)
+	Cycle(std::shared_ptr<Level<D, T>> finest_level)
 	{
 		this->finest_level = finest_level;
 	}
@@ -111,7 +115,7 @@ template <int D> class Cycle : public Operator<D>
 	 * @param f the RHS vector.
 	 * @param u the current solution vector. Output will be updated solution vector.
 	 */
-	void apply(std::shared_ptr<const Vector<D>> f, std::shared_ptr<Vector<D>> u) const
+	void apply(std::shared_ptr<const Vector<D, T>> f, std::shared_ptr<Vector<D, T>> u) const
 	{
 		u->set(0);
 		VecList      u_vectors;
@@ -125,9 +129,9 @@ template <int D> class Cycle : public Operator<D>
 	/**
 	 * @brief Get the finest Level object
 	 *
-	 * @return std::shared_ptr<const Level<D>> the Level
+	 * @return std::shared_ptr<const Level<D, T>> the Level
 	 */
-	std::shared_ptr<const Level<D>> getFinestLevel() const
+	std::shared_ptr<const Level<D, T>> getFinestLevel() const
 	{
 		return finest_level;
 	}
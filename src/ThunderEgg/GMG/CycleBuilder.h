@@ -21,10 +21,14 @@
 
 #ifndef THUNDEREGG_GMG_CYCLEBUILDER_H
 #define THUNDEREGG_GMG_CYCLEBUILDER_H
+#include <ThunderEgg/GMG/ChebyshevSmoother.h>
+#include <ThunderEgg/GMG/JacobiSmoother.h>
 #include <ThunderEgg/GMG/Level.h>
+#include <ThunderEgg/GMG/RedBlackGaussSeidelSmoother.h>
 #include <ThunderEgg/GMG/VCycle.h>
 #include <ThunderEgg/GMG/WCycle.h>
 #include <ThunderEgg/RuntimeError.h>
+#include <algorithm>
 namespace ThunderEgg
 {
 namespace GMG
@@ -33,14 +37,17 @@ namespace GMG
  * @brief Builder for building GMG cycles.
  *
  * User will provide Operator,Smoother,Restrictor, and Interpolator objects for each level.
+ * The Smoother for a level can instead be selected with CycleOpts::smoother_types, in which case
+ * the given Smoother can be nullptr.
  *
  * addFinestLevel has to be called first, then addIntermediateLevel (if there are any), and finally
  * addCoarsestLevel. Then getCycle can be called to get the completed Cycle. If these are called in
  * the wrong order, an exception will be thrown.
  *
  * @tparam D the number of cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class CycleBuilder
+template <int D, typename T = double> class CycleBuilder
 {
 	private:
 	/**
@@ -59,11 +66,51 @@ template <int D> class CycleBuilder
 	/**
 	 * @brief the finest level
 	 */
-	std::shared_ptr<Level<D>> finest_level;
+	std::shared_ptr<Level<D, T>> finest_level;
 	/**
 	 * @brief the last level that was added
 	 */
-	std::shared_ptr<Level<D>> prev_level;
+	std::shared_ptr<Level<D, T>> prev_level;
+	/**
+	 * @brief the number of levels that have been added
+	 */
+	int num_levels = 0;
+	/**
+	 * @brief Get the Smoother for the next level, as selected by CycleOpts::smoother_types
+	 *
+	 * @param op the Operator for the level
+	 * @param smoother the Smoother that was given for the level
+	 * @return std::shared_ptr<Smoother<D, T>> the Smoother to use
+	 */
+	std::shared_ptr<Smoother<D, T>> getSmoother(std::shared_ptr<Operator<D, T>> op,
+	                                            std::shared_ptr<Smoother<D, T>> smoother) const
+	{
+		std::string type = "given";
+		if (!opts.smoother_types.empty()) {
+			size_t index = std::min<size_t>(num_levels, opts.smoother_types.size() - 1);
+			type         = opts.smoother_types[index];
+		}
+		if (type == "given") {
+			if (smoother == nullptr) {
+				throw RuntimeError("Smoother is nullptr");
+			}
+			return smoother;
+		}
+		if (type != "jacobi" && type != "rbgs" && type != "chebyshev") {
+			throw RuntimeError("Unsupported Smoother type: " + type);
+		}
+		auto patch_op = std::dynamic_pointer_cast<const PatchOperator<D, T>>(op);
+		if (patch_op == nullptr) {
+			throw RuntimeError("Smoother type " + type + " needs a PatchOperator");
+		}
+		if (type == "jacobi") {
+			return std::make_shared<JacobiSmoother<D, T>>(patch_op, opts.jacobi_weight);
+		}
+		if (type == "rbgs") {
+			return std::make_shared<RedBlackGaussSeidelSmoother<D, T>>(patch_op, opts.rbgs_weight);
+		}
+		return std::make_shared<ChebyshevSmoother<D, T>>(patch_op, opts.chebyshev_degree);
+	}
 
 	public:
 	/**
@@ -80,9 +127,10 @@ template <int D> class CycleBuilder
 	 * @param restrictor the Restrictor that restricts from this level to the coarser level
 	 * @param vg the VectorGenerator for the level
 	 */
-	void addFinestLevel(std::shared_ptr<Operator<D>> op, std::shared_ptr<Smoother<D>> smoother,
-	                    std::shared_ptr<Restrictor<D>>      restrictor,
-	                    std::shared_ptr<VectorGenerator<D>> vg)
+	void addFinestLevel(std::shared_ptr<Operator<D, T>>        op,
+	                    std::shared_ptr<Smoother<D, T>>        smoother,
+	                    std::shared_ptr<Restrictor<D, T>>      restrictor,
+	                    std::shared_ptr<VectorGenerator<D, T>> vg)
 	{
 		if (has_finest) {
 			throw RuntimeError("addFinestLevel was already called");
@@ -90,23 +138,22 @@ template <int D> class CycleBuilder
 		if (op == nullptr) {
 			throw RuntimeError("Operator is nullptr");
 		}
-		if (smoother == nullptr) {
-			throw RuntimeError("Smoother is nullptr");
-		}
 		if (restrictor == nullptr) {
 			throw RuntimeError("Restrictor is nullptr");
 		}
 		if (vg == nullptr) {
 			throw RuntimeError("VectorGenerator is nullptr");
 		}
+		std::shared_ptr<Smoother<D, T>> level_smoother = getSmoother(op, smoother);
 		has_finest = true;
 
-		finest_level = std::make_shared<Level<D>>(nullptr, vg);
+		finest_level = std::make_shared<Level<D, T>>(nullptr, vg);
 		finest_level->setOperator(op);
-		finest_level->setSmoother(smoother);
+		finest_level->setSmoother(level_smoother);
 		finest_level->setRestrictor(restrictor);
 
 		prev_level = finest_level;
+		num_levels++;
 	}
 	/**
 	 * @brief Add the next intermediate level to the Cycle
@@ -117,11 +164,11 @@ template <int D> class CycleBuilder
 	 * @param interpolator the Interpolator that restricts from this level to the finer level
 	 * @param vg the VectorGenerator for the level
 	 */
-	void addIntermediateLevel(std::shared_ptr<Operator<D>>        op,
-	                          std::shared_ptr<Smoother<D>>        smoother,
-	                          std::shared_ptr<Restrictor<D>>      restrictor,
-	                          std::shared_ptr<Interpolator<D>>    interpolator,
-	                          std::shared_ptr<VectorGenerator<D>> vg)
+	void addIntermediateLevel(std::shared_ptr<Operator<D, T>>        op,
+	                          std::shared_ptr<Smoother<D, T>>        smoother,
+	                          std::shared_ptr<Restrictor<D, T>>      restrictor,
+	                          std::shared_ptr<Interpolator<D, T>>    interpolator,
+	                          std::shared_ptr<VectorGenerator<D, T>> vg)
 	{
 		if (!has_finest) {
 			throw RuntimeError("addFinestLevel has not been called yet");
@@ -132,9 +179,6 @@ template <int D> class CycleBuilder
 		if (op == nullptr) {
 			throw RuntimeError("Operator is nullptr");
 		}
-		if (smoother == nullptr) {
-			throw RuntimeError("Smoother is nullptr");
-		}
 		if (restrictor == nullptr) {
 			throw RuntimeError("Restrictor is nullptr");
 		}
@@ -144,10 +188,11 @@ template <int D> class CycleBuilder
 		if (vg == nullptr) {
 			throw RuntimeError("VectorGenerator is nullptr");
 		}
+		std::shared_ptr<Smoother<D, T>> level_smoother = getSmoother(op, smoother);
 
-		auto new_level = std::make_shared<Level<D>>(nullptr, vg);
+		auto new_level = std::make_shared<Level<D, T>>(nullptr, vg);
 		new_level->setOperator(op);
-		new_level->setSmoother(smoother);
+		new_level->setSmoother(level_smoother);
 		new_level->setInterpolator(interpolator);
 		new_level->setRestrictor(restrictor);
 
@@ -155,6 +200,7 @@ template <int D> class CycleBuilder
 		prev_level->setCoarser(new_level);
 
 		prev_level = new_level;
+		num_levels++;
 	}
 	/**
 	 * @brief Add the next intermediate level to the Cycle
@@ -164,9 +210,10 @@ template <int D> class CycleBuilder
 	 * @param interpolator the Interpolator that restricts from this level to the finer level
 	 * @param vg the VectorGenerator for the level
 	 */
-	void addCoarsestLevel(std::shared_ptr<Operator<D>> op, std::shared_ptr<Smoother<D>> smoother,
-	                      std::shared_ptr<Interpolator<D>>    interpolator,
-	                      std::shared_ptr<VectorGenerator<D>> vg)
+	void addCoarsestLevel(std::shared_ptr<Operator<D, T>>        op,
+	                      std::shared_ptr<Smoother<D, T>>        smoother,
+	                      std::shared_ptr<Interpolator<D, T>>    interpolator,
+	                      std::shared_ptr<VectorGenerator<D, T>> vg)
 	{
 		if (!has_finest) {
 			throw RuntimeError("addFinestLevel has not been called yet");
@@ -177,41 +224,40 @@ template <int D> class CycleBuilder
 		if (op == nullptr) {
 			throw RuntimeError("Operator is nullptr");
 		}
-		if (smoother == nullptr) {
-			throw RuntimeError("Smoother is nullptr");
-		}
 		if (interpolator == nullptr) {
 			throw RuntimeError("Interpolator is nullptr");
 		}
 		if (vg == nullptr) {
 			throw RuntimeError("VectorGenerator is nullptr");
 		}
+		std::shared_ptr<Smoother<D, T>> level_smoother = getSmoother(op, smoother);
 		has_coarsest = true;
 
-		auto new_level = std::make_shared<Level<D>>(nullptr, vg);
+		auto new_level = std::make_shared<Level<D, T>>(nullptr, vg);
 		new_level->setOperator(op);
-		new_level->setSmoother(smoother);
+		new_level->setSmoother(level_smoother);
 		new_level->setInterpolator(interpolator);
 
 		new_level->setFiner(prev_level);
 		prev_level->setCoarser(new_level);
+		num_levels++;
 	}
 	/**
 	 * @brief Get the completed Cycle object
 	 *
-	 * @return std::shared_ptr<Cycle<D>> the completed Cycle, will throw an exception if it is
+	 * @return std::shared_ptr<Cycle<D, T>> the completed Cycle, will throw an exception if it is
 	 * incomplete
 	 */
-	std::shared_ptr<Cycle<D>> getCycle() const
+	std::shared_ptr<Cycle<D, T>> getCycle() const
 	{
 		if (!has_coarsest) {
 			throw RuntimeError("addCoarsestLevel has not been called");
 		}
-		std::shared_ptr<Cycle<D>> cycle;
+		std::shared_ptr<Cycle<D, T>> cycle;
 		if (opts.cycle_type == "V") {
-			cycle.reset(new VCycle<D>(finest_level, opts));
+			cycle.reset(new VCycle<D, T>(finest_level, opts));
 		} else if (opts.cycle_type == "W") {
-			cycle.reset(new WCycle<D>(finest_level, opts));
+			cycle.reset(new WCycle<D, T>(finest_level, opts));
 		} else {
 			throw RuntimeError("Unsupported Cycle type: " + opts.cycle_type);
 		}
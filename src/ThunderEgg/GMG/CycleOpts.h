@@ -22,6 +22,7 @@
 #ifndef THUNDEREGG_GMG_CYCLEOPTS_H
 #define THUNDEREGG_GMG_CYCLEOPTS_H
 #include <string>
+#include <vector>
 namespace ThunderEgg
 {
 namespace GMG
@@ -79,6 +80,26 @@ struct CycleOpts {
 	 * @brief Cycle type
 	 */
 	std::string cycle_type = "V";
+	/**
+	 * @brief The smoother type for each level, starting with the finest level
+	 *
+	 * "given" uses the Smoother passed to the CycleBuilder, "jacobi" uses a JacobiSmoother, "rbgs"
+	 * uses a RedBlackGaussSeidelSmoother, and "chebyshev" uses a ChebyshevSmoother. Levels past the
+	 * end use the last entry, and an empty list uses the given Smoother on every level.
+	 */
+	std::vector<std::string> smoother_types;
+	/**
+	 * @brief Relaxation weight for the Jacobi smoother
+	 */
+	double jacobi_weight = 2.0 / 3.0;
+	/**
+	 * @brief Relaxation weight for the red-black Gauss-Seidel smoother
+	 */
+	double rbgs_weight = 1.0;
+	/**
+	 * @brief Polynomial degree for the Chebyshev smoother
+	 */
+	int chebyshev_degree = 2;
 };
 } // namespace GMG
 } // namespace ThunderEgg
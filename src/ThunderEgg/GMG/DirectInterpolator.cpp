@@ -21,4 +21,6 @@
 
 #include <ThunderEgg/GMG/DirectInterpolator.h>
 template class ThunderEgg::GMG::DirectInterpolator<2>;
-template class ThunderEgg::GMG::DirectInterpolator<3>;
\ No newline at end of file
+template class ThunderEgg::GMG::DirectInterpolator<3>;
+template class ThunderEgg::GMG::DirectInterpolator<2, float>;
+template class ThunderEgg::GMG::DirectInterpolator<3, float>;
\ No newline at end of file
@@ -34,8 +34,11 @@ namespace GMG
 /**
  * @brief Simple class that directly places values from coarse cell into the corresponding fine
  * cells.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class DirectInterpolator : public MPIInterpolator<D>
+template <int D, typename T = double> class DirectInterpolator : public MPIInterpolator<D, T>
 {
 	public:
 	/**
@@ -44,17 +47,19 @@ template <int D> class DirectInterpolator : public MPIInterpolator<D>
 	 * @param coarse_domain the coarser Domain
 	 * @param fine_domain the finer Domain
 	 * @param num_components the number of components in each cell
+	 * @param backend the backend used to exchange patches with other ranks
 	 */
 	DirectInterpolator(std::shared_ptr<Domain<D>> coarse_domain,
-	                   std::shared_ptr<Domain<D>> fine_domain, int num_components)
-	: MPIInterpolator<D>(
-	  std::make_shared<InterLevelComm<D>>(coarse_domain, num_components, fine_domain))
+	                   std::shared_ptr<Domain<D>> fine_domain, int num_components,
+	                   GhostExchangeBackend       backend = GhostExchangeBackend::PointToPoint)
+	: MPIInterpolator<D, T>(std::make_shared<InterLevelComm<D, T>>(coarse_domain, num_components,
+	                                                               fine_domain, backend))
 	{
 	}
 	void interpolatePatches(
 	const std::vector<std::pair<int, std::shared_ptr<const PatchInfo<D>>>> &patches,
-	std::shared_ptr<const Vector<D>>                                        coarser_vector,
-	std::shared_ptr<Vector<D>> finer_vector) const override
+	std::shared_ptr<const Vector<D, T>>                                     coarser_vector,
+	std::shared_ptr<Vector<D, T>> finer_vector) const override
 	{
 		for (auto pair : patches) {
 			auto pinfo              = pair.second;
@@ -92,6 +97,8 @@ template <int D> class DirectInterpolator : public MPIInterpolator<D>
 };
 extern template class DirectInterpolator<2>;
 extern template class DirectInterpolator<3>;
+extern template class DirectInterpolator<2, float>;
+extern template class DirectInterpolator<3, float>;
 } // namespace GMG
 } // namespace ThunderEgg
 #endif
\ No newline at end of file
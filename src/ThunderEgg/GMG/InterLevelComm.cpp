@@ -21,4 +21,6 @@
 
 #include <ThunderEgg/GMG/InterLevelComm.h>
 template class ThunderEgg::GMG::InterLevelComm<2>;
-template class ThunderEgg::GMG::InterLevelComm<3>;
\ No newline at end of file
+template class ThunderEgg::GMG::InterLevelComm<3>;
+template class ThunderEgg::GMG::InterLevelComm<2, float>;
+template class ThunderEgg::GMG::InterLevelComm<3, float>;
\ No newline at end of file
@@ -23,6 +23,8 @@
 #define THUNDEREGG_GMG_INTERLEVELCOMM_H
 
 #include <ThunderEgg/Domain.h>
+#include <ThunderEgg/GhostExchangeBackend.h>
+#include <ThunderEgg/MPIDatatype.h>
 #include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
 
@@ -44,8 +46,14 @@ namespace GMG
  * 	  ghost vector.
  * 	- getNewGhostVector() will allocate a new vector for these ghost values.
  *
+ * Patches are exchanged with point-to-point messages by default. With the NeighborCollective
+ * backend, each exchange is a single neighborhood alltoallv on a distributed graph communicator
+ * of the ranks that patches are exchanged with.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class InterLevelComm
+template <int D, typename T = double> class InterLevelComm
 {
 	private:
 	/**
@@ -95,13 +103,224 @@ template <int D> class InterLevelComm
 	bool                                          communicating = false;
 	bool                                          sending       = false;
 
-	std::shared_ptr<const Vector<D>> current_vector;
-	std::shared_ptr<const Vector<D>> current_ghost_vector;
+	std::shared_ptr<const Vector<D, T>> current_vector;
+	std::shared_ptr<const Vector<D, T>> current_ghost_vector;
+
+	/**
+	 * @brief the backend used to exchange patches with other ranks
+	 */
+	GhostExchangeBackend backend;
+	/**
+	 * @brief the number of values exchanged with each rank in rank_and_local_indexes_for_vector
+	 */
+	std::vector<int> vector_counts;
+	/**
+	 * @brief the offset of the values for each rank in rank_and_local_indexes_for_vector
+	 */
+	std::vector<int> vector_displs;
+	/**
+	 * @brief the number of values exchanged with each rank in
+	 * rank_and_local_indexes_for_ghost_vector
+	 */
+	std::vector<int> ghost_vector_counts;
+	/**
+	 * @brief the offset of the values for each rank in rank_and_local_indexes_for_ghost_vector
+	 */
+	std::vector<int> ghost_vector_displs;
+	/**
+	 * @brief buffer for the patches of the vector that are exchanged with other ranks
+	 */
+	std::vector<T> vector_buffer;
+	/**
+	 * @brief buffer for the patches of the ghost vector that are exchanged with other ranks
+	 */
+	std::vector<T> ghost_vector_buffer;
+	/**
+	 * @brief requests for the point-to-point recvs
+	 */
+	std::vector<MPI_Request> recv_requests;
+	/**
+	 * @brief requests for the point-to-point sends
+	 */
+	std::vector<MPI_Request> send_requests;
+	/**
+	 * @brief distributed graph communicator for getGhostPatches, from the ranks that own the
+	 * parent patches to the ranks that have them as ghost patches. Only created for the
+	 * NeighborCollective backend.
+	 */
+	MPI_Comm get_comm = MPI_COMM_NULL;
+	/**
+	 * @brief distributed graph communicator for sendGhostPatches, the reverse of get_comm
+	 */
+	MPI_Comm send_comm = MPI_COMM_NULL;
+	/**
+	 * @brief the request for the neighborhood alltoallv of getGhostPatches
+	 */
+	MPI_Request get_request = MPI_REQUEST_NULL;
+	/**
+	 * @brief the request for the neighborhood alltoallv of sendGhostPatches
+	 */
+	MPI_Request send_request = MPI_REQUEST_NULL;
+
+	/**
+	 * @brief Set the number of values exchanged with each rank, and where they are in the buffer
+	 *
+	 * @param rank_and_local_indexes the ranks and the local indexes of the patches
+	 * @param counts the number of values for each rank
+	 * @param displs the offset in the buffer for each rank
+	 * @return int the size of the buffer
+	 */
+	int
+	setCountsAndDispls(const std::vector<std::pair<int, std::vector<int>>> &rank_and_local_indexes,
+	                   std::vector<int> &counts, std::vector<int> &displs) const
+	{
+		counts.resize(rank_and_local_indexes.size());
+		displs.resize(rank_and_local_indexes.size());
+		int offset = 0;
+		for (size_t i = 0; i < rank_and_local_indexes.size(); i++) {
+			counts[i] = patch_size * rank_and_local_indexes[i].second.size();
+			displs[i] = offset;
+			offset += counts[i];
+		}
+		return offset;
+	}
+	/**
+	 * @brief Get the ranks from a vector of rank and local indexes pairs
+	 *
+	 * @param rank_and_local_indexes the ranks and the local indexes of the patches
+	 * @return std::vector<int> the ranks
+	 */
+	static std::vector<int>
+	GetRanks(const std::vector<std::pair<int, std::vector<int>>> &rank_and_local_indexes)
+	{
+		std::vector<int> ranks;
+		ranks.reserve(rank_and_local_indexes.size());
+		for (const auto &pair : rank_and_local_indexes) {
+			ranks.push_back(pair.first);
+		}
+		return ranks;
+	}
+	/**
+	 * @brief Create a distributed graph communicator
+	 *
+	 * @param sources the ranks that values are received from
+	 * @param destinations the ranks that values are sent to
+	 * @return MPI_Comm the communicator
+	 */
+	static MPI_Comm CreateGraphComm(const std::vector<int> &sources,
+	                                const std::vector<int> &destinations)
+	{
+		MPI_Comm comm;
+		MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, sources.size(), sources.data(),
+		                               MPI_UNWEIGHTED, destinations.size(), destinations.data(),
+		                               MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &comm);
+		return comm;
+	}
+	/**
+	 * @brief Pack the patches of a vector and start exchanging them
+	 *
+	 * @param vector the vector that patches are sent from
+	 * @param forward true if the patches of the vector are sent to the ghost vectors of other
+	 * ranks, false if the patches of the ghost vector are sent back to the ranks that own them
+	 */
+	void startExchange(const Vector<D, T> &vector, bool forward)
+	{
+		const std::vector<std::pair<int, std::vector<int>>> &send_rank_and_local_indexes
+		= forward ? rank_and_local_indexes_for_vector : rank_and_local_indexes_for_ghost_vector;
+		const std::vector<std::pair<int, std::vector<int>>> &recv_rank_and_local_indexes
+		= forward ? rank_and_local_indexes_for_ghost_vector : rank_and_local_indexes_for_vector;
+		const std::vector<int> &send_counts = forward ? vector_counts : ghost_vector_counts;
+		const std::vector<int> &send_displs = forward ? vector_displs : ghost_vector_displs;
+		const std::vector<int> &recv_counts = forward ? ghost_vector_counts : vector_counts;
+		const std::vector<int> &recv_displs = forward ? ghost_vector_displs : vector_displs;
+		std::vector<T> &        send_buffer = forward ? vector_buffer : ghost_vector_buffer;
+		std::vector<T> &        recv_buffer = forward ? ghost_vector_buffer : vector_buffer;
+
+		if (backend == GhostExchangeBackend::PointToPoint) {
+			recv_requests.resize(recv_rank_and_local_indexes.size());
+			for (size_t i = 0; i < recv_rank_and_local_indexes.size(); i++) {
+				MPI_Irecv(recv_buffer.data() + recv_displs[i], recv_counts[i],
+				          MPIDatatype<T>::get(), recv_rank_and_local_indexes[i].first, 0,
+				          MPI_COMM_WORLD, &recv_requests[i]);
+			}
+			send_requests.resize(send_rank_and_local_indexes.size());
+		}
+		for (size_t i = 0; i < send_rank_and_local_indexes.size(); i++) {
+			// fill buffer with values
+			int buffer_idx = send_displs[i];
+			for (int local_index : send_rank_and_local_indexes[i].second) {
+				auto local_datas = vector.getLocalDatas(local_index);
+				for (const auto &local_data : local_datas) {
+					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
+					               [&](const std::array<int, D> &coord) {
+						               send_buffer[buffer_idx] = local_data[coord];
+						               buffer_idx++;
+					               });
+				}
+			}
+			if (backend == GhostExchangeBackend::PointToPoint) {
+				MPI_Isend(send_buffer.data() + send_displs[i], send_counts[i],
+				          MPIDatatype<T>::get(), send_rank_and_local_indexes[i].first, 0,
+				          MPI_COMM_WORLD, &send_requests[i]);
+			}
+		}
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+#if MPI_VERSION >= 4
+			MPI_Start(forward ? &get_request : &send_request);
+#else
+			MPI_Ineighbor_alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(),
+			                        MPIDatatype<T>::get(), recv_buffer.data(), recv_counts.data(),
+			                        recv_displs.data(), MPIDatatype<T>::get(),
+			                        forward ? get_comm : send_comm,
+			                        forward ? &get_request : &send_request);
+#endif
+		}
+	}
+	/**
+	 * @brief Wait for the patches to be received, and put their values in a vector
+	 *
+	 * @tparam Op the type of the operation
+	 * @param vector the vector that patches are received into
+	 * @param forward the value that was passed to startExchange
+	 * @param op called with each value in the vector and the received value for it
+	 */
+	template <typename Op> void finishExchange(Vector<D, T> &vector, bool forward, Op op)
+	{
+		const std::vector<std::pair<int, std::vector<int>>> &recv_rank_and_local_indexes
+		= forward ? rank_and_local_indexes_for_ghost_vector : rank_and_local_indexes_for_vector;
+		const std::vector<int> &recv_displs = forward ? ghost_vector_displs : vector_displs;
+		const std::vector<T> &  recv_buffer = forward ? ghost_vector_buffer : vector_buffer;
 
-	std::vector<std::vector<double>> recv_buffers;
-	std::vector<MPI_Request>         recv_requests;
-	std::vector<std::vector<double>> send_buffers;
-	std::vector<MPI_Request>         send_requests;
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Wait(forward ? &get_request : &send_request, MPI_STATUS_IGNORE);
+		}
+		for (size_t i = 0; i < recv_rank_and_local_indexes.size(); i++) {
+			int finished_idx = i;
+			if (backend == GhostExchangeBackend::PointToPoint) {
+				MPI_Waitany(recv_requests.size(), recv_requests.data(), &finished_idx,
+				            MPI_STATUS_IGNORE);
+			}
+
+			// put the values in the buffer into the vector
+			int buffer_idx = recv_displs[finished_idx];
+			for (int local_index : recv_rank_and_local_indexes[finished_idx].second) {
+				auto local_datas = vector.getLocalDatas(local_index);
+				for (auto &local_data : local_datas) {
+					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
+					               [&](const std::array<int, D> &coord) {
+						               op(local_data[coord], recv_buffer[buffer_idx]);
+						               buffer_idx++;
+					               });
+				}
+			}
+		}
+
+		// wait for sends for finish
+		MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+
+		recv_requests.clear();
+		send_requests.clear();
+	}
 
 	public:
 	/**
@@ -110,12 +329,18 @@ template <int D> class InterLevelComm
 	 * @param coarse_domain the coarser DomainCollection.
 	 * @param num_coarser_components the number of components for eac cell of the coarser domain
 	 * @param fine_domain the finer DomainCollection.
+	 * @param backend the backend used to exchange patches with other ranks. Every rank has to use
+	 * the same backend. The SharedMemory backend is not supported.
 	 */
 	InterLevelComm(std::shared_ptr<const Domain<D>> coarser_domain, int num_coarser_components,
-	               std::shared_ptr<const Domain<D>> finer_domain)
+	               std::shared_ptr<const Domain<D>> finer_domain,
+	               GhostExchangeBackend             backend = GhostExchangeBackend::PointToPoint)
 	: ns(finer_domain->getNs()), num_ghost_cells(finer_domain->getNumGhostCells()),
-	  num_components(num_coarser_components)
+	  num_components(num_coarser_components), backend(backend)
 	{
+		if (backend == GhostExchangeBackend::SharedMemory) {
+			throw RuntimeError("InterLevelComm does not support the SharedMemory backend");
+		}
 		int my_patch_size = num_components;
 		for (size_t axis = 0; axis < D; axis++) {
 			my_patch_size *= ns[axis] + 2 * num_ghost_cells;
@@ -204,18 +429,80 @@ template <int D> class InterLevelComm
 			}
 			rank_and_local_indexes_for_ghost_vector.emplace_back(pair.first, local_indexes);
 		}
+
+		vector_buffer.resize(
+		setCountsAndDispls(rank_and_local_indexes_for_vector, vector_counts, vector_displs));
+		ghost_vector_buffer.resize(setCountsAndDispls(rank_and_local_indexes_for_ghost_vector,
+		                                              ghost_vector_counts, ghost_vector_displs));
+
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			std::vector<int> vector_ranks       = GetRanks(rank_and_local_indexes_for_vector);
+			std::vector<int> ghost_vector_ranks = GetRanks(rank_and_local_indexes_for_ghost_vector);
+
+			get_comm  = CreateGraphComm(ghost_vector_ranks, vector_ranks);
+			send_comm = CreateGraphComm(vector_ranks, ghost_vector_ranks);
+#if MPI_VERSION >= 4
+			MPI_Neighbor_alltoallv_init(vector_buffer.data(), vector_counts.data(),
+			                            vector_displs.data(), MPIDatatype<T>::get(),
+			                            ghost_vector_buffer.data(), ghost_vector_counts.data(),
+			                            ghost_vector_displs.data(), MPIDatatype<T>::get(), get_comm,
+			                            MPI_INFO_NULL, &get_request);
+			MPI_Neighbor_alltoallv_init(ghost_vector_buffer.data(), ghost_vector_counts.data(),
+			                            ghost_vector_displs.data(), MPIDatatype<T>::get(),
+			                            vector_buffer.data(), vector_counts.data(),
+			                            vector_displs.data(), MPIDatatype<T>::get(), send_comm,
+			                            MPI_INFO_NULL, &send_request);
+#endif
+		}
 	}
+	/**
+	 * @brief The requests and communicators can not be shared, so an InterLevelComm can not be
+	 * copied
+	 */
+	InterLevelComm(const InterLevelComm<D, T> &) = delete;
+	InterLevelComm<D, T> &operator=(const InterLevelComm<D, T> &) = delete;
 	/**
 	 * @brief Destroy the InterLevelComm object
 	 */
 	~InterLevelComm()
 	{
-		if (!(send_requests.empty() && recv_requests.empty())) {
+		int finalized;
+		MPI_Finalized(&finalized);
+		if (finalized) {
+			return;
+		}
+		if (communicating) {
 			// destructor is being called with unfinished communication
 			// finish communication (this will free mpi allocated stuff)
-			MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUS_IGNORE);
-			MPI_Waitall(recv_requests.size(), recv_requests.data(), MPI_STATUS_IGNORE);
+			MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE);
+			MPI_Waitall(recv_requests.size(), recv_requests.data(), MPI_STATUSES_IGNORE);
+			if (backend == GhostExchangeBackend::NeighborCollective) {
+				MPI_Wait(sending ? &send_request : &get_request, MPI_STATUS_IGNORE);
+			}
+		}
+#if MPI_VERSION >= 4
+		if (get_request != MPI_REQUEST_NULL) {
+			MPI_Request_free(&get_request);
 		}
+		if (send_request != MPI_REQUEST_NULL) {
+			MPI_Request_free(&send_request);
+		}
+#endif
+		if (get_comm != MPI_COMM_NULL) {
+			MPI_Comm_free(&get_comm);
+		}
+		if (send_comm != MPI_COMM_NULL) {
+			MPI_Comm_free(&send_comm);
+		}
+	}
+	/**
+	 * @brief Get the backend used to exchange patches with other ranks
+	 *
+	 * @return GhostExchangeBackend the backend
+	 */
+	GhostExchangeBackend getExchangeBackend() const
+	{
+		return backend;
 	}
 
 	/**
@@ -223,10 +510,10 @@ template <int D> class InterLevelComm
 	 *
 	 * @return the newly allocated vector.
 	 */
-	std::shared_ptr<Vector<D>> getNewGhostVector() const
+	std::shared_ptr<Vector<D, T>> getNewGhostVector() const
 	{
-		return std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, num_ghost_cells, num_components,
-		                                      num_ghost_patches);
+		return std::make_shared<ValVector<D, T>>(MPI_COMM_SELF, ns, num_ghost_cells,
+		                                         num_components, num_ghost_patches);
 	}
 
 	/**
@@ -271,8 +558,8 @@ template <int D> class InterLevelComm
 	 * @param vector the vector
 	 * @param ghost_vector the associated ghost vector
 	 */
-	void sendGhostPatchesStart(std::shared_ptr<Vector<D>>       vector,
-	                           std::shared_ptr<const Vector<D>> ghost_vector)
+	void sendGhostPatchesStart(std::shared_ptr<Vector<D, T>>       vector,
+	                           std::shared_ptr<const Vector<D, T>> ghost_vector)
 	{
 		if (communicating) {
 			if (sending) {
@@ -288,45 +575,7 @@ template <int D> class InterLevelComm
 		current_ghost_vector = ghost_vector;
 		current_vector       = vector;
 
-		// post receives
-		recv_buffers.reserve(rank_and_local_indexes_for_vector.size());
-		recv_requests.reserve(rank_and_local_indexes_for_vector.size());
-		for (auto rank_indexes_pair : rank_and_local_indexes_for_vector) {
-			// allocate buffer
-			recv_buffers.emplace_back(patch_size * rank_indexes_pair.second.size());
-
-			// post the receive
-			int rank = rank_indexes_pair.first;
-			recv_requests.emplace_back();
-			MPI_Irecv(recv_buffers.back().data(), recv_buffers.back().size(), MPI_DOUBLE, rank, 0,
-			          MPI_COMM_WORLD, &recv_requests.back());
-		}
-		send_buffers.reserve(rank_and_local_indexes_for_ghost_vector.size());
-		send_requests.reserve(rank_and_local_indexes_for_ghost_vector.size());
-		// post sends
-		for (auto rank_indexes_pair : rank_and_local_indexes_for_ghost_vector) {
-			// allocate buffer
-			send_buffers.emplace_back(patch_size * rank_indexes_pair.second.size());
-
-			// fill buffer with values
-			int buffer_idx = 0;
-			for (int local_index : rank_indexes_pair.second) {
-				auto local_datas = ghost_vector->getLocalDatas(local_index);
-				for (const auto &local_data : local_datas) {
-					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
-					               [&](const std::array<int, D> &coord) {
-						               send_buffers.back()[buffer_idx] = local_data[coord];
-						               buffer_idx++;
-					               });
-				}
-			}
-
-			// post the send
-			int rank = rank_indexes_pair.first;
-			send_requests.emplace_back();
-			MPI_Isend(send_buffers.back().data(), send_buffers.back().size(), MPI_DOUBLE, rank, 0,
-			          MPI_COMM_WORLD, &send_requests.back());
-		}
+		startExchange(*ghost_vector, false);
 
 		// set state
 		communicating = true;
@@ -344,8 +593,8 @@ template <int D> class InterLevelComm
 	 * @param vector the vector
 	 * @param ghost_vector the associated ghost vector
 	 */
-	void sendGhostPatchesFinish(std::shared_ptr<Vector<D>>       vector,
-	                            std::shared_ptr<const Vector<D>> ghost_vector)
+	void sendGhostPatchesFinish(std::shared_ptr<Vector<D, T>>       vector,
+	                            std::shared_ptr<const Vector<D, T>> ghost_vector)
 	{
 		if (!communicating) {
 			throw RuntimeError(
@@ -363,39 +612,7 @@ template <int D> class InterLevelComm
 			"InterLevelComm senGhostPatchesFinish is being called with a different ghost vector than when sendGhostPatchesStart was called");
 		}
 
-		// finish recvs
-		for (size_t i = 0; i < rank_and_local_indexes_for_vector.size(); i++) {
-			int finished_idx;
-			MPI_Waitany(recv_requests.size(), recv_requests.data(), &finished_idx,
-			            MPI_STATUS_IGNORE);
-
-			// get local indexes for the buffer that was received
-			std::vector<int> &local_indexes
-			= rank_and_local_indexes_for_vector.at(finished_idx).second;
-
-			// add the values in the buffer to the vector
-			std::vector<double> &buffer     = recv_buffers.at(finished_idx);
-			int                  buffer_idx = 0;
-			for (int local_index : local_indexes) {
-				auto local_datas = vector->getLocalDatas(local_index);
-				for (auto &local_data : local_datas) {
-					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
-					               [&](const std::array<int, D> &coord) {
-						               local_data[coord] += buffer[buffer_idx];
-						               buffer_idx++;
-					               });
-				}
-			}
-		}
-
-		// wait for sends for finish
-		MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUS_IGNORE);
-
-		// clear buffers
-		recv_requests.clear();
-		recv_buffers.clear();
-		send_requests.clear();
-		send_buffers.clear();
+		finishExchange(*vector, false, [](T &value, T buffer_value) { value += buffer_value; });
 
 		// set state
 		communicating        = false;
@@ -414,8 +631,8 @@ template <int D> class InterLevelComm
 	 * @param vector the vector
 	 * @param ghost_vector the associated ghost vector
 	 */
-	void getGhostPatchesStart(std::shared_ptr<const Vector<D>> vector,
-	                          std::shared_ptr<Vector<D>>       ghost_vector)
+	void getGhostPatchesStart(std::shared_ptr<const Vector<D, T>> vector,
+	                          std::shared_ptr<Vector<D, T>>       ghost_vector)
 	{
 		if (communicating) {
 			if (sending) {
@@ -431,45 +648,7 @@ template <int D> class InterLevelComm
 		current_ghost_vector = ghost_vector;
 		current_vector       = vector;
 
-		// post receives
-		recv_buffers.reserve(rank_and_local_indexes_for_ghost_vector.size());
-		recv_requests.reserve(rank_and_local_indexes_for_ghost_vector.size());
-		for (auto rank_indexes_pair : rank_and_local_indexes_for_ghost_vector) {
-			// allocate buffer
-			recv_buffers.emplace_back(patch_size * rank_indexes_pair.second.size());
-
-			// post the recieve
-			int rank = rank_indexes_pair.first;
-			recv_requests.emplace_back();
-			MPI_Irecv(recv_buffers.back().data(), recv_buffers.back().size(), MPI_DOUBLE, rank, 0,
-			          MPI_COMM_WORLD, &recv_requests.back());
-		}
-		send_buffers.reserve(rank_and_local_indexes_for_vector.size());
-		send_requests.reserve(rank_and_local_indexes_for_vector.size());
-		// post sends
-		for (auto rank_indexes_pair : rank_and_local_indexes_for_vector) {
-			// allocate buffer
-			send_buffers.emplace_back(patch_size * rank_indexes_pair.second.size());
-
-			// fill buffer with values
-			int buffer_idx = 0;
-			for (int local_index : rank_indexes_pair.second) {
-				auto local_datas = vector->getLocalDatas(local_index);
-				for (const auto &local_data : local_datas) {
-					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
-					               [&](const std::array<int, D> &coord) {
-						               send_buffers.back()[buffer_idx] = local_data[coord];
-						               buffer_idx++;
-					               });
-				}
-			}
-
-			// post the send
-			int rank = rank_indexes_pair.first;
-			send_requests.emplace_back();
-			MPI_Isend(send_buffers.back().data(), send_buffers.back().size(), MPI_DOUBLE, rank, 0,
-			          MPI_COMM_WORLD, &send_requests.back());
-		}
+		startExchange(*vector, true);
 
 		// set state
 		communicating = true;
@@ -487,8 +666,8 @@ template <int D> class InterLevelComm
 	 * @param vector the vector
 	 * @param ghost_vector the associated ghost vector
 	 */
-	void getGhostPatchesFinish(std::shared_ptr<const Vector<D>> vector,
-	                           std::shared_ptr<Vector<D>>       ghost_vector)
+	void getGhostPatchesFinish(std::shared_ptr<const Vector<D, T>> vector,
+	                           std::shared_ptr<Vector<D, T>>       ghost_vector)
 	{
 		if (!communicating) {
 			throw RuntimeError(
@@ -506,39 +685,7 @@ template <int D> class InterLevelComm
 			"InterLevelComm getGhostPatchesFinish is being called with a different ghost vector than when getGhostPatchesStart was called");
 		}
 
-		// finish recvs
-		for (size_t i = 0; i < rank_and_local_indexes_for_ghost_vector.size(); i++) {
-			int finished_idx;
-			MPI_Waitany(recv_requests.size(), recv_requests.data(), &finished_idx,
-			            MPI_STATUS_IGNORE);
-
-			// get local indexes for the buffer that was recieved
-			std::vector<int> &local_indexes
-			= rank_and_local_indexes_for_ghost_vector.at(finished_idx).second;
-
-			// add the values in the buffer to the vector
-			std::vector<double> &buffer     = recv_buffers.at(finished_idx);
-			int                  buffer_idx = 0;
-			for (int local_index : local_indexes) {
-				auto local_datas = ghost_vector->getLocalDatas(local_index);
-				for (auto &local_data : local_datas) {
-					nested_loop<D>(local_data.getGhostStart(), local_data.getGhostEnd(),
-					               [&](const std::array<int, D> &coord) {
-						               local_data[coord] = buffer[buffer_idx];
-						               buffer_idx++;
-					               });
-				}
-			}
-		}
-
-		// wait for sends for finish
-		MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUS_IGNORE);
-
-		// clear buffers
-		recv_requests.clear();
-		recv_buffers.clear();
-		send_requests.clear();
-		send_buffers.clear();
+		finishExchange(*ghost_vector, true, [](T &value, T buffer_value) { value = buffer_value; });
 
 		// set state
 		communicating        = false;
@@ -548,6 +695,8 @@ template <int D> class InterLevelComm
 };
 extern template class InterLevelComm<2>;
 extern template class InterLevelComm<3>;
+extern template class InterLevelComm<2, float>;
+extern template class InterLevelComm<3, float>;
 } // namespace GMG
 } // namespace ThunderEgg
 #endif
@@ -30,8 +30,11 @@ namespace GMG
 {
 /**
  * @brief base class for interpolation operators from finer levels to coarser levels.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Interpolator
+template <int D, typename T = double> class Interpolator
 {
 	public:
 	/**
@@ -44,8 +47,8 @@ template <int D> class Interpolator
 	 * @param coarse the input vector from the coarser level.
 	 * @param fine the output vector for the fine level.
 	 */
-	virtual void interpolate(std::shared_ptr<const Vector<D>> coarse,
-	                         std::shared_ptr<Vector<D>>       fine) const = 0;
+	virtual void interpolate(std::shared_ptr<const Vector<D, T>> coarse,
+	                         std::shared_ptr<Vector<D, T>>       fine) const = 0;
 };
 } // namespace GMG
 } // namespace ThunderEgg
@@ -34,8 +34,11 @@ namespace GMG
 {
 /**
  * @brief Represents a level in geometric multi-grid.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Level
+template <int D, typename T = double> class Level
 {
 	private:
 	/**
@@ -45,23 +48,23 @@ template <int D> class Level
 	/**
 	 * @brief the VectorGenerator for this level.
 	 */
-	std::shared_ptr<VectorGenerator<D>> vg;
+	std::shared_ptr<VectorGenerator<D, T>> vg;
 	/**
 	 * @brief The operator (matrix) for this level.
 	 */
-	std::shared_ptr<const Operator<D>> op;
+	std::shared_ptr<const Operator<D, T>> op;
 	/**
 	 * @brief The restrictor from this level to the coarser level.
 	 */
-	std::shared_ptr<const Restrictor<D>> restrictor;
+	std::shared_ptr<const Restrictor<D, T>> restrictor;
 	/**
 	 * @brief The interpolator from this level to the finer level.
 	 */
-	std::shared_ptr<const Interpolator<D>> interpolator;
+	std::shared_ptr<const Interpolator<D, T>> interpolator;
 	/**
 	 * @brief The smoother for this level.
 	 */
-	std::shared_ptr<const Smoother<D>> smoother;
+	std::shared_ptr<const Smoother<D, T>> smoother;
 	/**
 	 * @brief Pointer to coarser level
 	 */
@@ -77,7 +80,7 @@ template <int D> class Level
 	 *
 	 * @param dc pointer to the DomainCollection for this level
 	 */
-	Level(std::shared_ptr<const Domain<D>> domain, std::shared_ptr<VectorGenerator<D>> vg)
+	Level(std::shared_ptr<const Domain<D>> domain, std::shared_ptr<VectorGenerator<D, T>> vg)
 	{
 		this->domain = domain;
 		this->vg     = vg;
@@ -94,7 +97,7 @@ template <int D> class Level
 	 *
 	 * @param restrictor the restriction operator.
 	 */
-	void setRestrictor(std::shared_ptr<const Restrictor<D>> restrictor)
+	void setRestrictor(std::shared_ptr<const Restrictor<D, T>> restrictor)
 	{
 		this->restrictor = restrictor;
 	}
@@ -103,7 +106,7 @@ template <int D> class Level
 	 *
 	 * @return Pointer to the restrictor
 	 */
-	std::shared_ptr<const Restrictor<D>> getRestrictor() const
+	std::shared_ptr<const Restrictor<D, T>> getRestrictor() const
 	{
 		return restrictor;
 	}
@@ -112,7 +115,7 @@ template <int D> class Level
 	 *
 	 * @param interpolator the interpolation operator.
 	 */
-	void setInterpolator(std::shared_ptr<const Interpolator<D>> interpolator)
+	void setInterpolator(std::shared_ptr<const Interpolator<D, T>> interpolator)
 	{
 		this->interpolator = interpolator;
 	}
@@ -121,7 +124,7 @@ template <int D> class Level
 	 *
 	 * @return Pointer to the interpolator.
 	 */
-	std::shared_ptr<const Interpolator<D>> getInterpolator() const
+	std::shared_ptr<const Interpolator<D, T>> getInterpolator() const
 	{
 		return interpolator;
 	}
@@ -130,7 +133,7 @@ template <int D> class Level
 	 *
 	 * @param op the operator
 	 */
-	void setOperator(std::shared_ptr<const Operator<D>> op)
+	void setOperator(std::shared_ptr<const Operator<D, T>> op)
 	{
 		this->op = op;
 	}
@@ -139,7 +142,7 @@ template <int D> class Level
 	 *
 	 * @return Pointer to the operator.
 	 */
-	std::shared_ptr<const Operator<D>> getOperator() const
+	std::shared_ptr<const Operator<D, T>> getOperator() const
 	{
 		return op;
 	}
@@ -148,7 +151,7 @@ template <int D> class Level
 	 *
 	 * @param smoother the smoother
 	 */
-	void setSmoother(std::shared_ptr<const Smoother<D>> smoother)
+	void setSmoother(std::shared_ptr<const Smoother<D, T>> smoother)
 	{
 		this->smoother = smoother;
 	}
@@ -157,7 +160,7 @@ template <int D> class Level
 	 *
 	 * @return Pointer to the smoother operator.
 	 */
-	std::shared_ptr<const Smoother<D>> getSmoother() const
+	std::shared_ptr<const Smoother<D, T>> getSmoother() const
 	{
 		return smoother;
 	}
@@ -166,7 +169,7 @@ template <int D> class Level
 	 *
 	 * @return DomainCollection for this level.
 	 */
-	const std::shared_ptr<VectorGenerator<D>> &getVectorGenerator() const
+	const std::shared_ptr<VectorGenerator<D, T>> &getVectorGenerator() const
 	{
 		return vg;
 	}
@@ -21,4 +21,6 @@
 
 #include <ThunderEgg/GMG/LinearRestrictor.h>
 template class ThunderEgg::GMG::LinearRestrictor<2>;
-template class ThunderEgg::GMG::LinearRestrictor<3>;
\ No newline at end of file
+template class ThunderEgg::GMG::LinearRestrictor<3>;
+template class ThunderEgg::GMG::LinearRestrictor<2, float>;
+template class ThunderEgg::GMG::LinearRestrictor<3, float>;
\ No newline at end of file
@@ -29,8 +29,11 @@ namespace GMG
 {
 /**
  * @brief Restrictor that averages the corresponding fine cells into each coarse cell.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class LinearRestrictor : public MPIRestrictor<D>
+template <int D, typename T = double> class LinearRestrictor : public MPIRestrictor<D, T>
 {
 	private:
 	/**
@@ -46,7 +49,7 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 	 * @param coarse_data the coarser patch
 	 */
 	void extrapolateBoundaries(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                           const LocalData<D> &fine_data, LocalData<D> &coarse_data) const
+	                           const LocalData<D, T> &fine_data, LocalData<D, T> &coarse_data) const
 	{
 		Orthant<D>         orth = pinfo->orth_on_parent;
 		std::array<int, D> starts;
@@ -60,18 +63,30 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 				auto fine_ghost    = fine_data.getGhostSliceOnSide(s, 1);
 				auto fine_interior = fine_data.getSliceOnSide(s);
 				auto coarse_ghost  = coarse_data.getGhostSliceOnSide(s, 1);
-				nested_loop<D - 1>(fine_ghost.getStart(), fine_ghost.getEnd(),
-				                   [&](const std::array<int, D - 1> &coord) {
-					                   std::array<int, D - 1> coarse_coord;
-					                   for (size_t x = 0; x < s.getAxisIndex(); x++) {
-						                   coarse_coord[x] = (coord[x] + starts[x]) / 2;
-					                   }
-					                   for (size_t x = s.getAxisIndex() + 1; x < D; x++) {
-						                   coarse_coord[x - 1] = (coord[x - 1] + starts[x]) / 2;
-					                   }
-					                   coarse_ghost[coarse_coord]
-					                   += (3 * fine_ghost[coord] - fine_interior[coord]) / (1 << D);
-				                   });
+				std::array<int, D - 1> slice_starts;
+				for (size_t x = 0; x < s.getAxisIndex(); x++) {
+					slice_starts[x] = starts[x];
+				}
+				for (size_t x = s.getAxisIndex() + 1; x < D; x++) {
+					slice_starts[x - 1] = starts[x];
+				}
+				int n               = fine_ghost.getLengths()[0];
+				int ghost_stride    = fine_ghost.getStrides()[0];
+				int interior_stride = fine_interior.getStrides()[0];
+				int coarse_stride   = coarse_ghost.getStrides()[0];
+				fine_ghost.forEachLine([&](const std::array<int, D - 1> &coord, T *ghost) {
+					std::array<int, D - 1> coarse_coord;
+					coarse_coord[0] = 0;
+					for (size_t x = 1; x < D - 1; x++) {
+						coarse_coord[x] = (coord[x] + slice_starts[x]) / 2;
+					}
+					const T *interior = fine_interior.getPtr(coord);
+					T *      coarse   = coarse_ghost.getPtr(coarse_coord);
+					for (int i = 0; i < n; i++) {
+						coarse[(i + slice_starts[0]) / 2 * coarse_stride]
+						+= (3 * ghost[i * ghost_stride] - interior[i * interior_stride]) / (1 << D);
+					}
+				});
 			}
 		}
 	}
@@ -84,8 +99,8 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 	 * @param coarser_vector the coarser vector
 	 */
 	void restrictToCoarserParent(std::shared_ptr<const PatchInfo<D>> pinfo, int parent_index,
-	                             std::shared_ptr<const Vector<D>> finer_vector,
-	                             std::shared_ptr<Vector<D>>       coarser_vector) const
+	                             std::shared_ptr<const Vector<D, T>> finer_vector,
+	                             std::shared_ptr<Vector<D, T>>       coarser_vector) const
 	{
 		auto coarse_local_datas = coarser_vector->getLocalDatas(parent_index);
 		auto fine_datas         = finer_vector->getLocalDatas(pinfo->local_index);
@@ -98,16 +113,49 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 			            : coarse_local_datas[0].getLengths()[i];
 		}
 
-		for (size_t c = 0; c < fine_datas.size(); c++) {
-			// interpolate interior values
-			nested_loop<D>(
-			fine_datas[c].getStart(), fine_datas[c].getEnd(), [&](const std::array<int, D> &coord) {
+		bool interleaved
+		= finer_vector->hasInterleavedComponents() && coarser_vector->hasInterleavedComponents();
+		if (interleaved) {
+			// interpolate interior values, all of the components of each cell at once
+			int num_components = fine_datas.size();
+			int n              = fine_datas[0].getLengths()[0];
+			int fine_stride    = fine_datas[0].getStrides()[0];
+			int coarse_stride  = coarse_local_datas[0].getStrides()[0];
+			fine_datas[0].forEachLine([&](const std::array<int, D> &coord, const T *fine) {
 				std::array<int, D> coarse_coord;
-				for (size_t x = 0; x < D; x++) {
+				coarse_coord[0] = 0;
+				for (size_t x = 1; x < D; x++) {
 					coarse_coord[x] = (coord[x] + starts[x]) / 2;
 				}
-				coarse_local_datas[c][coarse_coord] += fine_datas[c][coord] / (1 << D);
+				T *coarse = coarse_local_datas[0].getPtr(coarse_coord);
+				for (int i = 0; i < n; i++) {
+					T *      coarse_cell = coarse + (i + starts[0]) / 2 * coarse_stride;
+					const T *fine_cell   = fine + i * fine_stride;
+					for (int c = 0; c < num_components; c++) {
+						coarse_cell[c] += fine_cell[c] / (1 << D);
+					}
+				}
 			});
+		}
+		for (size_t c = 0; c < fine_datas.size(); c++) {
+			if (!interleaved) {
+				// interpolate interior values
+				int n             = fine_datas[c].getLengths()[0];
+				int fine_stride   = fine_datas[c].getStrides()[0];
+				int coarse_stride = coarse_local_datas[c].getStrides()[0];
+				fine_datas[c].forEachLine([&](const std::array<int, D> &coord, const T *fine) {
+					std::array<int, D> coarse_coord;
+					coarse_coord[0] = 0;
+					for (size_t x = 1; x < D; x++) {
+						coarse_coord[x] = (coord[x] + starts[x]) / 2;
+					}
+					T *coarse = coarse_local_datas[c].getPtr(coarse_coord);
+					for (int i = 0; i < n; i++) {
+						coarse[(i + starts[0]) / 2 * coarse_stride]
+						+= fine[i * fine_stride] / (1 << D);
+					}
+				});
+			}
 
 			if (extrapolate_boundary_ghosts) {
 				extrapolateBoundaries(pinfo, fine_datas[c], coarse_local_datas[c]);
@@ -125,27 +173,52 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 
 	void copyToParent(std::shared_ptr<const PatchInfo<D>> pinfo, int parent_index,
 
-	                  std::shared_ptr<const Vector<D>> finer_vector,
-	                  std::shared_ptr<Vector<D>>       coarser_vector) const
+	                  std::shared_ptr<const Vector<D, T>> finer_vector,
+	                  std::shared_ptr<Vector<D, T>>       coarser_vector) const
 	{
 		auto coarse_local_datas = coarser_vector->getLocalDatas(parent_index);
 		auto fine_datas         = finer_vector->getLocalDatas(pinfo->local_index);
+		bool interleaved
+		= finer_vector->hasInterleavedComponents() && coarser_vector->hasInterleavedComponents();
+		if (interleaved) {
+			// just copy the values, each line holds all of the components of its cells
+			int n = fine_datas[0].getLengths()[0] * fine_datas.size();
+			fine_datas[0].forEachLine([&](const std::array<int, D> &coord, const T *fine) {
+				T *coarse = coarse_local_datas[0].getPtr(coord);
+				for (int i = 0; i < n; i++) {
+					coarse[i] += fine[i];
+				}
+			});
+		}
 		for (size_t c = 0; c < fine_datas.size(); c++) {
-			// just copy the values
-			nested_loop<D>(fine_datas[c].getStart(), fine_datas[c].getEnd(),
-			               [&](const std::array<int, D> &coord) {
-				               coarse_local_datas[c][coord] += fine_datas[c][coord];
-			               });
+			if (!interleaved) {
+				// just copy the values
+				int n             = fine_datas[c].getLengths()[0];
+				int fine_stride   = fine_datas[c].getStrides()[0];
+				int coarse_stride = coarse_local_datas[c].getStrides()[0];
+				fine_datas[c].forEachLine([&](const std::array<int, D> &coord, const T *fine) {
+					T *coarse = coarse_local_datas[c].getPtr(coord);
+					for (int i = 0; i < n; i++) {
+						coarse[i * coarse_stride] += fine[i * fine_stride];
+					}
+				});
+			}
 			if (extrapolate_boundary_ghosts) {
 				// copy boundary ghost values
 				for (Side<D> s : Side<D>::getValues()) {
 					if (!pinfo->hasNbr(s)) {
-						auto fine_ghost   = fine_datas[c].getGhostSliceOnSide(s, 1);
-						auto coarse_ghost = coarse_local_datas[c].getGhostSliceOnSide(s, 1);
-						nested_loop<D - 1>(fine_ghost.getStart(), fine_ghost.getEnd(),
-						                   [&](const std::array<int, D - 1> &coord) {
-							                   coarse_ghost[coord] += fine_ghost[coord];
-						                   });
+						auto fine_ghost          = fine_datas[c].getGhostSliceOnSide(s, 1);
+						auto coarse_ghost        = coarse_local_datas[c].getGhostSliceOnSide(s, 1);
+						int  ghost_n             = fine_ghost.getLengths()[0];
+						int  fine_ghost_stride   = fine_ghost.getStrides()[0];
+						int  coarse_ghost_stride = coarse_ghost.getStrides()[0];
+						fine_ghost.forEachLine(
+						[&](const std::array<int, D - 1> &coord, const T *fine) {
+							T *coarse = coarse_ghost.getPtr(coord);
+							for (int i = 0; i < ghost_n; i++) {
+								coarse[i * coarse_ghost_stride] += fine[i * fine_ghost_stride];
+							}
+						});
 					}
 				}
 			}
@@ -161,19 +234,21 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 	 * @param num_components the number of components in each cell
 	 * @param extrapolate_boundary_ghosts set to true if ghost values at the boundaries should be
 	 * extrapolated
+	 * @param backend the backend used to exchange patches with other ranks
 	 */
 	LinearRestrictor(std::shared_ptr<Domain<D>> fine_domain,
 	                 std::shared_ptr<Domain<D>> coarse_domain, int num_components,
-	                 bool extrapolate_boundary_ghosts = false)
-	: MPIRestrictor<D>(
-	  std::make_shared<InterLevelComm<D>>(coarse_domain, num_components, fine_domain)),
+	                 bool                       extrapolate_boundary_ghosts = false,
+	                 GhostExchangeBackend       backend = GhostExchangeBackend::PointToPoint)
+	: MPIRestrictor<D, T>(std::make_shared<InterLevelComm<D, T>>(coarse_domain, num_components,
+	                                                             fine_domain, backend)),
 	  extrapolate_boundary_ghosts(extrapolate_boundary_ghosts)
 	{
 	}
 	void
 	restrictPatches(const std::vector<std::pair<int, std::shared_ptr<const PatchInfo<D>>>> &patches,
-	                std::shared_ptr<const Vector<D>> finer_vector,
-	                std::shared_ptr<Vector<D>>       coarser_vector) const override
+	                std::shared_ptr<const Vector<D, T>> finer_vector,
+	                std::shared_ptr<Vector<D, T>>       coarser_vector) const override
 	{
 		for (const auto &pair : patches) {
 			if (pair.second->hasCoarseParent()) {
@@ -189,4 +264,6 @@ template <int D> class LinearRestrictor : public MPIRestrictor<D>
 // explicit instantiation
 extern template class ThunderEgg::GMG::LinearRestrictor<2>;
 extern template class ThunderEgg::GMG::LinearRestrictor<3>;
+extern template class ThunderEgg::GMG::LinearRestrictor<2, float>;
+extern template class ThunderEgg::GMG::LinearRestrictor<3, float>;
 #endif
\ No newline at end of file
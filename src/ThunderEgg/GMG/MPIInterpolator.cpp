@@ -21,4 +21,6 @@
 
 #include <ThunderEgg/GMG/MPIInterpolator.h>
 template class ThunderEgg::GMG::MPIInterpolator<2>;
-template class ThunderEgg::GMG::MPIInterpolator<3>;
\ No newline at end of file
+template class ThunderEgg::GMG::MPIInterpolator<3>;
+template class ThunderEgg::GMG::MPIInterpolator<2, float>;
+template class ThunderEgg::GMG::MPIInterpolator<3, float>;
\ No newline at end of file
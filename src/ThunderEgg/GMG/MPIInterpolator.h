@@ -33,14 +33,17 @@ namespace GMG
 /**
  * @brief Interpolator that implements the necessary mpi calls, derived classes only have to
  * implement interpolatePatches method
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class MPIInterpolator : public Interpolator<D>
+template <int D, typename T = double> class MPIInterpolator : public Interpolator<D, T>
 {
 	private:
 	/**
 	 * @brief The communication package for restricting between levels.
 	 */
-	std::shared_ptr<InterLevelComm<D>> ilc;
+	std::shared_ptr<InterLevelComm<D, T>> ilc;
 
 	public:
 	/**
@@ -48,7 +51,7 @@ template <int D> class MPIInterpolator : public Interpolator<D>
 	 *
 	 * @param ilc the communcation package for the two levels.
 	 */
-	explicit MPIInterpolator(std::shared_ptr<InterLevelComm<D>> ilc) : ilc(ilc) {}
+	explicit MPIInterpolator(std::shared_ptr<InterLevelComm<D, T>> ilc) : ilc(ilc) {}
 	/**
 	 * @brief Interpolate values from coarse vector to the finer vector
 	 *
@@ -64,8 +67,8 @@ template <int D> class MPIInterpolator : public Interpolator<D>
 	 */
 	virtual void interpolatePatches(
 	const std::vector<std::pair<int, std::shared_ptr<const PatchInfo<D>>>> &patches,
-	std::shared_ptr<const Vector<D>>                                        coarser_vector,
-	std::shared_ptr<Vector<D>>                                              finer_vector) const = 0;
+	std::shared_ptr<const Vector<D, T>>                                     coarser_vector,
+	std::shared_ptr<Vector<D, T>>                                           finer_vector) const = 0;
 
 	/**
 	 * @brief interpolation function
@@ -73,9 +76,10 @@ template <int D> class MPIInterpolator : public Interpolator<D>
 	 * @param coarse the input vector that is interpolated from
 	 * @param fine the output vector that is interpolated to.
 	 */
-	void interpolate(std::shared_ptr<const Vector<D>> coarse, std::shared_ptr<Vector<D>> fine) const
+	void interpolate(std::shared_ptr<const Vector<D, T>> coarse,
+	                 std::shared_ptr<Vector<D, T>>       fine) const
 	{
-		std::shared_ptr<Vector<D>> coarse_ghost = ilc->getNewGhostVector();
+		std::shared_ptr<Vector<D, T>> coarse_ghost = ilc->getNewGhostVector();
 
 		// start scatter for ghost values
 		ilc->getGhostPatchesStart(coarse, coarse_ghost);
@@ -95,4 +99,6 @@ template <int D> class MPIInterpolator : public Interpolator<D>
 // explicit instantiation
 extern template class ThunderEgg::GMG::MPIInterpolator<2>;
 extern template class ThunderEgg::GMG::MPIInterpolator<3>;
+extern template class ThunderEgg::GMG::MPIInterpolator<2, float>;
+extern template class ThunderEgg::GMG::MPIInterpolator<3, float>;
 #endif
\ No newline at end of file
@@ -21,4 +21,6 @@
 
 #include <ThunderEgg/GMG/MPIRestrictor.h>
 template class ThunderEgg::GMG::MPIRestrictor<2>;
-template class ThunderEgg::GMG::MPIRestrictor<3>;
\ No newline at end of file
+template class ThunderEgg::GMG::MPIRestrictor<3>;
+template class ThunderEgg::GMG::MPIRestrictor<2, float>;
+template class ThunderEgg::GMG::MPIRestrictor<3, float>;
\ No newline at end of file
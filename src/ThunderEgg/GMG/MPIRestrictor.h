@@ -33,14 +33,17 @@ namespace GMG
 /**
  * @brief Restrictor that implements the necessary mpi calls, derived classes only have to
  * implement restrictorPatches method
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class MPIRestrictor : public Restrictor<D>
+template <int D, typename T = double> class MPIRestrictor : public Restrictor<D, T>
 {
 	private:
 	/**
 	 * @brief The communication package for restricting between levels.
 	 */
-	std::shared_ptr<InterLevelComm<D>> ilc;
+	std::shared_ptr<InterLevelComm<D, T>> ilc;
 
 	public:
 	/**
@@ -48,7 +51,7 @@ template <int D> class MPIRestrictor : public Restrictor<D>
 	 *
 	 * @param ilc the communcation package for the two levels.
 	 */
-	MPIRestrictor(std::shared_ptr<InterLevelComm<D>> ilc_in)
+	MPIRestrictor(std::shared_ptr<InterLevelComm<D, T>> ilc_in)
 	{
 		this->ilc = ilc_in;
 	}
@@ -58,10 +61,10 @@ template <int D> class MPIRestrictor : public Restrictor<D>
 	 * @param fine the input vector that is restricted.
 	 * @param coarse the output vector that is restricted to.
 	 */
-	void restrict(std::shared_ptr<const Vector<D>> fine,
-	              std::shared_ptr<Vector<D>>       coarse) const override
+	void restrict(std::shared_ptr<const Vector<D, T>> fine,
+	              std::shared_ptr<Vector<D, T>>       coarse) const override
 	{
-		std::shared_ptr<Vector<D>> coarse_ghost = ilc->getNewGhostVector();
+		std::shared_ptr<Vector<D, T>> coarse_ghost = ilc->getNewGhostVector();
 
 		// fill in ghost values
 		restrictPatches(ilc->getPatchesWithGhostParent(), fine, coarse_ghost);
@@ -92,12 +95,14 @@ template <int D> class MPIRestrictor : public Restrictor<D>
 	 */
 	virtual void
 	restrictPatches(const std::vector<std::pair<int, std::shared_ptr<const PatchInfo<D>>>> &patches,
-	                std::shared_ptr<const Vector<D>> finer_vector,
-	                std::shared_ptr<Vector<D>>       coarser_vector) const = 0;
+	                std::shared_ptr<const Vector<D, T>> finer_vector,
+	                std::shared_ptr<Vector<D, T>>       coarser_vector) const = 0;
 };
 } // namespace GMG
 } // namespace ThunderEgg
 // explicit instantiation
 extern template class ThunderEgg::GMG::MPIRestrictor<2>;
 extern template class ThunderEgg::GMG::MPIRestrictor<3>;
+extern template class ThunderEgg::GMG::MPIRestrictor<2, float>;
+extern template class ThunderEgg::GMG::MPIRestrictor<3, float>;
 #endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <ThunderEgg/GMG/RedBlackGaussSeidelSmoother.h>
+template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<2>;
+template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<3>;
+template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<2, float>;
+template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<3, float>;
\ No newline at end of file
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_GMG_REDBLACKGAUSSSEIDELSMOOTHER_H
+#define THUNDEREGG_GMG_REDBLACKGAUSSSEIDELSMOOTHER_H
+#include <ThunderEgg/GMG/Smoother.h>
+#include <ThunderEgg/PatchLoop.h>
+#include <ThunderEgg/PatchOperator.h>
+#include <ThunderEgg/ValVector.h>
+#include <memory>
+namespace ThunderEgg
+{
+namespace GMG
+{
+/**
+ * @brief Red-black Gauss-Seidel smoother built on the stencil of a PatchOperator
+ *
+ * Each sweep fills the ghost cells once, and then relaxes the red cells and then the black cells
+ * of each patch. The ghost values are not updated between the colors, so the red cells of
+ * neighboring patches are seen from the previous sweep. The PatchOperator has to provide
+ * getDiagonalSinglePatch and relaxSinglePatch.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
+ */
+template <int D, typename T = double> class RedBlackGaussSeidelSmoother : public Smoother<D, T>
+{
+	private:
+	/**
+	 * @brief the operator that is being smoothed
+	 */
+	std::shared_ptr<const PatchOperator<D, T>> op;
+	/**
+	 * @brief the relaxation weight
+	 */
+	double weight;
+	/**
+	 * @brief the diagonal of the operator
+	 */
+	std::shared_ptr<ValVector<D, T>> diagonal;
+	/**
+	 * @brief Relax the red and then the black cells of a single patch
+	 *
+	 * @param pinfo the patch
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	void smoothSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                       std::shared_ptr<const Vector<D, T>> f,
+	                       std::shared_ptr<Vector<D, T>>       u) const
+	{
+		auto fs = f->getLocalDatas(pinfo->local_index);
+		auto us = u->getLocalDatas(pinfo->local_index);
+		auto ds = diagonal->getLocalDatas(pinfo->local_index);
+		op->relaxSinglePatch(pinfo, fs, us, ds, 0, weight);
+		op->relaxSinglePatch(pinfo, fs, us, ds, 1, weight);
+	}
+
+	public:
+	/**
+	 * @brief Construct a new RedBlackGaussSeidelSmoother object
+	 *
+	 * @param op_in the operator to smooth, has to provide getDiagonalSinglePatch and
+	 * relaxSinglePatch
+	 * @param weight_in the relaxation weight, values larger than 1 give over-relaxation
+	 */
+	explicit RedBlackGaussSeidelSmoother(std::shared_ptr<const PatchOperator<D, T>> op_in,
+	                                     double                                     weight_in = 1.0)
+	: op(op_in), weight(weight_in)
+	{
+		auto domain = op->getDomain();
+		diagonal    = ValVector<D, T>::GetNewVector(domain, 1);
+		for (auto pinfo : domain->getPatchInfoVector()) {
+			auto ds = diagonal->getLocalDatas(pinfo->local_index);
+			op->getDiagonalSinglePatch(pinfo, ds);
+		}
+	}
+	/**
+	 * @brief Get the relaxation weight
+	 *
+	 * @return double the weight
+	 */
+	double getWeight() const
+	{
+		return weight;
+	}
+	/**
+	 * @brief Do a single red-black Gauss-Seidel sweep
+	 *
+	 * The ghost exchange is overlapped with the sweep as in ForEachPatchWithGhosts. The patches are
+	 * spread over threads if the operator and the vectors are thread safe.
+	 *
+	 * @param f the rhs vector
+	 * @param u the lhs vector, updated upon return
+	 */
+	void smooth(std::shared_ptr<const Vector<D, T>> f,
+	            std::shared_ptr<Vector<D, T>>       u) const override
+	{
+		auto domain       = op->getDomain();
+		auto ghost_filler = op->getGhostFiller();
+		if (domain->hasTimer()) {
+			domain->getTimer()->startDomainTiming(domain->getId(), "Total Gauss-Seidel Smooth");
+		}
+		bool threaded
+		= op->isThreadSafe() && f->hasThreadSafeLocalData() && u->hasThreadSafeLocalData();
+		auto smooth_patch = [&](std::shared_ptr<const PatchInfo<D>> pinfo) {
+			smoothSinglePatch(pinfo, f, u);
+		};
+		ForEachPatchWithGhosts<D, T>(domain, ghost_filler, u, threaded, smooth_patch);
+		if (domain->hasTimer()) {
+			domain->getTimer()->stopDomainTiming(domain->getId(), "Total Gauss-Seidel Smooth");
+		}
+	}
+};
+} // namespace GMG
+} // namespace ThunderEgg
+// explicit instantiation
+extern template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<2>;
+extern template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<3>;
+extern template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<2, float>;
+extern template class ThunderEgg::GMG::RedBlackGaussSeidelSmoother<3, float>;
+#endif
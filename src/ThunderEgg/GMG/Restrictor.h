@@ -30,8 +30,11 @@ namespace GMG
 {
 /**
  * @brief Base class for multi-grid restriction operators.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Restrictor
+template <int D, typename T = double> class Restrictor
 {
 	public:
 	/**
@@ -44,8 +47,8 @@ template <int D> class Restrictor
 	 * @param fine the input vector that is restricted.
 	 * @param coarse the output vector that is restricted to.
 	 */
-	virtual void restrict(std::shared_ptr<const Vector<D>> fine,
-	                      std::shared_ptr<Vector<D>>       coarse) const = 0;
+	virtual void restrict(std::shared_ptr<const Vector<D, T>> fine,
+	                      std::shared_ptr<Vector<D, T>>       coarse) const = 0;
 };
 } // namespace GMG
 } // namespace ThunderEgg
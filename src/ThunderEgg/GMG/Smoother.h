@@ -28,8 +28,11 @@ namespace GMG
 {
 /**
  * @brief Base class for multi-grid smoothing operators.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Smoother
+template <int D, typename T = double> class Smoother
 {
 	public:
 	/**
@@ -42,7 +45,8 @@ template <int D> class Smoother
 	 * @param f the RHS vector
 	 * @param u the solution vector, updated upon return.
 	 */
-	virtual void smooth(std::shared_ptr<const Vector<D>> f, std::shared_ptr<Vector<D>> u) const = 0;
+	virtual void smooth(std::shared_ptr<const Vector<D, T>> f,
+	                    std::shared_ptr<Vector<D, T>>       u) const = 0;
 };
 } // namespace GMG
 } // namespace ThunderEgg
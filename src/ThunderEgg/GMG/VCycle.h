@@ -29,8 +29,11 @@ namespace GMG
 {
 /**
  * @brief Implementation of a V-cycle
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class VCycle : public Cycle<D>
+template <int D, typename T = double> class VCycle : public Cycle<D, T>
 {
 	private:
 	int num_pre_sweeps    = 1;
@@ -43,8 +46,8 @@ template <int D> class VCycle : public Cycle<D>
 	 *
 	 * @param level the current level that is being visited.
 	 */
-	void visit(const Level<D> &level, std::list<std::shared_ptr<Vector<D>>> &u_vectors,
-	           std::list<std::shared_ptr<const Vector<D>>> &f_vectors) const
+	void visit(const Level<D, T> &level, std::list<std::shared_ptr<Vector<D, T>>> &u_vectors,
+	           std::list<std::shared_ptr<const Vector<D, T>>> &f_vectors) const
 	{
 		if (level.coarsest()) {
 			for (int i = 0; i < num_coarse_sweeps; i++) {
@@ -71,7 +74,8 @@ template <int D> class VCycle : public Cycle<D>
 	 *
 	 * @param finest_level a pointer to the finest level
 	 */
-	VCycle(std::shared_ptr<Level<D>> finest_level, const CycleOpts &opts) : Cycle<D>(finest_level)
+	VCycle(std::shared_ptr<Level<D, T>> finest_level, const CycleOpts &opts)
+	: Cycle<D, T>(finest_level)
 	{
 		num_pre_sweeps    = opts.pre_sweeps;
 		num_post_sweeps   = opts.post_sweeps;
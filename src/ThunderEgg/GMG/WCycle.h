@@ -28,8 +28,11 @@ namespace GMG
 {
 /**
  * @brief Implementation of a W-cycle
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class WCycle : public Cycle<D>
+template <int D, typename T = double> class WCycle : public Cycle<D, T>
 {
 	private:
 	int num_pre_sweeps    = 1;
@@ -44,8 +47,8 @@ template <int D> class WCycle : public Cycle<D>
 	 *
 	 * @param level the current level that is being visited.
 	 */
-	void visit(const Level<D> &level, std::list<std::shared_ptr<Vector<D>>> &u_vectors,
-	           std::list<std::shared_ptr<const Vector<D>>> &f_vectors) const
+	void visit(const Level<D, T> &level, std::list<std::shared_ptr<Vector<D, T>>> &u_vectors,
+	           std::list<std::shared_ptr<const Vector<D, T>>> &f_vectors) const
 	{
 		if (level.coarsest()) {
 			for (int i = 0; i < num_coarse_sweeps; i++) {
@@ -77,7 +80,8 @@ template <int D> class WCycle : public Cycle<D>
 	 *
 	 * @param finest_level a pointer to the finest level
 	 */
-	WCycle(std::shared_ptr<Level<D>> finest_level, const CycleOpts &opts) : Cycle<D>(finest_level)
+	WCycle(std::shared_ptr<Level<D, T>> finest_level, const CycleOpts &opts)
+	: Cycle<D, T>(finest_level)
 	{
 		num_pre_sweeps    = opts.pre_sweeps;
 		num_post_sweeps   = opts.post_sweeps;
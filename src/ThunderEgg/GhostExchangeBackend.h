@@ -0,0 +1,66 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+#ifndef THUNDEREGG_GHOSTEXCHANGEBACKEND_H
+#define THUNDEREGG_GHOSTEXCHANGEBACKEND_H
+#include <ostream>
+
+namespace ThunderEgg
+{
+/**
+ * @brief How ghost values are exchanged with other ranks
+ */
+enum class GhostExchangeBackend {
+	/**
+	 * @brief Persistent point-to-point sends and recvs, one pair for each neighboring rank.
+	 */
+	PointToPoint,
+	/**
+	 * @brief A single neighborhood alltoallv on a distributed graph communicator of the
+	 * neighboring ranks.
+	 */
+	NeighborCollective,
+	/**
+	 * @brief Ranks on the same node write ghost values directly into each others recv buffers,
+	 * which are allocated in a shared memory window. Persistent point-to-point sends and recvs are
+	 * used for ranks on other nodes.
+	 */
+	SharedMemory
+};
+/**
+ * @brief ostream operator that prints a string representation of GhostExchangeBackend enum.
+ */
+inline std::ostream &operator<<(std::ostream &os, const GhostExchangeBackend &backend)
+{
+	switch (backend) {
+		case GhostExchangeBackend::PointToPoint:
+			os << "GhostExchangeBackend::PointToPoint";
+			break;
+		case GhostExchangeBackend::NeighborCollective:
+			os << "GhostExchangeBackend::NeighborCollective";
+			break;
+		case GhostExchangeBackend::SharedMemory:
+			os << "GhostExchangeBackend::SharedMemory";
+			break;
+	}
+	return os;
+}
+} // namespace ThunderEgg
+#endif
@@ -0,0 +1,291 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+#ifndef THUNDEREGG_GHOSTFILLTABLE_H
+#define THUNDEREGG_GHOSTFILLTABLE_H
+#include <ThunderEgg/Side.h>
+#include <array>
+#include <vector>
+
+namespace ThunderEgg
+{
+/**
+ * @brief A single term of a ghost fill. The value at src_coord in the source patch, multiplied by
+ * weight, is added to the ghost cell at dst_coord in the destination patch.
+ *
+ * @tparam D the number of Cartesian dimensions
+ */
+template <int D> struct GhostFillTerm {
+	/**
+	 * @brief The coordinate of the value in the source patch
+	 */
+	std::array<int, D> src_coord;
+	/**
+	 * @brief The coordinate of the ghost cell in the destination patch
+	 */
+	std::array<int, D> dst_coord;
+	/**
+	 * @brief The weight of the value
+	 */
+	double weight;
+	/**
+	 * @brief Get the coordinate of a cell in a slice on a side of a patch
+	 *
+	 * This is the coordinate that LocalData::getSliceOnSide uses for a cell in the slice.
+	 *
+	 * @param ns the number of cells in each direction of the patch
+	 * @param side the side of the patch
+	 * @param offset the offset of the slice, with 0 being the first slice of non-ghost cell values,
+	 * and -1 being the first slice of ghost cell values
+	 * @param slice_coord the coordinate of the cell in the slice
+	 * @return std::array<int, D> the coordinate of the cell in the patch
+	 */
+	static std::array<int, D> CoordOnSide(const std::array<int, D> &ns, Side<D> side, int offset,
+	                                      const std::array<int, D - 1> &slice_coord)
+	{
+		size_t             axis = side.getAxisIndex();
+		std::array<int, D> coord;
+		for (size_t i = 0; i < axis; i++) {
+			coord[i] = slice_coord[i];
+		}
+		coord[axis] = side.isLowerOnAxis() ? offset : ns[axis] - 1 - offset;
+		for (size_t i = axis + 1; i < D; i++) {
+			coord[i] = slice_coord[i - 1];
+		}
+		return coord;
+	}
+};
+/**
+ * @brief A ghost fill that has been compiled into a flat table of (source offset, destination
+ * offset, weight) terms.
+ *
+ * The terms are grouped into blocks, each block has a single source and destination patch. The
+ * offsets are relative to the first non-ghost cell of a patch, and are computed for the strides
+ * that the table was last compiled for.
+ *
+ * Terms can be marked as the first contributor to a ghost cell. These terms assign to the ghost
+ * cell instead of adding to it, so the ghost cells don't have to be zeroed first.
+ *
+ * @tparam D the number of Cartesian dimensions
+ */
+template <int D> class GhostFillTable
+{
+	private:
+	/**
+	 * @brief A range of terms with the same source and destination patch
+	 */
+	struct Block {
+		/**
+		 * @brief the local index of the source patch
+		 */
+		int src_patch;
+		/**
+		 * @brief the local index of the destination patch
+		 */
+		int dst_patch;
+		/**
+		 * @brief the index of the first term
+		 */
+		size_t begin;
+		/**
+		 * @brief one past the index of the last term that assigns to the ghost cell
+		 */
+		size_t assign_end;
+		/**
+		 * @brief one past the index of the last term
+		 */
+		size_t end;
+	};
+	/**
+	 * @brief the blocks, in the order that they were added
+	 */
+	std::vector<Block> blocks;
+	/**
+	 * @brief the source coordinates of the terms
+	 */
+	std::vector<std::array<int, D>> src_coords;
+	/**
+	 * @brief the destination coordinates of the terms
+	 */
+	std::vector<std::array<int, D>> dst_coords;
+	/**
+	 * @brief the source offsets of the terms
+	 */
+	std::vector<int> src_offsets;
+	/**
+	 * @brief the destination offsets of the terms
+	 */
+	std::vector<int> dst_offsets;
+	/**
+	 * @brief the weights of the terms
+	 */
+	std::vector<double> weights;
+	/**
+	 * @brief the strides that the offsets were computed for
+	 */
+	std::array<int, D> strides;
+	/**
+	 * @brief true if the offsets are up to date
+	 */
+	bool compiled = false;
+
+	static int GetOffset(const std::array<int, D> &strides, const std::array<int, D> &coord)
+	{
+		int offset = 0;
+		for (int i = 0; i < D; i++) {
+			offset += strides[i] * coord[i];
+		}
+		return offset;
+	}
+
+	public:
+	/**
+	 * @brief Add a block of terms
+	 *
+	 * The terms that assign are moved to the front of the block. This doesn't change the order of
+	 * the terms for any one ghost cell, since the term that assigns has to be the first term for
+	 * its ghost cell.
+	 *
+	 * @param src_patch the local index of the source patch
+	 * @param dst_patch the local index of the destination patch
+	 * @param terms the terms, they are applied in this order
+	 * @param assign for each term, true if it is the first contributor to its ghost cell. If
+	 * empty, all the terms add to the ghost cells.
+	 */
+	void addBlock(int src_patch, int dst_patch, const std::vector<GhostFillTerm<D>> &terms,
+	              const std::vector<bool> &assign = std::vector<bool>())
+	{
+		if (terms.empty()) {
+			return;
+		}
+		Block block;
+		block.src_patch = src_patch;
+		block.dst_patch = dst_patch;
+		block.begin     = weights.size();
+		for (bool assigning : {true, false}) {
+			for (size_t i = 0; i < terms.size(); i++) {
+				bool term_assigns = !assign.empty() && assign[i];
+				if (term_assigns == assigning) {
+					src_coords.push_back(terms[i].src_coord);
+					dst_coords.push_back(terms[i].dst_coord);
+					weights.push_back(terms[i].weight);
+				}
+			}
+			if (assigning) {
+				block.assign_end = weights.size();
+			}
+		}
+		block.end = weights.size();
+		blocks.push_back(block);
+		compiled = false;
+	}
+	/**
+	 * @brief Get the number of terms in the table
+	 */
+	size_t getNumTerms() const
+	{
+		return weights.size();
+	}
+	/**
+	 * @brief Compute the offsets for the given strides, nothing is done if the table is already
+	 * compiled for the strides
+	 *
+	 * @param strides_in the strides of the patches that the table will be applied to
+	 */
+	void compile(const std::array<int, D> &strides_in)
+	{
+		if (compiled && strides == strides_in) {
+			return;
+		}
+		strides = strides_in;
+		src_offsets.resize(src_coords.size());
+		dst_offsets.resize(dst_coords.size());
+		for (size_t i = 0; i < weights.size(); i++) {
+			src_offsets[i] = GetOffset(strides, src_coords[i]);
+			dst_offsets[i] = GetOffset(strides, dst_coords[i]);
+		}
+		compiled = true;
+	}
+	/**
+	 * @brief Apply the terms
+	 *
+	 * The table has to be compiled for the strides of the patches. The weights are applied in
+	 * double precision.
+	 *
+	 * @tparam T the scalar type of the patch values
+	 * @param patch_ptrs the pointers to the first non-ghost cell of each local patch
+	 */
+	template <typename T> void apply(const std::vector<T *> &patch_ptrs) const
+	{
+		const int *   src_offset = src_offsets.data();
+		const int *   dst_offset = dst_offsets.data();
+		const double *weight     = weights.data();
+		for (const Block &block : blocks) {
+			const T *src = patch_ptrs[block.src_patch];
+			T *      dst = patch_ptrs[block.dst_patch];
+			// adding zero gives the same result as adding to a zeroed ghost cell, even for -0.0
+			for (size_t i = block.begin; i < block.assign_end; i++) {
+				dst[dst_offset[i]] = weight[i] * src[src_offset[i]] + 0.0;
+			}
+			for (size_t i = block.assign_end; i < block.end; i++) {
+				dst[dst_offset[i]] += weight[i] * src[src_offset[i]];
+			}
+		}
+	}
+	/**
+	 * @brief Apply the terms to every component of patches with interleaved components
+	 *
+	 * The components of each cell have to be next to each other, with the table compiled for the
+	 * strides of the first component. Each term is applied to the num_components consecutive
+	 * values of its cells at once.
+	 *
+	 * @tparam T the scalar type of the patch values
+	 * @param patch_ptrs the pointers to the first component of the first non-ghost cell of each
+	 * local patch
+	 * @param num_components the number of components
+	 */
+	template <typename T>
+	void apply(const std::vector<T *> &patch_ptrs, int num_components) const
+	{
+		const int *   src_offset = src_offsets.data();
+		const int *   dst_offset = dst_offsets.data();
+		const double *weight     = weights.data();
+		for (const Block &block : blocks) {
+			const T *src = patch_ptrs[block.src_patch];
+			T *      dst = patch_ptrs[block.dst_patch];
+			for (size_t i = block.begin; i < block.assign_end; i++) {
+				const T *src_values = src + src_offset[i];
+				T *      dst_values = dst + dst_offset[i];
+				for (int c = 0; c < num_components; c++) {
+					dst_values[c] = weight[i] * src_values[c] + 0.0;
+				}
+			}
+			for (size_t i = block.assign_end; i < block.end; i++) {
+				const T *src_values = src + src_offset[i];
+				T *      dst_values = dst + dst_offset[i];
+				for (int c = 0; c < num_components; c++) {
+					dst_values[c] += weight[i] * src_values[c];
+				}
+			}
+		}
+	}
+};
+} // namespace ThunderEgg
+#endif
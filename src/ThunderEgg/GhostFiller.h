@@ -21,6 +21,7 @@
 
 #ifndef THUNDEREGG_GHOSTEFILLER_H
 #define THUNDEREGG_GHOSTEFILLER_H
+#include <ThunderEgg/PatchInfo.h>
 #include <ThunderEgg/Vector.h>
 namespace ThunderEgg
 {
@@ -28,8 +29,9 @@ namespace ThunderEgg
  * @brief Fills ghost cells on patches
  *
  * @tparam D the number of Cartesian dimensions in the patches.
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class GhostFiller
+template <int D, typename T = double> class GhostFiller
 {
 	public:
 	virtual ~GhostFiller() {}
@@ -39,7 +41,54 @@ template <int D> class GhostFiller
 	 *
 	 * @param u  the vector
 	 */
-	virtual void fillGhost(std::shared_ptr<const Vector<D>> u) const = 0;
+	virtual void fillGhost(std::shared_ptr<const Vector<D, T>> u) const = 0;
+	/**
+	 * @brief Fill ghost cells on a list of vectors
+	 *
+	 * Implementations that communicate can use this to send the ghost values of all the vectors
+	 * together. The default implementation fills each vector with fillGhost.
+	 *
+	 * @param us  the vectors
+	 */
+	virtual void fillGhost(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const
+	{
+		for (const auto &u : us) {
+			fillGhost(u);
+		}
+	}
+	/**
+	 * @brief Start filling ghost cells on a vector
+	 *
+	 * When this returns, the ghost cells of patches that are not remote dependent (see
+	 * isRemoteDependent) are filled. The rest are filled by fillGhostFinish. Before fillGhostFinish
+	 * is called, the values in the vector can be read, and the non-ghost values can be changed.
+	 *
+	 * The default implementation fills all the ghost cells with fillGhost.
+	 *
+	 * @param u  the vector
+	 */
+	virtual void fillGhostStart(std::shared_ptr<const Vector<D, T>> u) const
+	{
+		fillGhost(u);
+	}
+	/**
+	 * @brief Finish filling the ghost cells on a vector, after fillGhostStart
+	 *
+	 * @param u  the vector that was passed to fillGhostStart
+	 */
+	virtual void fillGhostFinish(std::shared_ptr<const Vector<D, T>> u) const {}
+	/**
+	 * @brief Check if the ghost cells of a patch depend on values from other ranks
+	 *
+	 * The ghost cells of these patches are not filled until fillGhostFinish is called.
+	 *
+	 * @param pinfo the patch
+	 * @return true if the ghost cells depend on values from other ranks
+	 */
+	virtual bool isRemoteDependent(std::shared_ptr<const PatchInfo<D>> pinfo) const
+	{
+		return false;
+	}
 };
 } // namespace ThunderEgg
 #endif
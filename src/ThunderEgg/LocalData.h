@@ -35,14 +35,15 @@ namespace ThunderEgg
  * @brief Array for acessing data of a patch. It supports variable striding
  *
  * @tparam D number of cartesian dimensions
+ * @tparam T the scalar type of the values
  */
-template <int D> class LocalData
+template <int D, typename T = double> class LocalData
 {
 	private:
 	/**
 	 * @brief Pointer to the first non-ghost cell value
 	 */
-	double *data;
+	T *data;
 	/**
 	 * @brief the strides between each element, in each direction
 	 */
@@ -82,9 +83,9 @@ template <int D> class LocalData
 	 * @param s the side of patch for the slice
 	 * @param offset the offset, with 0 being the first slice of non-ghost cell values, and -1 being
 	 * the first slice of ghost cell values
-	 * @return LocalData<D - 1> the resulting slice
+	 * @return LocalData<D - 1, T> the resulting slice
 	 */
-	LocalData<D - 1> getSliceOnSidePriv(Side<D> s, int offset) const
+	LocalData<D - 1, T> getSliceOnSidePriv(Side<D> s, int offset) const
 	{
 		size_t                 axis = s.getAxisIndex();
 		std::array<int, D - 1> new_strides;
@@ -102,14 +103,38 @@ template <int D> class LocalData
 			new_lengths[i] = lengths[i + 1];
 		}
 		if (s.isLowerOnAxis()) {
-			double *new_data = data + offset * strides[axis];
-			return LocalData<D - 1>(new_data, new_strides, new_lengths, 0, ldm);
+			T *new_data = data + offset * strides[axis];
+			return LocalData<D - 1, T>(new_data, new_strides, new_lengths, 0, ldm);
 		} else {
-			double *new_data = data + (lengths[axis] - 1 - offset) * strides[axis];
-			return LocalData<D - 1>(new_data, new_strides, new_lengths, 0, ldm);
+			T *new_data = data + (lengths[axis] - 1 - offset) * strides[axis];
+			return LocalData<D - 1, T>(new_data, new_strides, new_lengths, 0, ldm);
 		}
 	}
 
+	/**
+	 * @brief Call a function on each line along the first axis, for the lines that start in a
+	 * range of coordinates
+	 *
+	 * @param ptr the pointer to the element at the origin (const or non-const)
+	 * @param first the coordinate of the first cell of the first line
+	 * @param last the coordinate of the last cell of the last line
+	 * @param func called with the coordinate of the first cell of each line, and a pointer to it
+	 */
+	template <typename Ptr, typename Func>
+	void forEachLineInRange(Ptr ptr, const std::array<int, D> &first,
+	                        const std::array<int, D> &last, Func func) const
+	{
+		std::array<int, D> line_starts_last = last;
+		line_starts_last[0]                 = first[0];
+		nested_loop<D>(first, line_starts_last, [&](const std::array<int, D> &coord) {
+			int idx = 0;
+			for (size_t i = 0; i < D; i++) {
+				idx += strides[i] * coord[i];
+			}
+			func(coord, ptr + idx);
+		});
+	}
+
 	template <int idx, class Type, class... Types> int getIndex(Type t, Types... args) const
 	{
 		return strides[idx] * t + getIndex<idx + 1>(args...);
@@ -130,7 +155,7 @@ template <int D> class LocalData
 	 * @param num_ghost_cells_in the number of ghost cells on each side of the patch
 	 * @param ldm_in the local data manager for the data
 	 */
-	LocalData(double *data_in, const std::array<int, D> &strides_in,
+	LocalData(T *data_in, const std::array<int, D> &strides_in,
 	          const std::array<int, D> &lengths_in, int num_ghost_cells_in,
 	          std::shared_ptr<LocalDataManager> ldm_in = nullptr)
 	: data(data_in), strides(strides_in), lengths(lengths_in), ldm(ldm_in),
@@ -153,9 +178,9 @@ template <int D> class LocalData
 	 * @brief Get the pointer the data at the specified coordinate
 	 *
 	 * @param coord the coordianate
-	 * @return double* the pointer
+	 * @return T* the pointer
 	 */
-	inline double *getPtr(const std::array<int, D> &coord)
+	inline T *getPtr(const std::array<int, D> &coord)
 	{
 		int idx = 0;
 		for (size_t i = 0; i < D; i++) {
@@ -167,9 +192,9 @@ template <int D> class LocalData
 	 * @brief Get the pointer the data at the specified coordinate
 	 *
 	 * @param coord the coordianate
-	 * @return double* the pointer
+	 * @return T* the pointer
 	 */
-	inline const double *getPtr(const std::array<int, D> &coord) const
+	inline const T *getPtr(const std::array<int, D> &coord) const
 	{
 		int idx = 0;
 		for (size_t i = 0; i < D; i++) {
@@ -181,9 +206,9 @@ template <int D> class LocalData
 	 * @brief Get a reference to the element at the specified coordinate
 	 *
 	 * @param coord the coordinate
-	 * @return double& the element
+	 * @return T& the element
 	 */
-	inline double &operator[](const std::array<int, D> &coord)
+	inline T &operator[](const std::array<int, D> &coord)
 	{
 		int idx = 0;
 		loop<0, D - 1>([&](int i) { idx += strides[i] * coord[i]; });
@@ -193,20 +218,20 @@ template <int D> class LocalData
 	 * @brief Get a reference to the element at the specified coordinate
 	 *
 	 * @param coord the coordinate
-	 * @return double& the element
+	 * @return T& the element
 	 */
-	inline const double &operator[](const std::array<int, D> &coord) const
+	inline const T &operator[](const std::array<int, D> &coord) const
 	{
 		int idx = 0;
 		loop<0, D - 1>([&](int i) { idx += strides[i] * coord[i]; });
 		return data[idx];
 	}
-	template <class... Types> inline double &operator()(Types... args)
+	template <class... Types> inline T &operator()(Types... args)
 	{
 		static_assert(sizeof...(args) == D, "incorrect number of arguments");
 		return data[getIndex<0>(args...)];
 	}
-	template <class... Types> inline const double &operator()(Types... args) const
+	template <class... Types> inline const T &operator()(Types... args) const
 	{
 		static_assert(sizeof...(args) == D, "incorrect number of arguments");
 		return data[getIndex<0>(args...)];
@@ -216,9 +241,9 @@ template <int D> class LocalData
 	 *
 	 * @param s the side
 	 * @param offset how far from the side the slice is
-	 * @return LocalData<D - 1>
+	 * @return LocalData<D - 1, T>
 	 */
-	LocalData<D - 1> getSliceOnSide(Side<D> s, int offset = 0)
+	LocalData<D - 1, T> getSliceOnSide(Side<D> s, int offset = 0)
 	{
 		return getSliceOnSidePriv(s, offset);
 	}
@@ -227,9 +252,9 @@ template <int D> class LocalData
 	 *
 	 * @param s the side
 	 * @param offset how far from the side the slice is
-	 * @return LocalData<D - 1>
+	 * @return LocalData<D - 1, T>
 	 */
-	const LocalData<D - 1> getSliceOnSide(Side<D> s, int offset = 0) const
+	const LocalData<D - 1, T> getSliceOnSide(Side<D> s, int offset = 0) const
 	{
 		return getSliceOnSidePriv(s, offset);
 	}
@@ -238,9 +263,9 @@ template <int D> class LocalData
 	 *
 	 * @param s the side
 	 * @param offset which layer of ghost cells to acess
-	 * @return LocalData<D - 1>
+	 * @return LocalData<D - 1, T>
 	 */
-	const LocalData<D - 1> getGhostSliceOnSide(Side<D> s, int offset) const
+	const LocalData<D - 1, T> getGhostSliceOnSide(Side<D> s, int offset) const
 	{
 		return getSliceOnSidePriv(s, -offset);
 	}
@@ -293,10 +318,53 @@ template <int D> class LocalData
 	{
 		return num_ghost_cells;
 	}
+	/**
+	 * @brief Call a function on each line of non-ghost cells along the first axis
+	 *
+	 * The function is called as func(coord, line), where coord is the coordinate of the first cell
+	 * in the line and line points to it. Each line has getLengths()[0] cells that are
+	 * getStrides()[0] apart, so the inner loop can be a plain pointer loop.
+	 *
+	 * @param func the function to call on each line
+	 */
+	template <typename Func> void forEachLine(Func func)
+	{
+		forEachLineInRange(data, start, end, func);
+	}
+	/**
+	 * @brief Call a function on each line of non-ghost cells along the first axis
+	 *
+	 * @param func called as func(coord, line) with a const pointer to the first cell in the line
+	 */
+	template <typename Func> void forEachLine(Func func) const
+	{
+		forEachLineInRange(static_cast<const T *>(data), start, end, func);
+	}
+	/**
+	 * @brief Call a function on each line along the first axis, including the ghost cells
+	 *
+	 * Each line has getLengths()[0] + 2 * getNumGhostCells() cells, and starts in the ghost cell at
+	 * getGhostStart()[0].
+	 *
+	 * @param func called as func(coord, line) with a pointer to the first cell in the line
+	 */
+	template <typename Func> void forEachLineWithGhosts(Func func)
+	{
+		forEachLineInRange(data, ghost_start, ghost_end, func);
+	}
+	/**
+	 * @brief Call a function on each line along the first axis, including the ghost cells
+	 *
+	 * @param func called as func(coord, line) with a const pointer to the first cell in the line
+	 */
+	template <typename Func> void forEachLineWithGhosts(Func func) const
+	{
+		forEachLineInRange(static_cast<const T *>(data), ghost_start, ghost_end, func);
+	}
 	/**
 	 * @brief Get the pointer to the first element
 	 */
-	double *getPtr() const
+	T *getPtr() const
 	{
 		return data;
 	}
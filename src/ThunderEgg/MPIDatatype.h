@@ -0,0 +1,65 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_MPIDATATYPE_H
+#define THUNDEREGG_MPIDATATYPE_H
+#include <mpi.h>
+namespace ThunderEgg
+{
+/**
+ * @brief The MPI datatype that matches a scalar type
+ *
+ * This is used to send and receive the values of vectors. Only the scalar types that vectors are
+ * instantiated with are specialized.
+ *
+ * @tparam T the scalar type
+ */
+template <typename T> struct MPIDatatype;
+/**
+ * @brief MPI datatype for double
+ */
+template <> struct MPIDatatype<double> {
+	/**
+	 * @brief Get the MPI datatype
+	 *
+	 * @return MPI_Datatype MPI_DOUBLE
+	 */
+	static MPI_Datatype get()
+	{
+		return MPI_DOUBLE;
+	}
+};
+/**
+ * @brief MPI datatype for float
+ */
+template <> struct MPIDatatype<float> {
+	/**
+	 * @brief Get the MPI datatype
+	 *
+	 * @return MPI_Datatype MPI_FLOAT
+	 */
+	static MPI_Datatype get()
+	{
+		return MPI_FLOAT;
+	}
+};
+} // namespace ThunderEgg
+#endif
@@ -24,3 +24,6 @@
 template class ThunderEgg::MPIGhostFiller<1>;
 template class ThunderEgg::MPIGhostFiller<2>;
 template class ThunderEgg::MPIGhostFiller<3>;
+template class ThunderEgg::MPIGhostFiller<1, float>;
+template class ThunderEgg::MPIGhostFiller<2, float>;
+template class ThunderEgg::MPIGhostFiller<3, float>;
@@ -23,7 +23,12 @@
 #define THUNDEREGG_MPIGHOSTFILLER_H
 
 #include <ThunderEgg/Domain.h>
+#include <ThunderEgg/GhostExchangeBackend.h>
+#include <ThunderEgg/GhostFillTable.h>
 #include <ThunderEgg/GhostFiller.h>
+#include <ThunderEgg/MPIDatatype.h>
+#include <ThunderEgg/RuntimeError.h>
+#include <map>
 #include <mpi.h>
 namespace ThunderEgg
 {
@@ -33,9 +38,13 @@ namespace ThunderEgg
  * There are two private functions that have to be overridden derived classes.
  * fillGhostCellsForNbrPatch, and fillGhostCellsForLocalPatch
  *
+ * Derived classes can also override getNbrPatchStencil and getLocalPatchStencil. If they do, the
+ * ghost fill between patches on this rank is compiled into a GhostFillTable on the first fill.
+ *
  * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class MPIGhostFiller : public GhostFiller<D>
+template <int D, typename T = double> class MPIGhostFiller : public GhostFiller<D, T>
 {
 	private:
 	/**
@@ -64,6 +73,58 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 	 * are on, and the offset in the buffer for those ghost cells
 	 */
 	std::vector<std::deque<std::tuple<int, Side<D>, size_t>>> incoming_ghosts;
+	/**
+	 * @brief vector of deques of edge and corner ghost cells that are filled from other ranks, one
+	 * deque for each rank
+	 *
+	 * the deques contain the DiagonalNbrInfo and the offset in the buffer
+	 */
+	std::vector<std::deque<std::pair<DiagonalNbrInfo<D>, size_t>>> diagonal_recvs;
+	/**
+	 * @brief vector of deques of edge and corner ghost cells on other ranks that are filled from
+	 * this rank, one deque for each rank
+	 *
+	 * the deques contain the DiagonalNbrInfo and the offset in the buffer
+	 */
+	std::vector<std::deque<std::pair<DiagonalNbrInfo<D>, size_t>>> diagonal_sends;
+	/**
+	 * @brief edge and corner ghost cells where both patches are on this rank
+	 */
+	std::deque<DiagonalNbrInfo<D>> diagonal_local_calls;
+	/**
+	 * @brief the local patch fills and the local calls, compiled into a table
+	 *
+	 * This is only built if the derived class provides stencils with getLocalPatchStencil and
+	 * getNbrPatchStencil.
+	 */
+	mutable GhostFillTable<D> local_table;
+	/**
+	 * @brief true if there has been an attempt to build local_table
+	 */
+	mutable bool local_table_built = false;
+	/**
+	 * @brief true if local_table was successfully built
+	 */
+	mutable bool local_table_usable = false;
+	/**
+	 * @brief the sides with a neighbor, as pairs of local index and side
+	 *
+	 * The ghost cells on these sides are zeroed before they are filled if local_table is not used.
+	 */
+	std::vector<std::pair<int, Side<D>>> nbr_sides;
+	/**
+	 * @brief the sides whose ghost cells are zeroed before they are filled if local_table is used
+	 *
+	 * These are the sides that don't have a first contributor for every ghost cell. The other
+	 * ghost cells are assigned to by either the first term in local_table, or the only rank that
+	 * sends values for them.
+	 */
+	mutable std::vector<std::pair<int, Side<D>>> table_zeroed_sides;
+	/**
+	 * @brief for each entry in incoming_ghosts, true if the values from the rank are assigned to
+	 * the ghost cells instead of added
+	 */
+	mutable std::vector<std::vector<bool>> incoming_ghost_assigns;
 	/**
 	 * @brief vectors ranks, the position of the ranks correlate with other vectors.
 	 */
@@ -76,23 +137,141 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 	 * @brief lengths of recv buffers for each rank
 	 */
 	std::vector<size_t> recv_buff_lengths;
+	/**
+	 * @brief true for each local patch that has ghost cells filled from other ranks
+	 */
+	std::vector<bool> remote_dependent;
+	/**
+	 * @brief true while an exchange started with fillGhostStart has not been finished
+	 */
+	mutable bool exchange_in_progress = false;
+	/**
+	 * @brief the backend used to exchange ghost values with other ranks
+	 */
+	GhostExchangeBackend backend;
+	/**
+	 * @brief distributed graph communicator of the neighboring ranks, only created for the
+	 * NeighborCollective backend
+	 */
+	MPI_Comm nbr_comm = MPI_COMM_NULL;
+	/**
+	 * @brief communicator of the ranks on this node, only created for the SharedMemory backend
+	 */
+	MPI_Comm node_comm = MPI_COMM_NULL;
+	/**
+	 * @brief for each rank, the rank in node_comm, or MPI_UNDEFINED if the rank is on a different
+	 * node
+	 */
+	std::vector<int> node_ranks;
+	/**
+	 * @brief for each rank on this node, the offset of the values from this rank in the recv
+	 * buffer of that rank, and the length of the recv buffer of that rank
+	 *
+	 * The lengths and offsets are for one component, they are multiplied by the number of
+	 * components.
+	 */
+	std::vector<std::array<int, 2>> nbr_recv_offsets;
+	/**
+	 * @brief indexes of the ranks that are exchanged with using point-to-point sends and recvs
+	 */
+	std::vector<size_t> p2p_indexes;
+	/**
+	 * @brief The buffers and requests for exchanging vectors with a given number of components
+	 */
+	struct ExchangeBuffers {
+		/**
+		 * @brief the recv buffer, the values from each rank are stored contiguously
+		 */
+		std::vector<T> recv_buffer;
+		/**
+		 * @brief the number of values recieved from each rank
+		 */
+		std::vector<int> recv_counts;
+		/**
+		 * @brief the offset of the values from each rank in the recv buffer
+		 */
+		std::vector<int> recv_displs;
+		/**
+		 * @brief the send buffer, the values for each rank are stored contiguously
+		 */
+		std::vector<T> out_buffer;
+		/**
+		 * @brief the number of values sent to each rank
+		 */
+		std::vector<int> send_counts;
+		/**
+		 * @brief the offset of the values for each rank in the send buffer
+		 */
+		std::vector<int> send_displs;
+		/**
+		 * @brief the persistent recv requests, one for each rank in p2p_indexes
+		 */
+		std::vector<MPI_Request> recv_requests;
+		/**
+		 * @brief the persistent send requests, one for each rank in p2p_indexes
+		 */
+		std::vector<MPI_Request> send_requests;
+		/**
+		 * @brief shared memory window that holds two copies of the recv buffer, only used for the
+		 * SharedMemory backend
+		 *
+		 * The copies are used on alternating exchanges, so that a rank can start writing to a
+		 * neighbors buffer while the neighbor is still reading the values from the previous
+		 * exchange.
+		 */
+		MPI_Win shared_window = MPI_WIN_NULL;
+		/**
+		 * @brief the start of this ranks segment of the shared window
+		 */
+		T *shared_recv_buffer = nullptr;
+		/**
+		 * @brief for each rank on this node, the start of that ranks segment of the shared window
+		 */
+		std::vector<T *> nbr_shared_recv_buffers;
+		/**
+		 * @brief which copy of the recv buffer in the shared window is used for the current
+		 * exchange
+		 */
+		int shared_buffer_copy = 0;
+		/**
+		 * @brief the request for the neighborhood alltoallv, only used for the NeighborCollective
+		 * backend
+		 *
+		 * This is a persistent request when the MPI library supports MPI-4.
+		 */
+		MPI_Request collective_request = MPI_REQUEST_NULL;
+	};
+	/**
+	 * @brief the buffers and requests for each number of components that has been exchanged
+	 *
+	 * They are kept until the ghost filler is destroyed, so alternating between vectors with
+	 * different numbers of components does not recreate the requests or the shared window.
+	 */
+	mutable std::map<int, ExchangeBuffers> exchange_buffers;
+	/**
+	 * @brief the buffers and requests of the current exchange
+	 */
+	mutable ExchangeBuffers *active_buffers = nullptr;
 
 	/**
 	 * @brief Get the LocalData object for the buffer
 	 *
+	 * The components of each cell are stored next to each other in the buffer.
+	 *
 	 * @param buffer_ptr pointer to the ghost cells position in the buffer
 	 * @param side  the side that the ghost cells are on
 	 * @param component_index  the component index
-	 * @return LocalData<D> the LocalData object
+	 * @param num_components the number of components in the buffer
+	 * @return LocalData<D, T> the LocalData object
 	 */
-	LocalData<D> getLocalDataForBuffer(double *buffer_ptr, const Side<D> side,
-	                                   int component_index) const
+	LocalData<D, T> getLocalDataForBuffer(T *buffer_ptr, const Side<D> side, int component_index,
+	                                      int num_components) const
 	{
 		auto ns              = domain->getNs();
 		int  num_ghost_cells = domain->getNumGhostCells();
 		// determine striding
 		std::array<int, D> strides;
-		strides[0] = 1;
+		strides[0] = num_components;
 		for (size_t i = 1; i < D; i++) {
 			if (i - 1 == side.getAxisIndex()) {
 				strides[i] = num_ghost_cells * strides[i - 1];
@@ -100,106 +279,699 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 				strides[i] = ns[i - 1] * strides[i - 1];
 			}
 		}
-		int size = D - 1 == side.getAxisIndex() ? (num_ghost_cells * strides[D - 1])
-		                                        : (ns[D - 1] * strides[D - 1]);
 		// transform buffer ptr so that it points to first non-ghost cell
-		double *transformed_buffer_ptr = buffer_ptr + size * component_index;
+		T *transformed_buffer_ptr = buffer_ptr + component_index;
 		if (side.isLowerOnAxis()) {
 			transformed_buffer_ptr -= (-num_ghost_cells) * strides[side.getAxisIndex()];
 		} else {
 			transformed_buffer_ptr -= ns[side.getAxisIndex()] * strides[side.getAxisIndex()];
 		}
 
-		LocalData<D> buffer_data(transformed_buffer_ptr, strides, ns, num_ghost_cells);
+		LocalData<D, T> buffer_data(transformed_buffer_ptr, strides, ns, num_ghost_cells);
 		return buffer_data;
 	}
 	/**
-	 * @brief Post send requests
+	 * @brief Free the persistent requests and the shared window of a set of buffers
 	 *
-	 * @param buffers the allocated buffers
-	 * @return std::vector<MPI_Request> the send requests
+	 * @param buffers the buffers
 	 */
-	std::vector<MPI_Request> postRecvs(std::vector<std::vector<double>> &buffers) const
+	static void FreeExchangeBuffers(ExchangeBuffers &buffers)
 	{
-		std::vector<MPI_Request> recv_requests(buffers.size());
-		for (size_t i = 0; i < recv_requests.size(); i++) {
-			MPI_Irecv(buffers[i].data(), buffers[i].size(), MPI_DOUBLE, index_rank_map[i], 0,
-			          MPI_COMM_WORLD, &recv_requests[i]);
+		for (MPI_Request &request : buffers.recv_requests) {
+			MPI_Request_free(&request);
+		}
+		for (MPI_Request &request : buffers.send_requests) {
+			MPI_Request_free(&request);
+		}
+		buffers.recv_requests.clear();
+		buffers.send_requests.clear();
+#if MPI_VERSION >= 4
+		if (buffers.collective_request != MPI_REQUEST_NULL) {
+			MPI_Request_free(&buffers.collective_request);
+		}
+#endif
+		if (buffers.shared_window != MPI_WIN_NULL) {
+			MPI_Win_unlock_all(buffers.shared_window);
+			MPI_Win_free(&buffers.shared_window);
+			buffers.shared_recv_buffer = nullptr;
+			buffers.nbr_shared_recv_buffers.clear();
 		}
-		return recv_requests;
 	}
 	/**
-	 * @brief process recv requests as they are ready
+	 * @brief Allocate the shared window and get the location of the recv buffers of the ranks on
+	 * this node
 	 *
-	 * @param requests the recv requests
-	 * @param buffers the recv buffers
-	 * @param u the vector to fill ghost values in
+	 * This is collective over the ranks on this node.
+	 *
+	 * @param buffers the buffers to allocate the shared window for
 	 */
-	void processRecvs(std::vector<MPI_Request> &requests, std::vector<std::vector<double>> &buffers,
-	                  std::shared_ptr<const Vector<D>> u) const
+	void setupSharedWindow(ExchangeBuffers &buffers) const
 	{
-		size_t num_requests = requests.size();
-		for (size_t i = 0; i < num_requests; i++) {
-			int finished_index;
-			MPI_Waitany(requests.size(), requests.data(), &finished_index, MPI_STATUS_IGNORE);
-			for (auto t : incoming_ghosts[finished_index]) {
-				int     local_index   = std::get<0>(t);
-				Side<D> side          = std::get<1>(t);
-				size_t  buffer_offset = std::get<2>(t);
+		MPI_Info info;
+		MPI_Info_create(&info);
+		MPI_Info_set(info, "alloc_shared_noncontig", "true");
+		MPI_Aint window_size = 2 * buffers.recv_buffer.size() * sizeof(T);
+		MPI_Win_allocate_shared(window_size, sizeof(T), info, node_comm,
+		                        &buffers.shared_recv_buffer, &buffers.shared_window);
+		MPI_Info_free(&info);
+		MPI_Win_lock_all(MPI_MODE_NOCHECK, buffers.shared_window);
 
-				for (int c = 0; c < u->getNumComponents(); c++) {
-					const LocalData<D> local_data = u->getLocalData(c, local_index);
-					double *           buffer_ptr
-					= buffers[finished_index].data() + buffer_offset * u->getNumComponents();
-					LocalData<D> buffer_data = getLocalDataForBuffer(buffer_ptr, side, c);
-					for (int ig = 0; ig < domain->getNumGhostCells(); ig++) {
-						LocalData<D - 1> local_slice = local_data.getGhostSliceOnSide(side, ig + 1);
-						LocalData<D - 1> buffer_slice
-						= buffer_data.getGhostSliceOnSide(side, ig + 1);
-						nested_loop<D - 1>(local_slice.getStart(), local_slice.getEnd(),
-						                   [&](const std::array<int, D - 1> &coord) {
-							                   local_slice[coord] += buffer_slice[coord];
-						                   });
+		buffers.nbr_shared_recv_buffers.resize(node_ranks.size());
+		for (size_t i = 0; i < node_ranks.size(); i++) {
+			if (node_ranks[i] == MPI_UNDEFINED) {
+				buffers.nbr_shared_recv_buffers[i] = nullptr;
+			} else {
+				MPI_Aint size;
+				int      disp_unit;
+				MPI_Win_shared_query(buffers.shared_window, node_ranks[i], &size, &disp_unit,
+				                     &buffers.nbr_shared_recv_buffers[i]);
+			}
+		}
+		buffers.shared_buffer_copy = 0;
+	}
+	/**
+	 * @brief Find which of the neighboring ranks are on this node, and where the values from this
+	 * rank go in their recv buffers
+	 *
+	 * @param nbr_ranks the neighboring ranks
+	 */
+	void setupNodeRanks(const std::vector<int> &nbr_ranks)
+	{
+		MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+		MPI_Group world_group;
+		MPI_Group node_group;
+		MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+		MPI_Comm_group(node_comm, &node_group);
+		node_ranks.resize(nbr_ranks.size());
+		MPI_Group_translate_ranks(world_group, nbr_ranks.size(), nbr_ranks.data(), node_group,
+		                          node_ranks.data());
+		MPI_Group_free(&world_group);
+		MPI_Group_free(&node_group);
+
+		// tell the ranks on this node where their values go in the recv buffer
+		int recv_length = 0;
+		for (size_t length : recv_buff_lengths) {
+			recv_length += length;
+		}
+		std::vector<std::array<int, 2>> recv_offsets(nbr_ranks.size());
+		nbr_recv_offsets.resize(nbr_ranks.size());
+		std::vector<MPI_Request> requests;
+		int                     offset = 0;
+		for (size_t i = 0; i < nbr_ranks.size(); i++) {
+			recv_offsets[i] = {offset, recv_length};
+			offset += recv_buff_lengths[i];
+			if (node_ranks[i] == MPI_UNDEFINED) {
+				p2p_indexes.push_back(i);
+			} else {
+				requests.emplace_back();
+				MPI_Irecv(nbr_recv_offsets[i].data(), 2, MPI_INT, node_ranks[i], 0, node_comm,
+				          &requests.back());
+				requests.emplace_back();
+				MPI_Isend(recv_offsets[i].data(), 2, MPI_INT, node_ranks[i], 0, node_comm,
+				          &requests.back());
+			}
+		}
+		MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+	}
+	/**
+	 * @brief Allocate the buffers and create the persistent requests for vectors with a given
+	 * number of components
+	 *
+	 * The communication pattern is fixed at construction, so this is only done the first time that
+	 * a number of components is exchanged.
+	 *
+	 * @param num_components the number of components
+	 * @return ExchangeBuffers& the buffers
+	 */
+	ExchangeBuffers &getExchangeBuffers(int num_components) const
+	{
+		auto iter = exchange_buffers.find(num_components);
+		if (iter != exchange_buffers.end()) {
+			return iter->second;
+		}
+		ExchangeBuffers &buffers = exchange_buffers[num_components];
+		buffers.recv_counts.resize(recv_buff_lengths.size());
+		buffers.recv_displs.resize(recv_buff_lengths.size());
+		int recv_size = 0;
+		for (size_t i = 0; i < recv_buff_lengths.size(); i++) {
+			buffers.recv_counts[i] = recv_buff_lengths[i] * num_components;
+			buffers.recv_displs[i] = recv_size;
+			recv_size += buffers.recv_counts[i];
+		}
+		buffers.recv_buffer.resize(recv_size);
+		buffers.send_counts.resize(send_buff_lengths.size());
+		buffers.send_displs.resize(send_buff_lengths.size());
+		int send_size = 0;
+		for (size_t i = 0; i < send_buff_lengths.size(); i++) {
+			buffers.send_counts[i] = send_buff_lengths[i] * num_components;
+			buffers.send_displs[i] = send_size;
+			send_size += buffers.send_counts[i];
+		}
+		buffers.out_buffer.resize(send_size);
+
+		buffers.recv_requests.resize(p2p_indexes.size());
+		buffers.send_requests.resize(p2p_indexes.size());
+		for (size_t j = 0; j < p2p_indexes.size(); j++) {
+			size_t i = p2p_indexes[j];
+			MPI_Recv_init(buffers.recv_buffer.data() + buffers.recv_displs[i],
+			              buffers.recv_counts[i], MPIDatatype<T>::get(), index_rank_map[i], 0,
+			              MPI_COMM_WORLD, &buffers.recv_requests[j]);
+			MPI_Send_init(buffers.out_buffer.data() + buffers.send_displs[i],
+			              buffers.send_counts[i], MPIDatatype<T>::get(), index_rank_map[i], 0,
+			              MPI_COMM_WORLD, &buffers.send_requests[j]);
+		}
+#if MPI_VERSION >= 4
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Neighbor_alltoallv_init(buffers.out_buffer.data(), buffers.send_counts.data(),
+			                            buffers.send_displs.data(), MPIDatatype<T>::get(),
+			                            buffers.recv_buffer.data(), buffers.recv_counts.data(),
+			                            buffers.recv_displs.data(), MPIDatatype<T>::get(), nbr_comm,
+			                            MPI_INFO_NULL, &buffers.collective_request);
+		}
+#endif
+		if (backend == GhostExchangeBackend::SharedMemory) {
+			setupSharedWindow(buffers);
+		}
+		return buffers;
+	}
+	/**
+	 * @brief Get the total number of components in a list of vectors
+	 *
+	 * @param us the vectors
+	 * @return int the total number of components
+	 */
+	static int GetNumComponents(const std::vector<std::shared_ptr<const Vector<D, T>>> &us)
+	{
+		int num_components = 0;
+		for (const auto &u : us) {
+			num_components += u->getNumComponents();
+		}
+		return num_components;
+	}
+	/**
+	 * @brief Get the LocalData objects for all of the components of a list of vectors
+	 *
+	 * @param us the vectors
+	 * @param local_index the local index of the patch
+	 * @param local_datas set to the LocalData objects, has to have the total number of components
+	 */
+	static void GetLocalDatas(const std::vector<std::shared_ptr<const Vector<D, T>>> &us,
+	                          int local_index, std::vector<LocalData<D, T>> &local_datas)
+	{
+		int buffer_c = 0;
+		for (const auto &u : us) {
+			for (int c = 0; c < u->getNumComponents(); c++) {
+				local_datas[buffer_c] = u->getLocalData(c, local_index);
+				buffer_c++;
+			}
+		}
+	}
+	/**
+	 * @brief add the ghost values recieved from a rank to the ghost cells
+	 *
+	 * The values for the vectors are stored as if the vectors were a single vector with all of
+	 * their components, with the components of each cell next to each other. The components of
+	 * each ghost cell are filled together, so when a single vector has interleaved components,
+	 * they are copied as one contiguous run.
+	 *
+	 * @param us the vectors to fill ghost values in
+	 * @param rank_index the index of the rank in index_rank_map
+	 * @param rank_buffer the start of the values recieved from the rank
+	 */
+	void addRecvBufferToGhosts(const std::vector<std::shared_ptr<const Vector<D, T>>> &us,
+	                           size_t rank_index, T *rank_buffer) const
+	{
+		int  num_components = GetNumComponents(us);
+		bool interleaved    = us.size() == 1 && us[0]->hasInterleavedComponents();
+
+		std::vector<LocalData<D, T>>     local_datas(num_components);
+		std::vector<LocalData<D - 1, T>> local_slices(num_components);
+
+		auto assign_iter = incoming_ghost_assigns[rank_index].begin();
+		for (auto t : incoming_ghosts[rank_index]) {
+			int     local_index   = std::get<0>(t);
+			Side<D> side          = std::get<1>(t);
+			size_t  buffer_offset = std::get<2>(t);
+			T *     buffer_ptr    = rank_buffer + buffer_offset * num_components;
+			bool    assign        = *assign_iter;
+			assign_iter++;
+
+			GetLocalDatas(us, local_index, local_datas);
+			LocalData<D, T> buffer_data
+			= getLocalDataForBuffer(buffer_ptr, side, 0, num_components);
+			for (int ig = 0; ig < domain->getNumGhostCells(); ig++) {
+				for (int c = 0; c < num_components; c++) {
+					local_slices[c] = local_datas[c].getGhostSliceOnSide(side, ig + 1);
+				}
+				LocalData<D - 1, T> buffer_slice = buffer_data.getGhostSliceOnSide(side, ig + 1);
+				// adding zero gives the same result as adding to a zeroed ghost cell
+				if (interleaved && assign) {
+					nested_loop<D - 1>(local_slices[0].getStart(), local_slices[0].getEnd(),
+					                   [&](const std::array<int, D - 1> &coord) {
+						                   T *      local  = local_slices[0].getPtr(coord);
+						                   const T *buffer = buffer_slice.getPtr(coord);
+						                   for (int c = 0; c < num_components; c++) {
+							                   local[c] = buffer[c] + 0.0;
+						                   }
+					                   });
+				} else if (interleaved) {
+					nested_loop<D - 1>(local_slices[0].getStart(), local_slices[0].getEnd(),
+					                   [&](const std::array<int, D - 1> &coord) {
+						                   T *      local  = local_slices[0].getPtr(coord);
+						                   const T *buffer = buffer_slice.getPtr(coord);
+						                   for (int c = 0; c < num_components; c++) {
+							                   local[c] += buffer[c];
+						                   }
+					                   });
+				} else if (assign) {
+					nested_loop<D - 1>(local_slices[0].getStart(), local_slices[0].getEnd(),
+					                   [&](const std::array<int, D - 1> &coord) {
+						                   const T *buffer = buffer_slice.getPtr(coord);
+						                   for (int c = 0; c < num_components; c++) {
+							                   local_slices[c][coord] = buffer[c] + 0.0;
+						                   }
+					                   });
+				} else {
+					nested_loop<D - 1>(local_slices[0].getStart(), local_slices[0].getEnd(),
+					                   [&](const std::array<int, D - 1> &coord) {
+						                   const T *buffer = buffer_slice.getPtr(coord);
+						                   for (int c = 0; c < num_components; c++) {
+							                   local_slices[c][coord] += buffer[c];
+						                   }
+					                   });
+				}
+			}
+		}
+		for (const auto &p : diagonal_recvs[rank_index]) {
+			const DiagonalNbrInfo<D> &info       = p.first;
+			const T *                 buffer_ptr = rank_buffer + p.second * num_components;
+			GetLocalDatas(us, info.local_index, local_datas);
+			nested_loop<D>(info.start, info.end, [&](const std::array<int, D> &coord) {
+				if (interleaved) {
+					T *local = local_datas[0].getPtr(coord);
+					std::copy(buffer_ptr, buffer_ptr + num_components, local);
+				} else {
+					for (int c = 0; c < num_components; c++) {
+						local_datas[c][coord] = buffer_ptr[c];
 					}
 				}
+				buffer_ptr += num_components;
+			});
+		}
+	}
+	/**
+	 * @brief process recvs as they are ready
+	 *
+	 * @param us the vectors to fill ghost values in
+	 */
+	void processRecvs(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const
+	{
+		ExchangeBuffers &buffers = *active_buffers;
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Wait(&buffers.collective_request, MPI_STATUS_IGNORE);
+			for (size_t i = 0; i < incoming_ghosts.size(); i++) {
+				addRecvBufferToGhosts(us, i, buffers.recv_buffer.data() + buffers.recv_displs[i]);
 			}
+			return;
+		}
+		if (backend == GhostExchangeBackend::SharedMemory) {
+			// wait for the ranks on this node to finish writing to the shared window
+			MPI_Win_sync(buffers.shared_window);
+			MPI_Barrier(node_comm);
+			MPI_Win_sync(buffers.shared_window);
+			T *copy_start
+			= buffers.shared_recv_buffer + buffers.shared_buffer_copy * buffers.recv_buffer.size();
+			for (size_t i = 0; i < node_ranks.size(); i++) {
+				if (node_ranks[i] != MPI_UNDEFINED) {
+					addRecvBufferToGhosts(us, i, copy_start + buffers.recv_displs[i]);
+				}
+			}
+			buffers.shared_buffer_copy = 1 - buffers.shared_buffer_copy;
+		}
+		size_t num_requests = buffers.recv_requests.size();
+		for (size_t j = 0; j < num_requests; j++) {
+			int finished_index;
+			MPI_Waitany(buffers.recv_requests.size(), buffers.recv_requests.data(), &finished_index,
+			            MPI_STATUS_IGNORE);
+			size_t i = p2p_indexes[finished_index];
+			addRecvBufferToGhosts(us, i, buffers.recv_buffer.data() + buffers.recv_displs[i]);
 		}
 	}
 	/**
-	 * @brief fill buffers and post send requests
+	 * @brief fill the send buffer for a rank
 	 *
-	 * @param buffers the allocated buffers
-	 * @param u the vector to fill buffers from
-	 * @return std::vector<MPI_Request> the requests
+	 * @param us the vectors to fill buffers from
+	 * @param rank_index the index of the rank in index_rank_map
+	 * @param rank_buffer the start of the buffer for the rank
 	 */
-	std::vector<MPI_Request> postSends(std::vector<std::vector<double>> &buffers,
-	                                   std::shared_ptr<const Vector<D>>  u) const
+	void fillSendBuffer(const std::vector<std::shared_ptr<const Vector<D, T>>> &us,
+	                    size_t rank_index, T *rank_buffer) const
 	{
-		std::vector<MPI_Request> send_requests(send_buff_lengths.size());
-		for (size_t i = 0; i < remote_calls.size(); i++) {
-			for (const RemoteCall &call : remote_calls[i]) {
-				auto    pinfo         = std::get<0>(call);
-				auto    side          = std::get<1>(call);
-				auto    nbr_type      = std::get<2>(call);
-				auto    orthant       = std::get<3>(call);
-				auto    local_datas   = u->getLocalDatas(std::get<4>(call));
-				size_t  buffer_offset = std::get<5>(call);
-				double *buffer_ptr    = buffers[i].data() + buffer_offset * u->getNumComponents();
+		ExchangeBuffers &buffers = *active_buffers;
+		int num_components = GetNumComponents(us);
+		std::fill(rank_buffer, rank_buffer + buffers.send_counts[rank_index], 0.0);
+		for (const RemoteCall &call : remote_calls[rank_index]) {
+			auto    pinfo         = std::get<0>(call);
+			auto    side          = std::get<1>(call);
+			auto    nbr_type      = std::get<2>(call);
+			auto    orthant       = std::get<3>(call);
+			size_t  buffer_offset = std::get<5>(call);
+			T *     buffer_ptr    = rank_buffer + buffer_offset * num_components;
+
+			int buffer_c = 0;
+			for (const auto &u : us) {
+				auto local_datas = u->getLocalDatas(std::get<4>(call));
 
 				// create LocalData objects for the buffer
-				std::vector<LocalData<D>> buffer_datas(u->getNumComponents());
+				std::vector<LocalData<D, T>> buffer_datas(u->getNumComponents());
 				for (int c = 0; c < u->getNumComponents(); c++) {
-					buffer_datas[c] = getLocalDataForBuffer(buffer_ptr, side.opposite(), c);
+					buffer_datas[c]
+					= getLocalDataForBuffer(buffer_ptr, side.opposite(), buffer_c, num_components);
+					buffer_c++;
 				}
 
 				// make the call
 				fillGhostCellsForNbrPatch(pinfo, local_datas, buffer_datas, side, nbr_type,
 				                          orthant);
 			}
-			MPI_Isend(buffers[i].data(), buffers[i].size(), MPI_DOUBLE, index_rank_map[i], 0,
-			          MPI_COMM_WORLD, &send_requests[i]);
 		}
-		return send_requests;
+		std::vector<LocalData<D, T>> nbr_datas(num_components);
+		for (const auto &p : diagonal_sends[rank_index]) {
+			const DiagonalNbrInfo<D> &info       = p.first;
+			T *                       buffer_ptr = rank_buffer + p.second * num_components;
+			GetLocalDatas(us, info.nbr_local_index, nbr_datas);
+			nested_loop<D>(info.start, info.end, [&](const std::array<int, D> &coord) {
+				for (int c = 0; c < num_components; c++) {
+					*buffer_ptr = info.getGhostValue(nbr_datas[c], coord);
+					buffer_ptr++;
+				}
+			});
+		}
+	}
+	/**
+	 * @brief start the recvs, fill the send buffers, and start the sends
+	 *
+	 * @param us the vectors to fill buffers from
+	 */
+	void startExchange(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const
+	{
+		ExchangeBuffers &buffers = *active_buffers;
+		if (!buffers.recv_requests.empty()) {
+			MPI_Startall(buffers.recv_requests.size(), buffers.recv_requests.data());
+		}
+		for (size_t j = 0; j < p2p_indexes.size(); j++) {
+			size_t i = p2p_indexes[j];
+			fillSendBuffer(us, i, buffers.out_buffer.data() + buffers.send_displs[i]);
+			MPI_Start(&buffers.send_requests[j]);
+		}
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			for (size_t i = 0; i < remote_calls.size(); i++) {
+				fillSendBuffer(us, i, buffers.out_buffer.data() + buffers.send_displs[i]);
+			}
+#if MPI_VERSION >= 4
+			MPI_Start(&buffers.collective_request);
+#else
+			MPI_Ineighbor_alltoallv(buffers.out_buffer.data(), buffers.send_counts.data(),
+			                        buffers.send_displs.data(), MPIDatatype<T>::get(),
+			                        buffers.recv_buffer.data(), buffers.recv_counts.data(),
+			                        buffers.recv_displs.data(), MPIDatatype<T>::get(), nbr_comm,
+			                        &buffers.collective_request);
+#endif
+		}
+		if (backend == GhostExchangeBackend::SharedMemory) {
+			// write directly into the recv buffers of the ranks on this node
+			int num_components = GetNumComponents(us);
+			for (size_t i = 0; i < node_ranks.size(); i++) {
+				if (node_ranks[i] != MPI_UNDEFINED) {
+					int     offset      = nbr_recv_offsets[i][0] * num_components;
+					int     copy_length = nbr_recv_offsets[i][1] * num_components;
+					T *     rank_buffer = buffers.nbr_shared_recv_buffers[i]
+					                      + buffers.shared_buffer_copy * copy_length + offset;
+					fillSendBuffer(us, i, rank_buffer);
+				}
+			}
+		}
+	}
+	/**
+	 * @brief Build local_table from the stencils of the derived class
+	 *
+	 * The blocks are added in the same order that startFill makes the calls in, so that the
+	 * ghost values are summed in the same order. This also finds the first contributor for each
+	 * ghost cell, and sets table_zeroed_sides and incoming_ghost_assigns.
+	 */
+	void buildLocalTable() const
+	{
+		local_table_built  = true;
+		local_table_usable = false;
+
+		int                num_ghost = domain->getNumGhostCells();
+		std::array<int, D> ns        = domain->getNs();
+		// for each side of each local patch, which ghost cells have been assigned to by the table
+		std::vector<std::vector<bool>> assigned(domain->getNumLocalPatches() * Side<D>::num_sides);
+		for (size_t region = 0; region < assigned.size(); region++) {
+			Side<D> side(region % Side<D>::num_sides);
+			size_t  length = num_ghost;
+			for (size_t i = 0; i < D; i++) {
+				if (i != side.getAxisIndex()) {
+					length *= ns[i];
+				}
+			}
+			assigned[region].resize(length);
+		}
+		// the first term for a ghost cell on a single side of a patch assigns to the ghost cell,
+		// ghost cells outside of the patch on more than one axis are never zeroed so they are
+		// always added to
+		std::vector<bool> assign;
+
+		auto findFirstTerms = [&](int dst_patch, const std::vector<GhostFillTerm<D>> &terms) {
+			assign.assign(terms.size(), false);
+			for (size_t t = 0; t < terms.size(); t++) {
+				const std::array<int, D> &coord       = terms[t].dst_coord;
+				int                       num_outside = 0;
+				Side<D>                   side;
+				int                       layer = 0;
+				for (size_t i = 0; i < D; i++) {
+					if (coord[i] < 0) {
+						num_outside++;
+						side  = Side<D>::LowerSideOnAxis(i);
+						layer = -coord[i] - 1;
+					} else if (coord[i] >= ns[i]) {
+						num_outside++;
+						side  = Side<D>::HigherSideOnAxis(i);
+						layer = coord[i] - ns[i];
+					}
+				}
+				if (num_outside != 1 || layer >= num_ghost) {
+					continue;
+				}
+				size_t index = layer;
+				for (size_t i = 0; i < D; i++) {
+					if (i != side.getAxisIndex()) {
+						index = index * ns[i] + coord[i];
+					}
+				}
+				size_t region = dst_patch * Side<D>::num_sides + side.getIndex();
+				if (!assigned[region][index]) {
+					assigned[region][index] = true;
+					assign[t]               = true;
+				}
+			}
+		};
+
+		GhostFillTable<D>             table;
+		std::vector<GhostFillTerm<D>> terms;
+		for (auto pinfo : domain->getPatchInfoVector()) {
+			terms.clear();
+			if (!getLocalPatchStencil(pinfo, terms)) {
+				return;
+			}
+			findFirstTerms(pinfo->local_index, terms);
+			table.addBlock(pinfo->local_index, pinfo->local_index, terms, assign);
+		}
+		for (const LocalCall &call : local_calls) {
+			terms.clear();
+			if (!getNbrPatchStencil(std::get<0>(call), std::get<1>(call), std::get<2>(call),
+			                        std::get<3>(call), terms)) {
+				return;
+			}
+			findFirstTerms(std::get<5>(call), terms);
+			table.addBlock(std::get<4>(call), std::get<5>(call), terms, assign);
+		}
+		local_table        = table;
+		local_table_usable = true;
+
+		// the values from another rank are assigned to the ghost cells if the table doesn't fill
+		// any of them, and no other rank sends values for them
+		std::vector<int> num_incoming(assigned.size());
+		for (const auto &rank_incoming_ghosts : incoming_ghosts) {
+			for (const auto &t : rank_incoming_ghosts) {
+				num_incoming[std::get<0>(t) * Side<D>::num_sides + std::get<1>(t).getIndex()]++;
+			}
+		}
+		std::vector<bool> remote_assigns(assigned.size());
+		for (const auto &p : nbr_sides) {
+			size_t             region_index = p.first * Side<D>::num_sides + p.second.getIndex();
+			std::vector<bool> &region       = assigned[region_index];
+			size_t             num_assigned = std::count(region.begin(), region.end(), true);
+			if (num_assigned == 0 && num_incoming[region_index] == 1) {
+				remote_assigns[region_index] = true;
+			} else if (num_assigned != region.size()) {
+				table_zeroed_sides.push_back(p);
+			}
+		}
+		for (size_t i = 0; i < incoming_ghosts.size(); i++) {
+			for (size_t j = 0; j < incoming_ghosts[i].size(); j++) {
+				const auto &t                = incoming_ghosts[i][j];
+				incoming_ghost_assigns[i][j] = remote_assigns[std::get<0>(t) * Side<D>::num_sides
+				                                              + std::get<1>(t).getIndex()];
+			}
+		}
+	}
+	/**
+	 * @brief Check if local_table can be used to fill the ghost cells of a vector
+	 *
+	 * @param u the vector
+	 * @return true if the table was built and all of the patches of the vector have the same
+	 * strides, since the offsets in the table are the same for every patch
+	 */
+	bool usesLocalTable(std::shared_ptr<const Vector<D, T>> u) const
+	{
+		if (!local_table_usable || domain->getNumLocalPatches() == 0) {
+			return false;
+		}
+		std::array<int, D> strides = u->getLocalData(0, 0).getStrides();
+		for (int c = 0; c < u->getNumComponents(); c++) {
+			for (int i = 0; i < domain->getNumLocalPatches(); i++) {
+				if (u->getLocalData(c, i).getStrides() != strides) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	/**
+	 * @brief Fill the ghost cells that only depend on patches on this rank using local_table
+	 *
+	 * @param u the vector, usesLocalTable has to be true for it
+	 */
+	void fillLocalGhostsWithTable(std::shared_ptr<const Vector<D, T>> u) const
+	{
+		local_table.compile(u->getLocalData(0, 0).getStrides());
+		std::vector<T *> patch_ptrs(domain->getNumLocalPatches());
+		if (u->hasInterleavedComponents()) {
+			// the table is applied to all of the components of each cell at once
+			for (size_t i = 0; i < patch_ptrs.size(); i++) {
+				patch_ptrs[i] = u->getLocalData(0, i).getPtr();
+			}
+			local_table.apply(patch_ptrs, u->getNumComponents());
+			return;
+		}
+		for (int c = 0; c < u->getNumComponents(); c++) {
+			for (size_t i = 0; i < patch_ptrs.size(); i++) {
+				patch_ptrs[i] = u->getLocalData(c, i).getPtr();
+			}
+			local_table.apply(patch_ptrs);
+		}
+	}
+	/**
+	 * @brief Zero the ghost cells on some sides of the patches
+	 *
+	 * @param u the vector
+	 * @param sides the sides, as pairs of local index and side
+	 */
+	void zeroGhosts(std::shared_ptr<const Vector<D, T>>         u,
+	                const std::vector<std::pair<int, Side<D>>> &sides) const
+	{
+		for (const auto &p : sides) {
+			for (auto &this_patch : u->getLocalDatas(p.first)) {
+				for (int i = 0; i < domain->getNumGhostCells(); i++) {
+					auto this_ghost = this_patch.getGhostSliceOnSide(p.second, i + 1);
+					nested_loop<D - 1>(this_ghost.getStart(), this_ghost.getEnd(),
+					                   [&](const std::array<int, D - 1> &coord) {
+						                   this_ghost[coord] = 0;
+					                   });
+				}
+			}
+		}
+	}
+	/**
+	 * @brief Start filling ghost cells on a list of vectors
+	 *
+	 * @param us  the vectors
+	 */
+	void startFill(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const
+	{
+		if (exchange_in_progress) {
+			throw RuntimeError("fillGhostStart called before the previous exchange was finished");
+		}
+
+		if (!local_table_built) {
+			buildLocalTable();
+		}
+		std::vector<bool> uses_table(us.size());
+		for (size_t i = 0; i < us.size(); i++) {
+			uses_table[i] = usesLocalTable(us[i]);
+		}
+
+		// zero out the ghost cells that are only added to
+		for (size_t i = 0; i < us.size(); i++) {
+			zeroGhosts(us[i], uses_table[i] ? table_zeroed_sides : nbr_sides);
+		}
+
+		// start recvs and sends
+		active_buffers = &getExchangeBuffers(GetNumComponents(us));
+		startExchange(us);
+		// only set once the exchange is started, so a failure before this doesn't block later fills
+		exchange_in_progress = true;
+
+		// perform local operations
+		for (size_t i = 0; i < us.size(); i++) {
+			const auto &u = us[i];
+			if (uses_table[i]) {
+				fillLocalGhostsWithTable(u);
+			} else {
+				for (auto pinfo : domain->getPatchInfoVector()) {
+					auto datas = u->getLocalDatas(pinfo->local_index);
+					fillGhostCellsForLocalPatch(pinfo, datas);
+				}
+				for (const LocalCall &call : local_calls) {
+					auto pinfo       = std::get<0>(call);
+					auto side        = std::get<1>(call);
+					auto nbr_type    = std::get<2>(call);
+					auto orthant     = std::get<3>(call);
+					auto local_datas = u->getLocalDatas(std::get<4>(call));
+					auto nbr_datas   = u->getLocalDatas(std::get<5>(call));
+					fillGhostCellsForNbrPatch(pinfo, local_datas, nbr_datas, side, nbr_type,
+					                          orthant);
+				}
+			}
+			for (const DiagonalNbrInfo<D> &info : diagonal_local_calls) {
+				auto local_datas = u->getLocalDatas(info.local_index);
+				auto nbr_datas   = u->getLocalDatas(info.nbr_local_index);
+				nested_loop<D>(info.start, info.end, [&](const std::array<int, D> &coord) {
+					for (int c = 0; c < u->getNumComponents(); c++) {
+						local_datas[c][coord] = info.getGhostValue(nbr_datas[c], coord);
+					}
+				});
+			}
+		}
+	}
+	/**
+	 * @brief Finish filling ghost cells on a list of vectors
+	 *
+	 * @param us  the vectors that were passed to startFill
+	 */
+	void finishFill(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const
+	{
+		if (!exchange_in_progress) {
+			throw RuntimeError("fillGhostFinish called without a matching fillGhostStart");
+		}
+		processRecvs(us);
+
+		// wait for sends for finish
+		MPI_Waitall(active_buffers->send_requests.size(), active_buffers->send_requests.data(),
+		            MPI_STATUS_IGNORE);
+		exchange_in_progress = false;
 	}
 
 	protected:
@@ -218,9 +990,17 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 	 *
 	 * @param domain_in  the domain being used
 	 * @param side_cases_in  the number of side cases to address
+	 * @param backend_in  the backend used to exchange ghost values with other ranks. With the
+	 * SharedMemory backend, construction and every exchange are collective over the ranks of a
+	 * node.
+	 * @param fill_diagonal_ghosts  also fill the edge and corner ghost cells, see
+	 * DiagonalNbrInfo::getGhostValue for how they are filled. If true, construction has to be done
+	 * on all ranks.
 	 */
-	MPIGhostFiller(std::shared_ptr<const Domain<D>> domain_in, int side_cases_in)
-	: domain(domain_in), side_cases(side_cases_in)
+	MPIGhostFiller(std::shared_ptr<const Domain<D>> domain_in, int side_cases_in,
+	               GhostExchangeBackend backend_in           = GhostExchangeBackend::PointToPoint,
+	               bool                             fill_diagonal_ghosts = false)
+	: backend(backend_in), domain(domain_in), side_cases(side_cases_in)
 	{
 		int rank;
 		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -247,6 +1027,7 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 		for (auto pinfo : domain->getPatchInfoVector()) {
 			for (Side<D> s : Side<D>::getValues()) {
 				if (pinfo->hasNbr(s)) {
+					nbr_sides.emplace_back(pinfo->local_index, s);
 					switch (pinfo->getNbrType(s)) {
 						case NbrType::Normal: {
 							auto nbrinfo = pinfo->getNormalNbrInfo(s);
@@ -301,6 +1082,19 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 				}
 			}
 		}
+		std::vector<DiagonalNbrInfo<D>> diagonal_infos;
+		if (fill_diagonal_ghosts) {
+			diagonal_infos = domain->findDiagonalNbrs();
+		}
+		for (const DiagonalNbrInfo<D> &info : diagonal_infos) {
+			if (info.rank == rank && info.nbr_rank == rank) {
+				diagonal_local_calls.push_back(info);
+			} else if (info.rank == rank) {
+				ranks.insert(info.nbr_rank);
+			} else {
+				ranks.insert(info.rank);
+			}
+		}
 		std::map<int, size_t> rank_index_map;
 		index_rank_map.reserve(ranks.size());
 		int curr_index = 0;
@@ -339,6 +1133,8 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 		}
 		recv_buff_lengths.resize(ranks.size());
 		incoming_ghosts.resize(ranks.size());
+		incoming_ghost_assigns.resize(ranks.size());
+		remote_dependent.resize(domain->getNumLocalPatches());
 		for (auto t : incoming_ghost_set) {
 			int     local_buffer_index = rank_index_map[std::get<0>(t)];
 			Side<D> side               = std::get<2>(t);
@@ -351,8 +1147,79 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 
 			// add ghost to incoming ghosts
 			incoming_ghosts[local_buffer_index].emplace_back(local_index, side, offset);
+			incoming_ghost_assigns[local_buffer_index].push_back(false);
+			remote_dependent[local_index] = true;
+		}
+		// edge and corner ghost cells go after the side ghost cells in the buffers
+		diagonal_recvs.resize(ranks.size());
+		diagonal_sends.resize(ranks.size());
+		for (const DiagonalNbrInfo<D> &info : diagonal_infos) {
+			if (info.rank == rank && info.nbr_rank != rank) {
+				int    local_buffer_index = rank_index_map[info.nbr_rank];
+				size_t offset             = recv_buff_lengths[local_buffer_index];
+				recv_buff_lengths[local_buffer_index] += info.getNumCells();
+				diagonal_recvs[local_buffer_index].emplace_back(info, offset);
+				remote_dependent[info.local_index] = true;
+			} else if (info.rank != rank) {
+				int    local_buffer_index = rank_index_map[info.rank];
+				size_t offset             = send_buff_lengths[local_buffer_index];
+				send_buff_lengths[local_buffer_index] += info.getNumCells();
+				diagonal_sends[local_buffer_index].emplace_back(info, offset);
+			}
+		}
+		// ghost values are sent to and recieved from the same ranks
+		std::vector<int> nbr_ranks(index_rank_map.begin(), index_rank_map.end());
+		switch (backend) {
+			case GhostExchangeBackend::PointToPoint: {
+				for (size_t i = 0; i < nbr_ranks.size(); i++) {
+					p2p_indexes.push_back(i);
+				}
+			} break;
+			case GhostExchangeBackend::NeighborCollective: {
+				MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, nbr_ranks.size(), nbr_ranks.data(),
+				                               MPI_UNWEIGHTED, nbr_ranks.size(), nbr_ranks.data(),
+				                               MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &nbr_comm);
+			} break;
+			case GhostExchangeBackend::SharedMemory: {
+				setupNodeRanks(nbr_ranks);
+			} break;
+		}
+	}
+	/**
+	 * @brief The persistent requests and communicators can not be shared, so an
+	 * MPIGhostFiller can not be copied
+	 */
+	MPIGhostFiller(const MPIGhostFiller<D, T> &) = delete;
+	MPIGhostFiller<D, T> &operator=(const MPIGhostFiller<D, T> &) = delete;
+	/**
+	 * @brief Destroy the MPIGhostFiller object, freeing the persistent requests, the shared
+	 * window, and the communicators
+	 */
+	virtual ~MPIGhostFiller()
+	{
+		int finalized;
+		MPI_Finalized(&finalized);
+		if (!finalized) {
+			for (auto &pair : exchange_buffers) {
+				FreeExchangeBuffers(pair.second);
+			}
+			if (nbr_comm != MPI_COMM_NULL) {
+				MPI_Comm_free(&nbr_comm);
+			}
+			if (node_comm != MPI_COMM_NULL) {
+				MPI_Comm_free(&node_comm);
+			}
 		}
 	}
+	/**
+	 * @brief Get the backend used to exchange ghost values with other ranks
+	 *
+	 * @return GhostExchangeBackend the backend
+	 */
+	GhostExchangeBackend getExchangeBackend() const
+	{
+		return backend;
+	}
 	/**
 	 * @brief Fill the ghost cells for the neighboring patch
 	 *
@@ -365,8 +1232,8 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 	 * @param orthant the orthant that the neighbors ghost cells lie on
 	 */
 	virtual void fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                                       const std::vector<LocalData<D>> &   local_datas,
-	                                       const std::vector<LocalData<D>> &   nbr_datas,
+	                                       const std::vector<LocalData<D, T>> &local_datas,
+	                                       const std::vector<LocalData<D, T>> &nbr_datas,
 	                                       const Side<D> side, const NbrType nbr_type,
 	                                       const Orthant<D> orthant) const = 0;
 
@@ -381,68 +1248,108 @@ template <int D> class MPIGhostFiller : public GhostFiller<D>
 	 */
 	virtual void
 	fillGhostCellsForLocalPatch(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                            const std::vector<LocalData<D>> &   local_datas) const = 0;
+	                            const std::vector<LocalData<D, T>> &local_datas) const = 0;
+	/**
+	 * @brief Get the terms that fillGhostCellsForNbrPatch adds to the ghost cells of the
+	 * neighboring patch, for one component.
+	 *
+	 * The ghost fill between patches on this rank is compiled into a table from these terms. The
+	 * source coordinates are in the patch, and the destination coordinates are in the neighboring
+	 * patch.
+	 *
+	 * @param pinfo the patch that ghost cells are being filled from
+	 * @param side the sided that the neighboring patch is on
+	 * @param nbr_type the type of neighbor
+	 * @param orthant the orthant that the neighbors ghost cells lie on
+	 * @param terms the terms are appended to this, in the order that fillGhostCellsForNbrPatch
+	 * adds them
+	 * @return false if the ghost filler doesn't provide stencils, fillGhostCellsForNbrPatch is
+	 * used instead
+	 */
+	virtual bool getNbrPatchStencil(std::shared_ptr<const PatchInfo<D>> pinfo, const Side<D> side,
+	                                const NbrType nbr_type, const Orthant<D> orthant,
+	                                std::vector<GhostFillTerm<D>> &terms) const
+	{
+		return false;
+	}
+	/**
+	 * @brief Get the terms that fillGhostCellsForLocalPatch adds to the ghost cells of the patch,
+	 * for one component.
+	 *
+	 * @param pinfo the patch
+	 * @param terms the terms are appended to this, in the order that fillGhostCellsForLocalPatch
+	 * adds them
+	 * @return false if the ghost filler doesn't provide stencils, fillGhostCellsForLocalPatch is
+	 * used instead
+	 */
+	virtual bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                                  std::vector<GhostFillTerm<D>> &     terms) const
+	{
+		return false;
+	}
 
 	/**
 	 * @brief Fill ghost cells on a vector
 	 *
 	 * @param u  the vector
 	 */
-	void fillGhost(std::shared_ptr<const Vector<D>> u) const
+	void fillGhost(std::shared_ptr<const Vector<D, T>> u) const override
 	{
-		// zero out ghost cells
-		for (auto pinfo : domain->getPatchInfoVector()) {
-			for (auto &this_patch : u->getLocalDatas(pinfo->local_index)) {
-				for (Side<D> s : Side<D>::getValues()) {
-					if (pinfo->hasNbr(s)) {
-						for (int i = 0; i < pinfo->num_ghost_cells; i++) {
-							auto this_ghost = this_patch.getGhostSliceOnSide(s, i + 1);
-							nested_loop<D - 1>(
-							this_ghost.getStart(), this_ghost.getEnd(),
-							[&](const std::array<int, D - 1> &coord) { this_ghost[coord] = 0; });
-						}
-					}
-				}
-			}
-		}
-
-		// allocate recv buffers and post recvs
-		std::vector<std::vector<double>> recv_buffers(recv_buff_lengths.size());
-		for (size_t i = 0; i < recv_buff_lengths.size(); i++) {
-			recv_buffers[i].resize(recv_buff_lengths[i] * u->getNumComponents());
-		}
-		std::vector<MPI_Request> recv_requests = postRecvs(recv_buffers);
-
-		// allocate send buffers
-		std::vector<std::vector<double>> out_buffers(send_buff_lengths.size());
-		for (size_t i = 0; i < send_buff_lengths.size(); i++) {
-			out_buffers[i].resize(send_buff_lengths[i] * u->getNumComponents());
-		}
-		std::vector<MPI_Request> send_requests = postSends(out_buffers, u);
-
-		// perform local operations
-		for (auto pinfo : domain->getPatchInfoVector()) {
-			auto datas = u->getLocalDatas(pinfo->local_index);
-			fillGhostCellsForLocalPatch(pinfo, datas);
-		}
-		for (const LocalCall &call : local_calls) {
-			auto pinfo       = std::get<0>(call);
-			auto side        = std::get<1>(call);
-			auto nbr_type    = std::get<2>(call);
-			auto orthant     = std::get<3>(call);
-			auto local_datas = u->getLocalDatas(std::get<4>(call));
-			auto nbr_datas   = u->getLocalDatas(std::get<5>(call));
-			fillGhostCellsForNbrPatch(pinfo, local_datas, nbr_datas, side, nbr_type, orthant);
-		}
-
-		processRecvs(recv_requests, recv_buffers, u);
-
-		// wait for sends for finish
-		MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUS_IGNORE);
+		fillGhostStart(u);
+		fillGhostFinish(u);
+	}
+	/**
+	 * @brief Fill ghost cells on a list of vectors
+	 *
+	 * The ghost values of all the vectors are packed into one message for each neighboring rank.
+	 *
+	 * @param us  the vectors
+	 */
+	void fillGhost(const std::vector<std::shared_ptr<const Vector<D, T>>> &us) const override
+	{
+		startFill(us);
+		finishFill(us);
+	}
+	/**
+	 * @brief Start filling ghost cells on a vector
+	 *
+	 * This posts the recvs and sends, and fills the ghost cells that only depend on values from
+	 * this rank.
+	 *
+	 * @param u  the vector
+	 */
+	void fillGhostStart(std::shared_ptr<const Vector<D, T>> u) const override
+	{
+		startFill({u});
+	}
+	/**
+	 * @brief Finish filling ghost cells on a vector
+	 *
+	 * This adds in the ghost values from the other ranks as they arrive, and waits for the sends
+	 * to finish.
+	 *
+	 * @param u  the vector that was passed to fillGhostStart
+	 */
+	void fillGhostFinish(std::shared_ptr<const Vector<D, T>> u) const override
+	{
+		finishFill({u});
+	}
+	/**
+	 * @brief Check if the ghost cells of a patch are filled from other ranks
+	 *
+	 * @param pinfo the patch
+	 * @return true if the ghost cells are filled from other ranks
+	 */
+	bool isRemoteDependent(std::shared_ptr<const PatchInfo<D>> pinfo) const override
+	{
+		return remote_dependent[pinfo->local_index];
 	}
 };
 extern template class MPIGhostFiller<1>;
 extern template class MPIGhostFiller<2>;
 extern template class MPIGhostFiller<3>;
+extern template class MPIGhostFiller<1, float>;
+extern template class MPIGhostFiller<2, float>;
+extern template class MPIGhostFiller<3, float>;
 } // namespace ThunderEgg
 #endif
\ No newline at end of file
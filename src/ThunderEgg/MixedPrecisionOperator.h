@@ -0,0 +1,99 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+
+#ifndef THUNDEREGG_MIXEDPRECISIONOPERATOR_H
+#define THUNDEREGG_MIXEDPRECISIONOPERATOR_H
+
+#include <ThunderEgg/Operator.h>
+#include <ThunderEgg/RuntimeError.h>
+#include <ThunderEgg/VectorGenerator.h>
+
+namespace ThunderEgg
+{
+/**
+ * @brief Applies an operator on vectors of a lower precision to double vectors
+ *
+ * The input is converted to the scalar type of the wrapped operator, the operator is applied, and
+ * the result is converted back. This is used to run a GMG cycle in single precision as the
+ * preconditioner of a Krylov solver in double precision, which halves the memory traffic of the
+ * preconditioner.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the wrapped operator
+ */
+template <int D, typename T> class MixedPrecisionOperator : public Operator<D>
+{
+	private:
+	/**
+	 * @brief the wrapped operator
+	 */
+	std::shared_ptr<const Operator<D, T>> op;
+	/**
+	 * @brief generates the work vectors for the wrapped operator
+	 */
+	std::shared_ptr<VectorGenerator<D, T>> vg;
+
+	public:
+	/**
+	 * @brief Construct a new MixedPrecisionOperator object
+	 *
+	 * @param op the operator to wrap
+	 * @param vg generates the work vectors for the wrapped operator
+	 * @exception RuntimeError if either of the arguments is nullptr
+	 */
+	MixedPrecisionOperator(std::shared_ptr<const Operator<D, T>>  op,
+	                       std::shared_ptr<VectorGenerator<D, T>> vg)
+	: op(op), vg(vg)
+	{
+		if (op == nullptr) {
+			throw RuntimeError("Operator is nullptr");
+		}
+		if (vg == nullptr) {
+			throw RuntimeError("VectorGenerator is nullptr");
+		}
+	}
+	/**
+	 * @brief Get the wrapped operator
+	 *
+	 * @return std::shared_ptr<const Operator<D, T>> the operator
+	 */
+	std::shared_ptr<const Operator<D, T>> getOperator() const
+	{
+		return op;
+	}
+	/**
+	 * @brief Apply the wrapped operator
+	 *
+	 * @param x the input vector
+	 * @param b the output vector
+	 */
+	void apply(std::shared_ptr<const Vector<D>> x, std::shared_ptr<Vector<D>> b) const override
+	{
+		std::shared_ptr<Vector<D, T>> x_converted = vg->getNewVector();
+		std::shared_ptr<Vector<D, T>> b_converted = vg->getNewVector();
+		x_converted->copyWithConversion(*x);
+		op->apply(x_converted, b_converted);
+		b->copyWithConversion(*b_converted);
+	}
+};
+} // namespace ThunderEgg
+#endif
@@ -28,8 +28,11 @@ namespace ThunderEgg
 {
 /**
  * @brief Base class for operators
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class Operator
+template <int D, typename T = double> class Operator
 {
 	public:
 	/**
@@ -43,7 +46,25 @@ template <int D> class Operator
 	 * @param x the input vector.
 	 * @param b the output vector.
 	 */
-	virtual void apply(std::shared_ptr<const Vector<D>> x, std::shared_ptr<Vector<D>> b) const = 0;
+	virtual void apply(std::shared_ptr<const Vector<D, T>> x,
+	                   std::shared_ptr<Vector<D, T>>       b) const = 0;
+	/**
+	 * @brief Compute the residual r = b - A x
+	 *
+	 * This applies the operator and then subtracts, derived classes can override this to compute
+	 * the residual in a single pass.
+	 *
+	 * @param b the right hand side
+	 * @param x the input vector
+	 * @param r the output residual
+	 */
+	virtual void residual(std::shared_ptr<const Vector<D, T>> b,
+	                      std::shared_ptr<const Vector<D, T>> x,
+	                      std::shared_ptr<Vector<D, T>>       r) const
+	{
+		apply(x, r);
+		r->scaleThenAdd(-1, b);
+	}
 };
 } // namespace ThunderEgg
 #endif
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_PATCHKERNELREGISTRY_H
+#define THUNDEREGG_PATCHKERNELREGISTRY_H
+#include <array>
+#include <map>
+namespace ThunderEgg
+{
+/**
+ * @brief Registry of kernels that are specialized for a patch size
+ *
+ * Kernels are registered for patches with n cells along every axis. Operators look up their
+ * kernels when they are constructed, and fall back to their generic loops for sizes that are not
+ * registered.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam Kernels the set of kernels, a default constructed object means no kernels
+ */
+template <int D, typename Kernels> class PatchKernelRegistry
+{
+	private:
+	/**
+	 * @brief map from the number of cells along each axis to the kernels
+	 */
+	std::map<int, Kernels> kernels;
+
+	public:
+	/**
+	 * @brief Register the kernels for a patch size
+	 *
+	 * This replaces any kernels that were registered for the same size.
+	 *
+	 * @param n the number of cells along each axis
+	 * @param kernels_in the kernels
+	 */
+	void add(int n, const Kernels &kernels_in)
+	{
+		kernels[n] = kernels_in;
+	}
+	/**
+	 * @brief Check if there are kernels for a patch size
+	 *
+	 * @param ns the number of cells along each axis
+	 * @return true if there are kernels for the size
+	 */
+	bool contains(const std::array<int, D> &ns) const
+	{
+		for (int i = 1; i < D; i++) {
+			if (ns[i] != ns[0]) {
+				return false;
+			}
+		}
+		return kernels.count(ns[0]) == 1;
+	}
+	/**
+	 * @brief Get the kernels for a patch size
+	 *
+	 * @param ns the number of cells along each axis
+	 * @return Kernels the kernels, or a default constructed object if there are none
+	 */
+	Kernels find(const std::array<int, D> &ns) const
+	{
+		if (contains(ns)) {
+			return kernels.at(ns[0]);
+		}
+		return Kernels();
+	}
+};
+} // namespace ThunderEgg
+#endif
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_PATCHLOOP_H
+#define THUNDEREGG_PATCHLOOP_H
+#include <ThunderEgg/Domain.h>
+#include <ThunderEgg/GhostFiller.h>
+#include <ThunderEgg/Vector.h>
+#include <exception>
+#include <memory>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+namespace ThunderEgg
+{
+/**
+ * @brief How the patches of a patch loop are handed out to the threads
+ */
+enum class PatchSchedule {
+	/**
+	 * @brief Patches are handed out one at a time as threads become free. This is for loops where
+	 * the work varies between patches, like patch solves.
+	 */
+	Dynamic,
+	/**
+	 * @brief Each thread gets the same contiguous block of patches every time. This is for cheap
+	 * loops with the same work on every patch, and keeps each thread on the memory that it first
+	 * touched.
+	 */
+	Static
+};
+/**
+ * @brief Get the number of threads that patch loops can use
+ *
+ * This is omp_get_max_threads() when ThunderEgg is built with OpenMP, and 1 otherwise.
+ *
+ * @return int the number of threads
+ */
+inline int GetNumPatchLoopThreads()
+{
+#ifdef _OPENMP
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+/**
+ * @brief Get the index of the calling thread in the current patch loop
+ *
+ * This is in [0, GetNumPatchLoopThreads()) for a loop that was started with the current number of
+ * threads, and can be used to pick per-thread scratch storage.
+ *
+ * @return int the index, 0 outside of a threaded patch loop
+ */
+inline int GetPatchLoopThreadNum()
+{
+#ifdef _OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+/**
+ * @brief Check if the caller is inside a patch loop that is running on more than one thread
+ *
+ * Timer is not thread safe, so the timings for single patches are skipped when this is true.
+ *
+ * @return true if it is
+ */
+inline bool InThreadedPatchLoop()
+{
+#ifdef _OPENMP
+	return omp_in_parallel();
+#else
+	return false;
+#endif
+}
+/**
+ * @brief Call a function for each patch, spreading the patches over the OpenMP threads
+ *
+ * The patches are processed in order on the calling thread if ThunderEgg is built without
+ * OpenMP, if threaded is false, or if this is called from inside a threaded patch loop. If func
+ * throws for any of the patches, the first exception that was caught is rethrown after all the
+ * threads are done.
+ *
+ * @tparam Func the function type
+ * @param num_patches the number of patches
+ * @param threaded true if func can be called for different patches at the same time
+ * @param func called with the index of each patch
+ * @param schedule how the patches are handed out to the threads
+ */
+template <typename Func>
+void ParallelPatchLoop(int num_patches, bool threaded, Func func,
+                       PatchSchedule schedule = PatchSchedule::Dynamic)
+{
+#ifdef _OPENMP
+	if (threaded && num_patches > 1 && omp_get_max_threads() > 1 && !omp_in_parallel()) {
+		std::exception_ptr exception;
+		auto run = [&](int p) {
+			try {
+				func(p);
+			} catch (...) {
+#pragma omp critical(ThunderEgg_ParallelPatchLoop)
+				{
+					if (!exception) {
+						exception = std::current_exception();
+					}
+				}
+			}
+		};
+		if (schedule == PatchSchedule::Dynamic) {
+#pragma omp parallel for schedule(dynamic)
+			for (int p = 0; p < num_patches; p++) {
+				run(p);
+			}
+		} else {
+#pragma omp parallel for schedule(static)
+			for (int p = 0; p < num_patches; p++) {
+				run(p);
+			}
+		}
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+		return;
+	}
+#endif
+	for (int p = 0; p < num_patches; p++) {
+		func(p);
+	}
+}
+/**
+ * @brief Split the patches of a Domain in the same way as ForEachPatchWithGhosts, and call a
+ * function once with each group of patches
+ *
+ * func is called with the patches that only need local ghost values while the ghost fill of u is
+ * in progress, and with the rest of the patches after the ghost fill is finished.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
+ * @tparam Func the function type
+ * @param domain the Domain
+ * @param ghost_filler the GhostFiller for u
+ * @param u the vector whose ghost values are filled
+ * @param func called with a std::vector of the PatchInfo objects of each group
+ */
+template <int D, typename T, typename Func>
+void ForEachPatchGroupWithGhosts(std::shared_ptr<const Domain<D>>         domain,
+                                 std::shared_ptr<const GhostFiller<D, T>> ghost_filler,
+                                 std::shared_ptr<const Vector<D, T>> u, Func func)
+{
+	std::vector<std::shared_ptr<const PatchInfo<D>>> local_pinfos;
+	std::vector<std::shared_ptr<const PatchInfo<D>>> remote_pinfos;
+	for (auto pinfo : domain->getPatchInfoVector()) {
+		if (ghost_filler->isRemoteDependent(pinfo)) {
+			remote_pinfos.push_back(pinfo);
+		} else {
+			local_pinfos.push_back(pinfo);
+		}
+	}
+	ghost_filler->fillGhostStart(u);
+	func(local_pinfos);
+	ghost_filler->fillGhostFinish(u);
+	func(remote_pinfos);
+}
+/**
+ * @brief Call a function for each patch of a Domain, overlapping the ghost exchange with the
+ * patches that do not depend on ghost values from other ranks
+ *
+ * The ghost fill of u is started, the patches that only need local ghost values are processed, the
+ * ghost fill is finished, and then the rest of the patches are processed. Each group of patches
+ * goes through ParallelPatchLoop with dynamic scheduling.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
+ * @tparam Func the function type
+ * @param domain the Domain
+ * @param ghost_filler the GhostFiller for u
+ * @param u the vector whose ghost values are filled
+ * @param threaded true if func can be called for different patches at the same time
+ * @param func called with the PatchInfo of each patch
+ */
+template <int D, typename T, typename Func>
+void ForEachPatchWithGhosts(std::shared_ptr<const Domain<D>>         domain,
+                            std::shared_ptr<const GhostFiller<D, T>> ghost_filler,
+                            std::shared_ptr<const Vector<D, T>> u, bool threaded, Func func)
+{
+	auto for_each_patch = [&](const std::vector<std::shared_ptr<const PatchInfo<D>>> &pinfos) {
+		ParallelPatchLoop(pinfos.size(), threaded, [&](int i) { func(pinfos[i]); });
+	};
+	ForEachPatchGroupWithGhosts<D, T>(domain, ghost_filler, u, for_each_patch);
+}
+} // namespace ThunderEgg
+#endif
@@ -24,6 +24,8 @@
 #include <ThunderEgg/Domain.h>
 #include <ThunderEgg/GhostFiller.h>
 #include <ThunderEgg/Operator.h>
+#include <ThunderEgg/PatchLoop.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/Vector.h>
 namespace ThunderEgg
 {
@@ -32,8 +34,9 @@ namespace ThunderEgg
  * that operate on single patch.
  *
  * @tparam D the number of Cartesian dimensions.
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class PatchOperator : public Operator<D>
+template <int D, typename T = double> class PatchOperator : public Operator<D, T>
 {
 	protected:
 	/**
@@ -43,7 +46,28 @@ template <int D> class PatchOperator : public Operator<D>
 	/**
 	 * @brief The ghost filler, needed for smoothing
 	 */
-	std::shared_ptr<const GhostFiller<D>> ghost_filler;
+	std::shared_ptr<const GhostFiller<D, T>> ghost_filler;
+	/**
+	 * @brief Fill the ghost values in u, and call a function for each patch
+	 *
+	 * The ghost exchange is overlapped with func as in ForEachPatchWithGhosts. The patches are
+	 * spread over threads if this operator and all of the vectors are thread safe.
+	 *
+	 * @param u the vector to fill ghost values in
+	 * @param vecs the other vectors that func accesses
+	 * @param func called with the PatchInfo of each patch
+	 */
+	template <typename Func>
+	void forEachPatchWithGhosts(std::shared_ptr<const Vector<D, T>>                        u,
+	                            std::initializer_list<std::shared_ptr<const Vector<D, T>>> vecs,
+	                            Func func) const
+	{
+		bool threaded = isThreadSafe() && u->hasThreadSafeLocalData();
+		for (auto vec : vecs) {
+			threaded = threaded && vec->hasThreadSafeLocalData();
+		}
+		ForEachPatchWithGhosts<D, T>(domain, ghost_filler, u, threaded, func);
+	}
 
 	public:
 	/**
@@ -54,8 +78,8 @@ template <int D> class PatchOperator : public Operator<D>
 	 * @param domain_in  the Domain
 	 * @param ghost_filler_in the GhostFiller
 	 */
-	PatchOperator(std::shared_ptr<const Domain<D>>      domain_in,
-	              std::shared_ptr<const GhostFiller<D>> ghost_filler_in)
+	PatchOperator(std::shared_ptr<const Domain<D>>         domain_in,
+	              std::shared_ptr<const GhostFiller<D, T>> ghost_filler_in)
 	: domain(domain_in), ghost_filler(ghost_filler_in)
 	{
 	}
@@ -63,6 +87,19 @@ template <int D> class PatchOperator : public Operator<D>
 	 * @brief Destroy the PatchOperator object
 	 */
 	virtual ~PatchOperator() {}
+	/**
+	 * @brief Check if the single patch functions can be called for different patches from
+	 * several threads at the same time
+	 *
+	 * This is false by default. Derived classes that do not modify any shared state in the single
+	 * patch functions can override this so that apply and residual run on all the threads.
+	 *
+	 * @return true if they can
+	 */
+	virtual bool isThreadSafe() const
+	{
+		return false;
+	}
 
 	/**
 	 * @brief Apply the operator to a single patch
@@ -77,8 +114,8 @@ template <int D> class PatchOperator : public Operator<D>
 	 * not be used
 	 */
 	virtual void applySinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                              const std::vector<LocalData<D>> &   us,
-	                              std::vector<LocalData<D>> &         fs,
+	                              const std::vector<LocalData<D, T>> &us,
+	                              std::vector<LocalData<D, T>> &      fs,
 	                              bool treat_interior_boundary_as_dirichlet) const = 0;
 	/**
 	 * @brief Treat the internal patch boundaries as an dirichlet boundary condition, and modify the
@@ -91,26 +128,113 @@ template <int D> class PatchOperator : public Operator<D>
 	 * @param fs the right hand side
 	 */
 	virtual void addGhostToRHS(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                           const std::vector<LocalData<D>> &   us,
-	                           std::vector<LocalData<D>> &         fs) const = 0;
+	                           const std::vector<LocalData<D, T>> &us,
+	                           std::vector<LocalData<D, T>> &      fs) const = 0;
 
 	/**
 	 * @brief Apply the operator
 	 *
-	 * This will update the ghost values in u, and then will call applySinglePatch for each patch
+	 * This will update the ghost values in u, and then will call applySinglePatch for each patch.
+	 * This is done with forEachPatchWithGhosts.
 	 *
 	 * @param u the left hand side
 	 * @param f the right hand side
 	 */
-	void apply(std::shared_ptr<const Vector<D>> u, std::shared_ptr<Vector<D>> f) const override
+	void apply(std::shared_ptr<const Vector<D, T>> u,
+	           std::shared_ptr<Vector<D, T>>       f) const override
 	{
-		ghost_filler->fillGhost(u);
-		for (auto pinfo : domain->getPatchInfoVector()) {
+		forEachPatchWithGhosts(u, {f}, [&](std::shared_ptr<const PatchInfo<D>> pinfo) {
 			auto us = u->getLocalDatas(pinfo->local_index);
 			auto fs = f->getLocalDatas(pinfo->local_index);
 			applySinglePatch(pinfo, us, fs, false);
+		});
+	}
+	/**
+	 * @brief Compute the residual r = f - A u on a single patch
+	 *
+	 * The ghost values in u will be updated to the latest values. This applies the operator to the
+	 * patch and then subtracts, derived classes can override this to compute the residual in a
+	 * single pass over the patch.
+	 *
+	 * @param pinfo the patch
+	 * @param fs the right hand side
+	 * @param us the left hand side
+	 * @param rs the residual
+	 */
+	virtual void residualSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                                 const std::vector<LocalData<D, T>> &fs,
+	                                 const std::vector<LocalData<D, T>> &us,
+	                                 std::vector<LocalData<D, T>> &      rs) const
+	{
+		applySinglePatch(pinfo, us, rs, false);
+		for (size_t c = 0; c < rs.size(); c++) {
+			int n        = rs[c].getLengths()[0];
+			int r_stride = rs[c].getStrides()[0];
+			int f_stride = fs[c].getStrides()[0];
+			rs[c].forEachLine([&](const std::array<int, D> &coord, T *r) {
+				const T *f = fs[c].getPtr(coord);
+				for (int i = 0; i < n; i++) {
+					r[i * r_stride] = f[i * f_stride] - r[i * r_stride];
+				}
+			});
 		}
 	}
+	/**
+	 * @brief Get the diagonal of the operator on a single patch
+	 *
+	 * This is used by the pointwise smoothers. The physical boundary conditions that
+	 * applySinglePatch sets through the ghost cells are included in the diagonal.
+	 *
+	 * @param pinfo the patch
+	 * @param ds the output diagonal
+	 */
+	virtual void getDiagonalSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                                    std::vector<LocalData<D, T>> &ds) const
+	{
+		throw RuntimeError("PatchOperator does not provide a diagonal");
+	}
+	/**
+	 * @brief Relax the cells of one color on a single patch with Gauss-Seidel
+	 *
+	 * A cell is red (color 0) if the sum of its coordinates is even, and black (color 1)
+	 * otherwise. Each cell of the color is updated in place with u += weight * (f - A u) / d.
+	 * The ghost values in u have to be filled before calling this.
+	 *
+	 * @param pinfo the patch
+	 * @param fs the right hand side
+	 * @param us the left hand side, updated upon return
+	 * @param ds the diagonal from getDiagonalSinglePatch
+	 * @param color the color of the cells to update
+	 * @param weight the relaxation weight
+	 */
+	virtual void relaxSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                              const std::vector<LocalData<D, T>> &fs,
+	                              const std::vector<LocalData<D, T>> &us,
+	                              const std::vector<LocalData<D, T>> &ds, int color,
+	                              double weight) const
+	{
+		throw RuntimeError("PatchOperator does not provide a Gauss-Seidel relaxation");
+	}
+	/**
+	 * @brief Compute the residual r = f - A u
+	 *
+	 * This will update the ghost values in u, and then will call residualSinglePatch for each
+	 * patch
+	 *
+	 * @param f the right hand side
+	 * @param u the left hand side
+	 * @param r the residual
+	 */
+	void residual(std::shared_ptr<const Vector<D, T>> f, std::shared_ptr<const Vector<D, T>> u,
+	              std::shared_ptr<Vector<D, T>> r) const override
+	{
+		forEachPatchWithGhosts(u, {f, r}, [&](std::shared_ptr<const PatchInfo<D>> pinfo) {
+			auto fs = f->getLocalDatas(pinfo->local_index);
+			auto us = u->getLocalDatas(pinfo->local_index);
+			auto rs = r->getLocalDatas(pinfo->local_index);
+			residualSinglePatch(pinfo, fs, us, rs);
+		});
+	}
 	/**
 	 * @brief Get the Domain object associated with this PatchOperator
 	 */
@@ -121,7 +245,7 @@ template <int D> class PatchOperator : public Operator<D>
 	/**
 	 * @brief Get the GhostFiller object associated with this PatchOperator
 	 */
-	std::shared_ptr<const GhostFiller<D>> getGhostFiller() const
+	std::shared_ptr<const GhostFiller<D, T>> getGhostFiller() const
 	{
 		return ghost_filler;
 	}
@@ -26,13 +26,20 @@
 #include <ThunderEgg/GMG/Smoother.h>
 #include <ThunderEgg/GhostFiller.h>
 #include <ThunderEgg/Operator.h>
+#include <ThunderEgg/PatchLoop.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/Vector.h>
+#include <algorithm>
+#include <map>
 
 namespace ThunderEgg
 {
 /**
  * @brief Solves the problem on the patches using a specified interface value
  *
+ * With a batch size larger than 1, apply and smooth group the patches that have the same boundary
+ * conditions and spacings, and pass up to batch size patches at a time to solveBatch.
+ *
  * @tparam D the number of cartesian dimensions
  */
 template <int D> class PatchSolver : public virtual Operator<D>, public virtual GMG::Smoother<D>
@@ -46,6 +53,125 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 	 * @brief The ghost filler, needed for smoothing
 	 */
 	std::shared_ptr<const GhostFiller<D>> ghost_filler;
+	/**
+	 * @brief The maximum number of patches that are passed to solveBatch
+	 */
+	int batch_size;
+	/**
+	 * @brief Comparator used for grouping patches, patches with the same spacings and boundary
+	 * conditions will be equal
+	 */
+	struct CompareByBoundaryAndSpacings {
+		bool operator()(const std::shared_ptr<const PatchInfo<D>> &a,
+		                const std::shared_ptr<const PatchInfo<D>> &b) const
+		{
+			return std::forward_as_tuple(a->neumann.to_ulong(), a->spacings[0])
+			       < std::forward_as_tuple(b->neumann.to_ulong(), b->spacings[0]);
+		}
+	};
+	/**
+	 * @brief Solve a batch of patches that have the same boundary conditions and spacings
+	 *
+	 * This calls solveSinglePatch for each of the patches by default. Derived classes can override
+	 * this to solve all of the patches of the batch together.
+	 *
+	 * @param batch the patches, at most batch_size of them
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	virtual void solveBatch(const std::vector<std::shared_ptr<const PatchInfo<D>>> &batch,
+	                        std::shared_ptr<const Vector<D>> f, std::shared_ptr<Vector<D>> u) const
+	{
+		for (auto pinfo : batch) {
+			auto fs = f->getLocalDatas(pinfo->local_index);
+			auto us = u->getLocalDatas(pinfo->local_index);
+			solveSinglePatch(pinfo, fs, us);
+		}
+	}
+	/**
+	 * @brief Get the scratch storage of the calling thread
+	 *
+	 * @tparam Scratch the scratch storage type
+	 * @param scratches the scratch storage for each thread
+	 * @return const Scratch& the scratch storage
+	 * @exception RuntimeError if there is no scratch storage for the calling thread
+	 */
+	template <typename Scratch>
+	const Scratch &getThreadScratch(const std::vector<Scratch> &scratches) const
+	{
+		int thread = GetPatchLoopThreadNum();
+		if (thread >= (int) scratches.size()) {
+			throw RuntimeError("PatchSolver has no scratch storage for thread "
+			                   + std::to_string(thread));
+		}
+		return scratches[thread];
+	}
+
+	private:
+	/**
+	 * @brief Solve a single patch as part of smooth, timing the solve if the domain has a timer
+	 *
+	 * The timing is skipped when the patches are being solved on several threads.
+	 *
+	 * @param pinfo the PatchInfo for the patch
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	void smoothSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                       std::shared_ptr<const Vector<D>> f, std::shared_ptr<Vector<D>> u) const
+	{
+		bool timed = domain->hasTimer() && !InThreadedPatchLoop();
+		if (timed) {
+			domain->getTimer()->startPatchTiming(pinfo->id, domain->getId(), "Single Patch Solve");
+		}
+		auto fs = f->getLocalDatas(pinfo->local_index);
+		auto us = u->getLocalDatas(pinfo->local_index);
+		solveSinglePatch(pinfo, fs, us);
+		if (timed) {
+			domain->getTimer()->stopPatchTiming(pinfo->id, domain->getId(), "Single Patch Solve");
+		}
+	}
+	/**
+	 * @brief Check if the patches can be solved on several threads
+	 *
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 * @return true if this solver and both of the vectors are thread safe
+	 */
+	bool canSolveThreaded(std::shared_ptr<const Vector<D>> f,
+	                      std::shared_ptr<const Vector<D>> u) const
+	{
+		return isThreadSafe() && f->hasThreadSafeLocalData() && u->hasThreadSafeLocalData();
+	}
+	/**
+	 * @brief Solve patches in batches
+	 *
+	 * The patches are grouped by boundary conditions and spacings, and each group is split into
+	 * batches of at most batch_size patches. The batches go through ParallelPatchLoop.
+	 *
+	 * @param pinfos the patches
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	void solveBatches(const std::vector<std::shared_ptr<const PatchInfo<D>>> &pinfos,
+	                  std::shared_ptr<const Vector<D>> f, std::shared_ptr<Vector<D>> u) const
+	{
+		std::map<std::shared_ptr<const PatchInfo<D>>,
+		         std::vector<std::shared_ptr<const PatchInfo<D>>>, CompareByBoundaryAndSpacings>
+		groups;
+		for (auto pinfo : pinfos) {
+			groups[pinfo].push_back(pinfo);
+		}
+		std::vector<std::vector<std::shared_ptr<const PatchInfo<D>>>> batches;
+		for (auto &group : groups) {
+			for (size_t start = 0; start < group.second.size(); start += batch_size) {
+				size_t end = std::min(start + batch_size, group.second.size());
+				batches.emplace_back(group.second.begin() + start, group.second.begin() + end);
+			}
+		}
+		ParallelPatchLoop(batches.size(), canSolveThreaded(f, u),
+		                  [&](int i) { solveBatch(batches[i], f, u); });
+	}
 
 	public:
 	/**
@@ -55,11 +181,17 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 	 *
 	 * @param domain the Domain
 	 * @param ghost_filler the GhostFiller
+	 * @param batch_size the maximum number of patches to pass to solveBatch in apply and smooth, 1
+	 * solves one patch at a time
+	 * @exception RuntimeError if the batch size is less than 1
 	 */
 	PatchSolver(std::shared_ptr<const Domain<D>>      domain,
-	            std::shared_ptr<const GhostFiller<D>> ghost_filler)
-	: domain(domain), ghost_filler(ghost_filler)
+	            std::shared_ptr<const GhostFiller<D>> ghost_filler, int batch_size = 1)
+	: domain(domain), ghost_filler(ghost_filler), batch_size(batch_size)
 	{
+		if (batch_size < 1) {
+			throw RuntimeError("PatchSolver batch size has to be at least 1");
+		}
 	}
 	/**
 	 * @brief Destroy the Patch Solver object
@@ -83,6 +215,28 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 	{
 		return ghost_filler;
 	}
+	/**
+	 * @brief Get the maximum number of patches that are solved together
+	 *
+	 * @return int the batch size
+	 */
+	int getBatchSize() const
+	{
+		return batch_size;
+	}
+	/**
+	 * @brief Check if solveSinglePatch can be called for different patches from several threads
+	 * at the same time
+	 *
+	 * This is false by default. Derived classes that do not modify any shared state in
+	 * solveSinglePatch can override this so that apply and smooth run on all the threads.
+	 *
+	 * @return true if it can
+	 */
+	virtual bool isThreadSafe() const
+	{
+		return false;
+	}
 	/**
 	 * @brief Perform a single solve over a patch
 	 *
@@ -106,16 +260,22 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 		if (domain->hasTimer()) {
 			domain->getTimer()->startDomainTiming(domain->getId(), "Total Patch Solve");
 		}
-		for (std::shared_ptr<const PatchInfo<D>> pinfo : domain->getPatchInfoVector()) {
-			if (domain->hasTimer()) {
-				domain->getTimer()->start("Single Patch Solve");
-			}
-			auto fs = f->getLocalDatas(pinfo->local_index);
-			auto us = u->getLocalDatas(pinfo->local_index);
-			solveSinglePatch(pinfo, fs, us);
-			if (domain->hasTimer()) {
-				domain->getTimer()->stop("Single Patch Solve");
-			}
+		std::vector<std::shared_ptr<const PatchInfo<D>>> pinfos = domain->getPatchInfoVector();
+		if (batch_size > 1) {
+			solveBatches(pinfos, f, u);
+		} else {
+			ParallelPatchLoop(pinfos.size(), canSolveThreaded(f, u), [&](int i) {
+				bool timed = domain->hasTimer() && !InThreadedPatchLoop();
+				if (timed) {
+					domain->getTimer()->start("Single Patch Solve");
+				}
+				auto fs = f->getLocalDatas(pinfos[i]->local_index);
+				auto us = u->getLocalDatas(pinfos[i]->local_index);
+				solveSinglePatch(pinfos[i], fs, us);
+				if (timed) {
+					domain->getTimer()->stop("Single Patch Solve");
+				}
+			});
 		}
 		if (domain->hasTimer()) {
 			domain->getTimer()->stopDomainTiming(domain->getId(), "Total Patch Solve");
@@ -124,6 +284,8 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 	/**
 	 * @brief Solve all the patches in the domain, using the values in u for the boundary conditions
 	 *
+	 * The ghost exchange is overlapped with the solves as in ForEachPatchWithGhosts.
+	 *
 	 * @param f the rhs vector
 	 * @param u the lhs vector
 	 */
@@ -133,19 +295,18 @@ template <int D> class PatchSolver : public virtual Operator<D>, public virtual
 		if (domain->hasTimer()) {
 			domain->getTimer()->startDomainTiming(domain->getId(), "Total Patch Smooth");
 		}
-		ghost_filler->fillGhost(u);
-		for (std::shared_ptr<const PatchInfo<D>> pinfo : domain->getPatchInfoVector()) {
-			if (domain->hasTimer()) {
-				domain->getTimer()->startPatchTiming(pinfo->id, domain->getId(),
-				                                     "Single Patch Solve");
-			}
-			auto fs = f->getLocalDatas(pinfo->local_index);
-			auto us = u->getLocalDatas(pinfo->local_index);
-			solveSinglePatch(pinfo, fs, us);
-			if (domain->hasTimer()) {
-				domain->getTimer()->stopPatchTiming(pinfo->id, domain->getId(),
-				                                    "Single Patch Solve");
-			}
+		if (batch_size > 1) {
+			auto smooth_patches
+			= [&](const std::vector<std::shared_ptr<const PatchInfo<D>>> &pinfos) {
+				  solveBatches(pinfos, f, u);
+			  };
+			ForEachPatchGroupWithGhosts<D, double>(domain, ghost_filler, u, smooth_patches);
+		} else {
+			auto smooth_patch = [&](std::shared_ptr<const PatchInfo<D>> pinfo) {
+				smoothSinglePatch(pinfo, f, u);
+			};
+			ForEachPatchWithGhosts<D, double>(domain, ghost_filler, u, canSolveThreaded(f, u),
+			                                  smooth_patch);
 		}
 		if (domain->hasTimer()) {
 			domain->getTimer()->stopDomainTiming(domain->getId(), "Total Patch Smooth");
@@ -22,15 +22,19 @@
 #ifndef THUNDEREGG_POISSON_DFTPATCHSOLVER_H
 #define THUNDEREGG_POISSON_DFTPATCHSOLVER_H
 #include <ThunderEgg/Domain.h>
+#include <ThunderEgg/PatchLoop.h>
 #include <ThunderEgg/PatchOperator.h>
 #include <ThunderEgg/PatchSolver.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
+#include <algorithm>
 #include <bitset>
 #include <map>
 #include <valarray>
+#include <vector>
 
-extern "C" void dgemv_(char &, int &, int &, double &, double *, int &, double *, int &, double &,
-                       double *, int &);
+extern "C" void dgemm_(char &, char &, int &, int &, int &, double &, double *, int &, double *,
+                       int &, double &, double *, int &);
 
 namespace ThunderEgg
 {
@@ -39,6 +43,10 @@ namespace Poisson
 /**
  * @brief This patch solver uses DFT transforms to solve for the Poisson equation
  *
+ * The transform along each axis is done with dgemm over all the lines of the patch at once. With
+ * a batch size larger than 1, apply and smooth group the patches that have the same boundary
+ * conditions and spacings, and transform up to batch size patches with the same dgemm calls.
+ *
  * @tparam D the number of Cartesian dimensions
  */
 template <int D> class DFTPatchSolver : public PatchSolver<D>
@@ -52,14 +60,7 @@ template <int D> class DFTPatchSolver : public PatchSolver<D>
 	 * @brief Comparator used in the maps, patches with the same spacings and boundary conditions
 	 * will be equal
 	 */
-	struct CompareByBoundaryAndSpacings {
-		bool operator()(const std::shared_ptr<const PatchInfo<D>> &a,
-		                const std::shared_ptr<const PatchInfo<D>> &b) const
-		{
-			return std::forward_as_tuple(a->neumann.to_ulong(), a->spacings[0])
-			       < std::forward_as_tuple(b->neumann.to_ulong(), b->spacings[0]);
-		}
-	};
+	using CompareByBoundaryAndSpacings = typename PatchSolver<D>::CompareByBoundaryAndSpacings;
 	/**
 	 * @brief The patch opertar that we are solving for
 	 */
@@ -77,17 +78,28 @@ template <int D> class DFTPatchSolver : public PatchSolver<D>
 	         std::array<std::shared_ptr<std::valarray<double>>, D>, CompareByBoundaryAndSpacings>
 	plan2;
 	/**
-	 * @brief Temporary copy for the modified right hand side
+	 * @brief Scratch storage for solving a batch of patches
+	 *
+	 * The vectors have no ghost cells, so the patches of each vector are stored contiguously.
 	 */
-	std::shared_ptr<ValVector<D>> f_copy;
+	struct Scratch {
+		/**
+		 * @brief Temporary copies for the modified right hand sides
+		 */
+		std::shared_ptr<ValVector<D>> f_copy;
+		/**
+		 * @brief Temporary work vector
+		 */
+		std::shared_ptr<ValVector<D>> tmp;
+		/**
+		 * @brief Temporary work vector for the transforms along each axis
+		 */
+		std::shared_ptr<ValVector<D>> local_tmp;
+	};
 	/**
-	 * @brief Temporary work vector
+	 * @brief Scratch storage for each thread
 	 */
-	std::shared_ptr<ValVector<D>> tmp;
-	/*
-	 * @brief Temporary work vector
-	 */
-	std::shared_ptr<ValVector<D>> local_tmp;
+	std::vector<Scratch> scratches;
 	/**
 	 * @brief Map of PatchInfo object to it's respective eigenvalue array.
 	 */
@@ -189,57 +201,138 @@ template <int D> class DFTPatchSolver : public PatchSolver<D>
 		return matrix_ptr;
 	}
 	/**
-	 * @brief Execute a given DFT plan
+	 * @brief Execute a given DFT plan on a batch of contiguously stored patches
+	 *
+	 * The transform along an axis is a product with the transform matrix. Along the first axis the
+	 * lines are contiguous, so all of the lines of the batch are transformed with a single dgemm.
+	 * Along the other axes there is one dgemm for each slab of lines.
 	 *
 	 * @param plan the plan (the matrixes for each axis)
 	 * @param in the input values
 	 * @param out the resulting values after the transform
-	 * @param inverse weather we a re calculate
+	 * @param work work space of the same size as the input
+	 * @param num_patches the number of patches in the batch
 	 */
 	void executePlan(const std::array<std::shared_ptr<std::valarray<double>>, D> &plan,
-	                 LocalData<D> in, LocalData<D> out) const
+	                 double *in, double *out, double *work, int num_patches) const
 	{
-		LocalData<D> prev_result = in;
+		double *prev_result = in;
+		int     inner       = 1;
+		int     outer       = this->domain->getNumCellsInPatch() * num_patches;
 
 		for (size_t axis = 0; axis < D; axis++) {
-			int                n     = this->domain->getNs()[axis];
-			std::array<int, D> start = in.getStart();
-			std::array<int, D> end   = in.getEnd();
-			end[axis]                = 0;
+			int n = this->domain->getNs()[axis];
+			outer /= n;
 
-			std::valarray<double> &matrix = *plan[axis];
+			// alternate between out and work so that the last axis ends in out
+			double *new_result = ((D - 1 - axis) % 2) ? work : out;
+			double *matrix     = &(*plan[axis])[0];
 
-			LocalData<D> new_result;
-			if (D % 2) {
-				if (axis % 2) {
-					new_result = in;
-				} else {
-					new_result = out;
-				}
+			char   N    = 'N';
+			char   T    = 'T';
+			double one  = 1;
+			double zero = 0;
+			if (inner == 1) {
+				dgemm_(T, N, n, outer, n, one, matrix, n, prev_result, n, zero, new_result, n);
 			} else {
-				if (axis == D - 1) {
-					new_result = out;
-				} else if (axis == D - 2) {
-					new_result = local_tmp->getLocalData(0, 0);
-				} else if (axis % 2) {
-					new_result = in;
-				} else {
-					new_result = out;
+				int slab_size = inner * n;
+				for (int slab = 0; slab < outer; slab++) {
+					dgemm_(N, N, inner, n, n, one, prev_result + slab * slab_size, inner, matrix, n,
+					       zero, new_result + slab * slab_size, inner);
 				}
 			}
 
-			int pstride = prev_result.getStrides()[axis];
-			int nstride = new_result.getStrides()[axis];
+			prev_result = new_result;
+			inner *= n;
+		}
+	}
+	/**
+	 * @brief Copy the modified right hand side of a patch into the scratch storage
+	 *
+	 * @param scratch the scratch storage
+	 * @param slot the index of the patch in the scratch storage
+	 * @param pinfo the patch
+	 * @param fs the rhs of the patch
+	 * @param us the lhs of the patch
+	 */
+	void gatherRHS(const Scratch &scratch, int slot, std::shared_ptr<const PatchInfo<D>> pinfo,
+	               const std::vector<LocalData<D>> &fs, const std::vector<LocalData<D>> &us) const
+	{
+		LocalData<D> f_copy_ld = scratch.f_copy->getLocalData(0, slot);
+		nested_loop<D>(f_copy_ld.getStart(), f_copy_ld.getEnd(),
+		               [&](std::array<int, D> coord) { f_copy_ld[coord] = fs[0][coord]; });
+
+		std::vector<LocalData<D>> f_copy_lds = {f_copy_ld};
+		op->addGhostToRHS(pinfo, us, f_copy_lds);
+	}
+	/**
+	 * @brief Solve the patches in the scratch storage, the solutions are left in f_copy
+	 *
+	 * @param scratch the scratch storage
+	 * @param pinfo a patch with the boundary conditions and spacings of all the patches
+	 * @param num_patches the number of patches in the scratch storage
+	 */
+	void solveScratch(const Scratch &scratch, std::shared_ptr<const PatchInfo<D>> pinfo,
+	                  int num_patches) const
+	{
+		double *f_copy_data    = scratch.f_copy->getData();
+		double *tmp_data       = scratch.tmp->getData();
+		double *local_tmp_data = scratch.local_tmp->getData();
+		int     patch_size     = this->domain->getNumCellsInPatch();
 
-			char   T    = 'T';
-			double one  = 1;
-			double zero = 0;
-			nested_loop<D>(start, end, [&](std::array<int, D> coord) {
-				dgemv_(T, n, n, one, &matrix[0], n, &prev_result[coord], pstride, zero,
-				       &new_result[coord], nstride);
-			});
+		executePlan(plan1.at(pinfo), f_copy_data, tmp_data, local_tmp_data, num_patches);
 
-			prev_result = new_result;
+		const double *patch_eigs = &eigen_vals.at(pinfo)[0];
+		for (int patch = 0; patch < num_patches; patch++) {
+			double *patch_tmp_data = tmp_data + patch * patch_size;
+			for (int i = 0; i < patch_size; i++) {
+				patch_tmp_data[i] /= patch_eigs[i];
+			}
+			if (pinfo->neumann.all()) {
+				patch_tmp_data[0] = 0;
+			}
+		}
+
+		executePlan(plan2.at(pinfo), tmp_data, f_copy_data, local_tmp_data, num_patches);
+	}
+	/**
+	 * @brief Copy a solution from the scratch storage into the lhs of a patch
+	 *
+	 * @param scratch the scratch storage
+	 * @param slot the index of the patch in the scratch storage
+	 * @param us the lhs of the patch
+	 */
+	void scatterSolution(const Scratch &scratch, int slot, std::vector<LocalData<D>> &us) const
+	{
+		double scale = 1;
+		for (size_t axis = 0; axis < D; axis++) {
+			scale *= 2.0 / this->domain->getNs()[axis];
+		}
+		LocalData<D> sol_ld = scratch.f_copy->getLocalData(0, slot);
+		nested_loop<D>(us[0].getStart(), us[0].getEnd(),
+		               [&](std::array<int, D> coord) { us[0][coord] = sol_ld[coord] * scale; });
+	}
+	/**
+	 * @brief Solve a batch of patches that have the same boundary conditions and spacings
+	 *
+	 * @param batch the patches, at most batch_size of them
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	void solveBatch(const std::vector<std::shared_ptr<const PatchInfo<D>>> &batch,
+	                std::shared_ptr<const Vector<D>> f,
+	                std::shared_ptr<Vector<D>>       u) const override
+	{
+		const Scratch &scratch = this->getThreadScratch(scratches);
+		for (size_t slot = 0; slot < batch.size(); slot++) {
+			auto fs = f->getLocalDatas(batch[slot]->local_index);
+			auto us = u->getLocalDatas(batch[slot]->local_index);
+			gatherRHS(scratch, slot, batch[slot], fs, us);
+		}
+		solveScratch(scratch, batch[0], batch.size());
+		for (size_t slot = 0; slot < batch.size(); slot++) {
+			auto us = u->getLocalDatas(batch[slot]->local_index);
+			scatterSolution(scratch, slot, us);
 		}
 	}
 	/**
@@ -373,50 +466,43 @@ template <int D> class DFTPatchSolver : public PatchSolver<D>
 	 * @brief Construct a new DFTPatchSolver object
 	 *
 	 * @param op_in the Poisson PatchOperator that cooresponds to this DFTPatchSolver
+	 * @param batch_size_in the maximum number of patches to transform at once in apply and smooth,
+	 * 1 transforms one patch at a time
 	 */
-	explicit DFTPatchSolver(std::shared_ptr<const PatchOperator<D>> op_in)
-	: PatchSolver<D>(op_in->getDomain(), op_in->getGhostFiller()), op(op_in)
+	explicit DFTPatchSolver(std::shared_ptr<const PatchOperator<D>> op_in, int batch_size_in = 1)
+	: PatchSolver<D>(op_in->getDomain(), op_in->getGhostFiller(), batch_size_in), op(op_in)
 	{
-		f_copy = std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
-		tmp    = std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
-		if (!(D % 2)) {
-			local_tmp
-			= std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
+		scratches.resize(GetNumPatchLoopThreads());
+		for (Scratch &scratch : scratches) {
+			std::array<int, D> ns = this->domain->getNs();
+			scratch.f_copy = std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, batch_size_in);
+			scratch.tmp    = std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, batch_size_in);
+			scratch.local_tmp
+			= std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, batch_size_in);
 		}
 		// process patches
 		for (auto pinfo : this->domain->getPatchInfoVector()) {
 			addPatch(pinfo);
 		}
 	}
+	/**
+	 * @brief Check if patches can be solved on several threads
+	 *
+	 * @return true if the PatchOperator is thread safe, and there is scratch storage for each of
+	 * the threads
+	 */
+	bool isThreadSafe() const override
+	{
+		return op->isThreadSafe() && GetNumPatchLoopThreads() <= (int) scratches.size();
+	}
 	void solveSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
 	                      const std::vector<LocalData<D>> &   fs,
 	                      std::vector<LocalData<D>> &         us) const override
 	{
-		LocalData<D> f_copy_ld = f_copy->getLocalData(0, 0);
-		LocalData<D> tmp_ld    = tmp->getLocalData(0, 0);
-
-		nested_loop<D>(f_copy_ld.getStart(), f_copy_ld.getEnd(),
-		               [&](std::array<int, D> coord) { f_copy_ld[coord] = fs[0][coord]; });
-
-		std::vector<LocalData<D>> f_copy_lds = {f_copy_ld};
-		op->addGhostToRHS(pinfo, us, f_copy_lds);
-
-		executePlan(plan1.at(pinfo), f_copy_ld, tmp_ld);
-
-		tmp->getValArray() /= eigen_vals.at(pinfo);
-
-		if (pinfo->neumann.all()) {
-			tmp->getValArray()[0] = 0;
-		}
-
-		executePlan(plan2.at(pinfo), tmp_ld, us[0]);
-
-		double scale = 1;
-		for (size_t axis = 0; axis < D; axis++) {
-			scale *= 2.0 / this->domain->getNs()[axis];
-		}
-		nested_loop<D>(us[0].getStart(), us[0].getEnd(),
-		               [&](std::array<int, D> coord) { us[0][coord] *= scale; });
+		const Scratch &scratch = this->getThreadScratch(scratches);
+		gatherRHS(scratch, 0, pinfo, fs, us);
+		solveScratch(scratch, pinfo, 1);
+		scatterSolution(scratch, 0, us);
 	}
 };
 
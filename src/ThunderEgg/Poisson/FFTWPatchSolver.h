@@ -21,12 +21,17 @@
 
 #ifndef THUNDEREGG_POISSON_SCHUR_FFTWPATCHSOLVER_H
 #define THUNDEREGG_POISSON_SCHUR_FFTWPATCHSOLVER_H
+#include <ThunderEgg/PatchLoop.h>
 #include <ThunderEgg/PatchOperator.h>
 #include <ThunderEgg/PatchSolver.h>
+#include <ThunderEgg/Poisson/FFTWWisdom.h>
+#include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
+#include <algorithm>
 #include <bitset>
 #include <fftw3.h>
 #include <map>
+#include <vector>
 namespace ThunderEgg
 {
 namespace Poisson
@@ -34,6 +39,17 @@ namespace Poisson
 /**
  * @brief This patch solver uses FFT transforms to solve for the Poisson equation
  *
+ * The plans are created once on a set of scratch vectors, and each thread of a patch loop runs
+ * them on its own scratch vectors with fftw_execute_r2r, so patches can be solved concurrently.
+ *
+ * With a batch size larger than 1, apply and smooth group the patches that have the same boundary
+ * conditions and spacings, and transform up to batch size patches at once with a single
+ * fftw_plan_many_r2r plan. This cuts down on the per-call overhead of FFTW for small patches.
+ *
+ * Plans are created with FFTW_MEASURE by default. If a wisdom file is given, the wisdom in it is
+ * used for planning, and the wisdom is written back to it once the plans are created, so later
+ * runs with the same patch sizes can skip the measurements.
+ *
  * @tparam D the number of Cartesian dimensions
  */
 template <int D> class FFTWPatchSolver : public PatchSolver<D>
@@ -43,18 +59,48 @@ template <int D> class FFTWPatchSolver : public PatchSolver<D>
 	 * @brief Comparator used in the maps, patches with the same spacings and boundary conditions
 	 * will be equal
 	 */
-	struct CompareByBoundaryAndSpacings {
-		bool operator()(const std::shared_ptr<const PatchInfo<D>> &a,
-		                const std::shared_ptr<const PatchInfo<D>> &b) const
-		{
-			return std::forward_as_tuple(a->neumann.to_ulong(), a->spacings[0])
-			       < std::forward_as_tuple(b->neumann.to_ulong(), b->spacings[0]);
-		}
-	};
+	using CompareByBoundaryAndSpacings = typename PatchSolver<D>::CompareByBoundaryAndSpacings;
 	/**
 	 * @brief The patch opertar that we are solving for
 	 */
 	std::shared_ptr<const PatchOperator<D>> op;
+	/**
+	 * @brief Scratch storage for solving a patch
+	 *
+	 * The vectors have no ghost cells, so the first value of each one is aligned to 64 bytes, and
+	 * the plans can be executed on any of them.
+	 */
+	struct Scratch {
+		/**
+		 * @brief Temporary copy for the modified right hand side
+		 */
+		std::shared_ptr<ValVector<D>> f_copy;
+		/**
+		 * @brief Temporary work vector
+		 */
+		std::shared_ptr<ValVector<D>> tmp;
+		/*
+		 * @brief Temporary work vector for solution
+		 */
+		std::shared_ptr<ValVector<D>> sol;
+		/**
+		 * @brief The modified right hand sides of a batch, with one "patch" for each patch of the
+		 * batch
+		 */
+		std::shared_ptr<ValVector<D>> f_batch;
+		/**
+		 * @brief Temporary work vector for a batch
+		 */
+		std::shared_ptr<ValVector<D>> tmp_batch;
+		/**
+		 * @brief Temporary work vector for the solutions of a batch
+		 */
+		std::shared_ptr<ValVector<D>> sol_batch;
+	};
+	/**
+	 * @brief The FFTW planner flag
+	 */
+	unsigned planner_flag;
 	/**
 	 * @brief Map of patchinfo to DFT plan
 	 */
@@ -64,17 +110,19 @@ template <int D> class FFTWPatchSolver : public PatchSolver<D>
 	 */
 	std::map<std::shared_ptr<const PatchInfo<D>>, fftw_plan, CompareByBoundaryAndSpacings> plan2;
 	/**
-	 * @brief Temporary copy for the modified right hand side
+	 * @brief Map of patchinfo to DFT plan for a batch of patches
 	 */
-	std::shared_ptr<ValVector<D>> f_copy;
+	std::map<std::shared_ptr<const PatchInfo<D>>, fftw_plan, CompareByBoundaryAndSpacings>
+	batch_plan1;
 	/**
-	 * @brief Temporary work vector
+	 * @brief Map of patchinfo to inverse DFT plan for a batch of patches
 	 */
-	std::shared_ptr<ValVector<D>> tmp;
-	/*
-	 * @brief Temporary work vector for solution
+	std::map<std::shared_ptr<const PatchInfo<D>>, fftw_plan, CompareByBoundaryAndSpacings>
+	batch_plan2;
+	/**
+	 * @brief Scratch storage for each thread, the plans are created with the first one
 	 */
-	std::shared_ptr<ValVector<D>> sol;
+	std::vector<Scratch> scratches;
 	/**
 	 * @brief Map of PatchInfo object to it's respective eigenvalue array.
 	 */
@@ -194,28 +242,133 @@ template <int D> class FFTWPatchSolver : public PatchSolver<D>
 		return retval;
 	}
 
+	/**
+	 * @brief Solve a batch of patches that have the same boundary conditions and spacings
+	 *
+	 * @param batch the patches, at most batch_size of them
+	 * @param f the rhs vector
+	 * @param u the lhs vector
+	 */
+	void solveBatch(const std::vector<std::shared_ptr<const PatchInfo<D>>> &batch,
+	                std::shared_ptr<const Vector<D>> f,
+	                std::shared_ptr<Vector<D>>       u) const override
+	{
+		const Scratch &scratch    = this->getThreadScratch(scratches);
+		int            patch_size = this->domain->getNumCellsInPatch();
+		int            num_solves = batch.size();
+
+		for (int b = 0; b < num_solves; b++) {
+			auto         fs        = f->getLocalDatas(batch[b]->local_index);
+			auto         us        = u->getLocalDatas(batch[b]->local_index);
+			LocalData<D> f_copy_ld = scratch.f_batch->getLocalData(0, b);
+			nested_loop<D>(f_copy_ld.getStart(), f_copy_ld.getEnd(),
+			               [&](std::array<int, D> coord) { f_copy_ld[coord] = fs[0][coord]; });
+			std::vector<LocalData<D>> f_copy_lds = {f_copy_ld};
+			op->addGhostToRHS(batch[b], us, f_copy_lds);
+		}
+		// the unused patches of the batch are transformed too, keep them finite
+		std::fill(scratch.f_batch->getData() + num_solves * patch_size,
+		          scratch.f_batch->getData() + this->batch_size * patch_size, 0.0);
+
+		fftw_execute_r2r(batch_plan1.at(batch[0]), scratch.f_batch->getData(),
+		                 scratch.tmp_batch->getData());
+
+		const double *patch_eigs = &eigen_vals.at(batch[0])[0];
+		for (int b = 0; b < num_solves; b++) {
+			double *tmp_data = scratch.tmp_batch->getData() + b * patch_size;
+			for (int i = 0; i < patch_size; i++) {
+				tmp_data[i] /= patch_eigs[i];
+			}
+			if (batch[0]->neumann.all()) {
+				tmp_data[0] = 0;
+			}
+		}
+
+		fftw_execute_r2r(batch_plan2.at(batch[0]), scratch.tmp_batch->getData(),
+		                 scratch.sol_batch->getData());
+
+		double scale = 1;
+		for (size_t axis = 0; axis < D; axis++) {
+			scale *= 2.0 * this->domain->getNs()[axis];
+		}
+		for (int b = 0; b < num_solves; b++) {
+			LocalData<D> u_ld   = u->getLocalData(0, batch[b]->local_index);
+			LocalData<D> sol_ld = scratch.sol_batch->getLocalData(0, b);
+			nested_loop<D>(u_ld.getStart(), u_ld.getEnd(),
+			               [&](std::array<int, D> coord) { u_ld[coord] = sol_ld[coord] / scale; });
+		}
+	}
+
 	public:
 	/**
 	 * @brief Construct a new FftwPatchSolver object
 	 *
+	 * The plans are created with whatever wisdom FFTW has at this point. Use FFTWWisdom::Import
+	 * before constructing the solvers and FFTWWisdom::Export after, to keep the wisdom in a file.
+	 *
 	 * @param op_in the Poisson PatchOperator that cooresponds to this DftPatchSolver
+	 * @param batch_size_in the maximum number of patches to transform at once in apply and smooth,
+	 * 1 transforms one patch at a time
+	 * @param planner_flag_in the FFTW planner flag, one of FFTW_ESTIMATE, FFTW_MEASURE,
+	 * FFTW_PATIENT, or FFTW_EXHAUSTIVE
+	 * @exception RuntimeError if the batch size or planner flag are invalid
 	 */
-	explicit FFTWPatchSolver(std::shared_ptr<const PatchOperator<D>> op_in)
-	: PatchSolver<D>(op_in->getDomain(), op_in->getGhostFiller()), op(op_in)
+	explicit FFTWPatchSolver(std::shared_ptr<const PatchOperator<D>> op_in, int batch_size_in = 1,
+	                         unsigned planner_flag_in = FFTW_MEASURE)
+	: PatchSolver<D>(op_in->getDomain(), op_in->getGhostFiller(), batch_size_in), op(op_in),
+	  planner_flag(planner_flag_in)
 	{
-		f_copy = std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
-		tmp    = std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
-		sol    = std::make_shared<ValVector<D>>(MPI_COMM_SELF, this->domain->getNs(), 0, 1, 1);
+		if (planner_flag != FFTW_ESTIMATE && planner_flag != FFTW_MEASURE
+		    && planner_flag != FFTW_PATIENT && planner_flag != FFTW_EXHAUSTIVE) {
+			throw RuntimeError("FFTWPatchSolver planner flag has to be one of FFTW_ESTIMATE, "
+			                   "FFTW_MEASURE, FFTW_PATIENT, or FFTW_EXHAUSTIVE");
+		}
+		scratches.resize(GetNumPatchLoopThreads());
+		for (Scratch &scratch : scratches) {
+			std::array<int, D> ns = this->domain->getNs();
+			scratch.f_copy        = std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, 1);
+			scratch.tmp           = std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, 1);
+			scratch.sol           = std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, 1);
+			if (this->batch_size > 1) {
+				scratch.f_batch
+				= std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, this->batch_size);
+				scratch.tmp_batch
+				= std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, this->batch_size);
+				scratch.sol_batch
+				= std::make_shared<ValVector<D>>(MPI_COMM_SELF, ns, 0, 1, this->batch_size);
+			}
+		}
 		// process patches
 		for (auto pinfo : this->domain->getPatchInfoVector()) {
 			addPatch(pinfo);
 		}
 	}
+	/**
+	 * @brief Check if patches can be solved on several threads
+	 *
+	 * @return true if the PatchOperator is thread safe, and there is scratch storage for each of
+	 * the threads
+	 */
+	bool isThreadSafe() const override
+	{
+		return op->isThreadSafe() && GetNumPatchLoopThreads() <= (int) scratches.size();
+	}
+	/**
+	 * @brief Get the FFTW planner flag that the plans were created with
+	 *
+	 * @return unsigned the planner flag
+	 */
+	unsigned getPlannerFlag() const
+	{
+		return planner_flag;
+	}
 	void solveSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
 	                      const std::vector<LocalData<D>> &   fs,
 	                      std::vector<LocalData<D>> &         us) const override
 	{
-		LocalData<D> f_copy_ld = f_copy->getLocalData(0, 0);
+		const Scratch &scratch = this->getThreadScratch(scratches);
+
+		LocalData<D> f_copy_ld = scratch.f_copy->getLocalData(0, 0);
 
 		nested_loop<D>(f_copy_ld.getStart(), f_copy_ld.getEnd(),
 		               [&](std::array<int, D> coord) { f_copy_ld[coord] = fs[0][coord]; });
@@ -223,17 +376,21 @@ template <int D> class FFTWPatchSolver : public PatchSolver<D>
 		std::vector<LocalData<D>> f_copy_lds = {f_copy_ld};
 		op->addGhostToRHS(pinfo, us, f_copy_lds);
 
-		fftw_execute(plan1.at(pinfo));
+		fftw_execute_r2r(plan1.at(pinfo), scratch.f_copy->getData(), scratch.tmp->getData());
 
-		tmp->getValArray() /= eigen_vals.at(pinfo);
+		double *                     tmp_data   = scratch.tmp->getData();
+		const std::valarray<double> &patch_eigs = eigen_vals.at(pinfo);
+		for (size_t i = 0; i < patch_eigs.size(); i++) {
+			tmp_data[i] /= patch_eigs[i];
+		}
 
 		if (pinfo->neumann.all()) {
-			tmp->getValArray()[0] = 0;
+			tmp_data[0] = 0;
 		}
 
-		fftw_execute(plan2.at(pinfo));
+		fftw_execute_r2r(plan2.at(pinfo), scratch.tmp->getData(), scratch.sol->getData());
 
-		LocalData<D> sol_ld = sol->getLocalData(0, 0);
+		LocalData<D> sol_ld = scratch.sol->getLocalData(0, 0);
 
 		double scale = 1;
 		for (size_t axis = 0; axis < D; axis++) {
@@ -260,12 +417,27 @@ template <int D> class FFTWPatchSolver : public PatchSolver<D>
 			std::array<fftw_r2r_kind, D> transforms     = getTransformsForPatch(pinfo);
 			std::array<fftw_r2r_kind, D> transforms_inv = getInverseTransformsForPatch(pinfo);
 
-			plan1[pinfo] = fftw_plan_r2r(D, ns_reversed.data(), &f_copy->getValArray()[0],
-			                             &tmp->getValArray()[0], transforms.data(),
-			                             FFTW_MEASURE | FFTW_DESTROY_INPUT);
-			plan2[pinfo]
-			= fftw_plan_r2r(D, ns_reversed.data(), &tmp->getValArray()[0], &sol->getValArray()[0],
-			                transforms_inv.data(), FFTW_MEASURE | FFTW_DESTROY_INPUT);
+			const Scratch &scratch = scratches[0];
+
+			plan1[pinfo] = fftw_plan_r2r(D, ns_reversed.data(), scratch.f_copy->getData(),
+			                             scratch.tmp->getData(), transforms.data(),
+			                             planner_flag | FFTW_DESTROY_INPUT);
+			plan2[pinfo] = fftw_plan_r2r(D, ns_reversed.data(), scratch.tmp->getData(),
+			                             scratch.sol->getData(), transforms_inv.data(),
+			                             planner_flag | FFTW_DESTROY_INPUT);
+
+			if (this->batch_size > 1) {
+				int patch_size = this->domain->getNumCellsInPatch();
+
+				batch_plan1[pinfo] = fftw_plan_many_r2r(
+				D, ns_reversed.data(), this->batch_size, scratch.f_batch->getData(), nullptr, 1,
+				patch_size, scratch.tmp_batch->getData(), nullptr, 1, patch_size, transforms.data(),
+				planner_flag | FFTW_DESTROY_INPUT);
+				batch_plan2[pinfo] = fftw_plan_many_r2r(
+				D, ns_reversed.data(), this->batch_size, scratch.tmp_batch->getData(), nullptr, 1,
+				patch_size, scratch.sol_batch->getData(), nullptr, 1, patch_size,
+				transforms_inv.data(), planner_flag | FFTW_DESTROY_INPUT);
+			}
 
 			eigen_vals[pinfo] = getEigenValues(pinfo);
 		}
@@ -0,0 +1,108 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include <ThunderEgg/Poisson/FFTWWisdom.h>
+#include <ThunderEgg/RuntimeError.h>
+#include <cstring>
+#include <fftw3.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace ThunderEgg
+{
+namespace Poisson
+{
+bool FFTWWisdom::Import(const std::string &filename, MPI_Comm comm)
+{
+	int rank;
+	MPI_Comm_rank(comm, &rank);
+
+	// size of -1 means there is no file
+	std::string wisdom;
+	int         size = -1;
+	if (rank == 0) {
+		std::ifstream in(filename);
+		if (!in.fail()) {
+			std::stringstream buffer;
+			buffer << in.rdbuf();
+			wisdom = buffer.str();
+			size   = (int) wisdom.size();
+		}
+	}
+	MPI_Bcast(&size, 1, MPI_INT, 0, comm);
+	// an empty file, such as one that was just created, holds no wisdom
+	if (size <= 0) {
+		return false;
+	}
+	wisdom.resize(size);
+	MPI_Bcast(&wisdom[0], size, MPI_CHAR, 0, comm);
+
+	if (!fftw_import_wisdom_from_string(wisdom.c_str())) {
+		throw RuntimeError("Failed to import FFTW wisdom from " + filename);
+	}
+	return true;
+}
+void FFTWWisdom::Export(const std::string &filename, MPI_Comm comm)
+{
+	int rank;
+	MPI_Comm_rank(comm, &rank);
+	int num_ranks;
+	MPI_Comm_size(comm, &num_ranks);
+
+	// gather the wisdom of every rank, so plans that were only made on other ranks are saved too
+	char *wisdom_c_str = fftw_export_wisdom_to_string();
+	int   size         = wisdom_c_str == nullptr ? 0 : (int) std::strlen(wisdom_c_str);
+
+	std::vector<int> sizes(num_ranks);
+	MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+	std::vector<int> offsets(num_ranks);
+	int              total_size = 0;
+	for (int r = 0; r < num_ranks; r++) {
+		offsets[r] = total_size;
+		total_size += sizes[r];
+	}
+	std::vector<char> all_wisdom(total_size);
+	MPI_Gatherv(wisdom_c_str, size, MPI_CHAR, all_wisdom.data(), sizes.data(), offsets.data(),
+	            MPI_CHAR, 0, comm);
+	if (wisdom_c_str != nullptr) {
+		fftw_free(wisdom_c_str);
+	}
+
+	int success = 1;
+	if (rank == 0) {
+		for (int r = 1; r < num_ranks; r++) {
+			std::string wisdom(all_wisdom.data() + offsets[r], sizes[r]);
+			if (!wisdom.empty() && !fftw_import_wisdom_from_string(wisdom.c_str())) {
+				success = 0;
+			}
+		}
+		if (success && !fftw_export_wisdom_to_filename(filename.c_str())) {
+			success = 0;
+		}
+	}
+	MPI_Bcast(&success, 1, MPI_INT, 0, comm);
+	if (!success) {
+		throw RuntimeError("Failed to export FFTW wisdom to " + filename);
+	}
+}
+} // namespace Poisson
+} // namespace ThunderEgg
@@ -0,0 +1,69 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_POISSON_FFTWWISDOM_H
+#define THUNDEREGG_POISSON_FFTWWISDOM_H
+#include <mpi.h>
+#include <string>
+
+namespace ThunderEgg
+{
+namespace Poisson
+{
+/**
+ * @brief Reads and writes FFTW wisdom files
+ *
+ * Wisdom holds the results of earlier FFTW_MEASURE and FFTW_PATIENT planning, so plans for the
+ * same transforms can be created without measuring them again. Only rank 0 touches the file.
+ *
+ * Import the wisdom before creating the FFTWPatchSolver objects, and export it once after all of
+ * them have been created.
+ */
+class FFTWWisdom
+{
+	public:
+	/**
+	 * @brief Import wisdom from a file. This is collective over the communicator.
+	 *
+	 * Rank 0 reads the file and broadcasts its contents to the other ranks.
+	 *
+	 * @param filename the file to read
+	 * @param comm the communicator
+	 * @return true if wisdom was imported, false if the file does not exist or is empty
+	 * @exception RuntimeError if the file does not contain valid wisdom
+	 */
+	static bool Import(const std::string &filename, MPI_Comm comm);
+	/**
+	 * @brief Export the wisdom of all the ranks to a file. This is collective over the
+	 * communicator.
+	 *
+	 * The wisdom of every rank is gathered on rank 0 and merged there before rank 0 writes the
+	 * file.
+	 *
+	 * @param filename the file to write
+	 * @param comm the communicator
+	 * @exception RuntimeError on all ranks if the file cannot be written
+	 */
+	static void Export(const std::string &filename, MPI_Comm comm);
+};
+} // namespace Poisson
+} // namespace ThunderEgg
+#endif
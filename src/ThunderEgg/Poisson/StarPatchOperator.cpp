@@ -23,3 +23,5 @@
 
 template class ThunderEgg::Poisson::StarPatchOperator<2>;
 template class ThunderEgg::Poisson::StarPatchOperator<3>;
+template class ThunderEgg::Poisson::StarPatchOperator<2, float>;
+template class ThunderEgg::Poisson::StarPatchOperator<3, float>;
@@ -19,12 +19,13 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  ***************************************************************************/
 
-#ifndef THUNDEREGG_VARPOISSON_STARPATCHOPERATOR_H
-#define THUNDEREGG_VARPOISSON_STARPATCHOPERATOR_H
+#ifndef THUNDEREGG_POISSON_STARPATCHOPERATOR_H
+#define THUNDEREGG_POISSON_STARPATCHOPERATOR_H
 
 #include <ThunderEgg/DomainTools.h>
 #include <ThunderEgg/GMG/Level.h>
 #include <ThunderEgg/GhostFiller.h>
+#include <ThunderEgg/PatchKernelRegistry.h>
 #include <ThunderEgg/PatchOperator.h>
 #include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
@@ -39,8 +40,9 @@ namespace Poisson
  * Supports both Dirichlet and Neumann boundary conditions
  *
  * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the vector values
  */
-template <int D> class StarPatchOperator : public PatchOperator<D>
+template <int D, typename T = double> class StarPatchOperator : public PatchOperator<D, T>
 {
 	private:
 	constexpr int addValue(int axis) const
@@ -48,6 +50,165 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 		return (axis == 0) ? 0 : 1;
 	}
 	bool neumann;
+	/**
+	 * @brief Set the ghost cells on a side of the patch from the adjacent interior cells
+	 *
+	 * @param ghosts the ghost cells
+	 * @param mid the interior cells next to the ghost cells
+	 * @param sign 1 to copy the values (Neumann), -1 to negate them (Dirichlet)
+	 */
+	static void setBoundaryGhosts(LocalData<D - 1, T> &ghosts, const LocalData<D - 1, T> &mid,
+	                              double sign)
+	{
+		int n            = mid.getLengths()[0];
+		int ghost_stride = ghosts.getStrides()[0];
+		int mid_stride   = mid.getStrides()[0];
+		mid.forEachLine([&](const std::array<int, D - 1> &coord, const T *mid_line) {
+			T *ghost_line = ghosts.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				ghost_line[i * ghost_stride] = sign * mid_line[i * mid_stride];
+			}
+		});
+	}
+	/**
+	 * @brief Set the ghost cells on the physical boundaries of the patch
+	 *
+	 * @param pinfo the patch
+	 * @param u the patch data
+	 * @param treat_interior_boundary_as_dirichlet also set the ghost cells on interior sides
+	 */
+	void setPatchBoundaryGhosts(std::shared_ptr<const PatchInfo<D>> pinfo, const LocalData<D, T> &u,
+	                            bool treat_interior_boundary_as_dirichlet) const
+	{
+		for (Side<D> s : Side<D>::getValues()) {
+			LocalData<D - 1, T>       ghosts = u.getGhostSliceOnSide(s, 1);
+			const LocalData<D - 1, T> mid    = u.getSliceOnSide(s);
+			if (!pinfo->hasNbr(s) && neumann) {
+				setBoundaryGhosts(ghosts, mid, 1);
+			} else if (!pinfo->hasNbr(s) || treat_interior_boundary_as_dirichlet) {
+				setBoundaryGhosts(ghosts, mid, -1);
+			}
+		}
+	}
+
+	/**
+	 * @brief Evaluate the stencil at a cell
+	 *
+	 * @param u pointer to the cell
+	 * @param strides the strides of the patch data
+	 * @param h2 the squared cell spacings
+	 * @return double the value of the operator at the cell
+	 */
+	static double applyStencil(const T *u, const std::array<int, D> &strides,
+	                           const std::array<double, D> &h2)
+	{
+		double sum = 0;
+		for (int axis = 0; axis < D; axis++) {
+			double lower = u[-strides[axis]];
+			double upper = u[strides[axis]];
+			sum += (upper - 2 * u[0] + lower) / h2[axis];
+		}
+		return sum;
+	}
+	/**
+	 * @brief Kernels for a fixed patch size
+	 */
+	struct FixedSizeKernels {
+		/**
+		 * @brief computes f = A u on a patch
+		 */
+		void (*apply)(const LocalData<D, T> &u, LocalData<D, T> &f, const std::array<double, D> &h2)
+		= nullptr;
+		/**
+		 * @brief computes r = f - A u on a patch
+		 */
+		void (*residual)(const LocalData<D, T> &f, const LocalData<D, T> &u, LocalData<D, T> &r,
+		                 const std::array<double, D> &h2)
+		= nullptr;
+	};
+	/**
+	 * @brief The kernels for the patch size of the domain, nullptr if there are none
+	 */
+	FixedSizeKernels fixed_kernels;
+	/**
+	 * @brief Evaluate the stencil at a cell, with unit stride along the first axis
+	 */
+	static double applyStencilUnitStride(const T *u, const std::array<int, D> &strides,
+	                                     const std::array<double, D> &h2)
+	{
+		double sum = 0;
+		sum += (u[1] - 2 * u[0] + u[-1]) / h2[0];
+		for (int axis = 1; axis < D; axis++) {
+			sum += (u[strides[axis]] - 2 * u[0] + u[-strides[axis]]) / h2[axis];
+		}
+		return sum;
+	}
+	/**
+	 * @brief Compute f = A u on a patch with N cells along each axis
+	 *
+	 * The first axis has to have unit stride in u and f.
+	 */
+	template <int N>
+	static void ApplyFixedSize(const LocalData<D, T> &u, LocalData<D, T> &f,
+	                           const std::array<double, D> &h2)
+	{
+		std::array<int, D> strides = u.getStrides();
+		f.forEachLine([&](const std::array<int, D> &coord, T *f_line) {
+			const T *u_line = u.getPtr(coord);
+			for (int i = 0; i < N; i++) {
+				f_line[i] = applyStencilUnitStride(u_line + i, strides, h2);
+			}
+		});
+	}
+	/**
+	 * @brief Compute r = f - A u on a patch with N cells along each axis
+	 *
+	 * The first axis has to have unit stride in f, u, and r.
+	 */
+	template <int N>
+	static void ResidualFixedSize(const LocalData<D, T> &f, const LocalData<D, T> &u,
+	                              LocalData<D, T> &r, const std::array<double, D> &h2)
+	{
+		std::array<int, D> strides = u.getStrides();
+		r.forEachLine([&](const std::array<int, D> &coord, T *r_line) {
+			const T *f_line = f.getPtr(coord);
+			const T *u_line = u.getPtr(coord);
+			for (int i = 0; i < N; i++) {
+				r_line[i] = f_line[i] - applyStencilUnitStride(u_line + i, strides, h2);
+			}
+		});
+	}
+	/**
+	 * @brief Get the kernels for patches with N cells along each axis
+	 */
+	template <int N> static FixedSizeKernels GetFixedSizeKernels()
+	{
+		FixedSizeKernels kernels;
+		kernels.apply    = &ApplyFixedSize<N>;
+		kernels.residual = &ResidualFixedSize<N>;
+		return kernels;
+	}
+	/**
+	 * @brief Get the registry of fixed size kernels, with 8, 16, and 32 cells registered
+	 */
+	static PatchKernelRegistry<D, FixedSizeKernels> &GetKernelRegistry()
+	{
+		static PatchKernelRegistry<D, FixedSizeKernels> registry = []() {
+			PatchKernelRegistry<D, FixedSizeKernels> defaults;
+			defaults.add(8, GetFixedSizeKernels<8>());
+			defaults.add(16, GetFixedSizeKernels<16>());
+			defaults.add(32, GetFixedSizeKernels<32>());
+			return defaults;
+		}();
+		return registry;
+	}
+	/**
+	 * @brief Check if the fixed size kernels can be used on the data
+	 */
+	static bool HasUnitStride(const LocalData<D, T> &ld)
+	{
+		return ld.getStrides()[0] == 1;
+	}
 
 	public:
 	/**
@@ -57,69 +218,183 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 	 * @param ghost_filler_in the GhostFiller to use before calling applySinglePatch
 	 * @param neumann_in whether or not to use Neumann boundary conditions
 	 */
-	StarPatchOperator(std::shared_ptr<const Domain<D>>      domain_in,
-	                  std::shared_ptr<const GhostFiller<D>> ghost_filler_in,
-	                  bool                                  neumann_in = false)
-	: PatchOperator<D>(domain_in, ghost_filler_in), neumann(neumann_in)
+	StarPatchOperator(std::shared_ptr<const Domain<D>>         domain_in,
+	                  std::shared_ptr<const GhostFiller<D, T>> ghost_filler_in,
+	                  bool                                     neumann_in = false)
+	: PatchOperator<D, T>(domain_in, ghost_filler_in), neumann(neumann_in)
 	{
 		if (this->domain->getNumGhostCells() < 1) {
 			throw RuntimeError("StarPatchOperator needs at least one set of ghost cells");
 		}
+		fixed_kernels = GetKernelRegistry().find(this->domain->getNs());
+	}
+	/**
+	 * @brief Register kernels for patches with N cells along each axis
+	 *
+	 * Operators that are constructed afterwards on a Domain with this patch size will use loops
+	 * with a fixed trip count. This is not thread safe.
+	 *
+	 * @tparam N the number of cells along each axis
+	 */
+	template <int N> static void RegisterPatchSize()
+	{
+		GetKernelRegistry().add(N, GetFixedSizeKernels<N>());
+	}
+	/**
+	 * @brief Check if this operator has kernels specialized for the patch size of the Domain
+	 *
+	 * @return true if it does
+	 */
+	bool usesFixedSizeKernels() const
+	{
+		return fixed_kernels.apply != nullptr;
+	}
+	/**
+	 * @brief The single patch functions only write to the patch that they are called for
+	 *
+	 * @return true
+	 */
+	bool isThreadSafe() const override
+	{
+		return true;
 	}
 	void applySinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                      const std::vector<LocalData<D>> &us, std::vector<LocalData<D>> &fs,
+	                      const std::vector<LocalData<D, T>> &us, std::vector<LocalData<D, T>> &fs,
 	                      bool treat_interior_boundary_as_dirichlet) const override
 	{
 		std::array<double, D> h2 = pinfo->spacings;
 		for (size_t i = 0; i < D; i++) {
 			h2[i] *= h2[i];
 		}
+		setPatchBoundaryGhosts(pinfo, us[0], treat_interior_boundary_as_dirichlet);
 
+		if (usesFixedSizeKernels() && HasUnitStride(us[0]) && HasUnitStride(fs[0])) {
+			fixed_kernels.apply(us[0], fs[0], h2);
+			return;
+		}
 		loop<0, D - 1>([&](int axis) {
-			Side<D>                lower_side = Side<D>::LowerSideOnAxis(axis);
-			Side<D>                upper_side = Side<D>::HigherSideOnAxis(axis);
-			LocalData<D - 1>       lower      = us[0].getGhostSliceOnSide(lower_side, 1);
-			const LocalData<D - 1> lower_mid  = us[0].getSliceOnSide(lower_side);
-			if (!pinfo->hasNbr(lower_side) && neumann) {
-				nested_loop<D - 1>(
-				lower_mid.getStart(), lower_mid.getEnd(),
-				[&](std::array<int, D - 1> coord) { lower[coord] = lower_mid[coord]; });
-			} else if (!pinfo->hasNbr(lower_side) || treat_interior_boundary_as_dirichlet) {
-				nested_loop<D - 1>(
-				lower_mid.getStart(), lower_mid.getEnd(),
-				[&](std::array<int, D - 1> coord) { lower[coord] = -lower_mid[coord]; });
+			int n        = us[0].getLengths()[0];
+			int u_stride = us[0].getStrides()[0];
+			int f_stride = fs[0].getStrides()[0];
+			int stride   = us[0].getStrides()[axis];
+			int add      = addValue(axis);
+			us[0].forEachLine([&](const std::array<int, D> &coord, const T *u) {
+				T *f = fs[0].getPtr(coord);
+				for (int i = 0; i < n; i++) {
+					double lower    = u[i * u_stride - stride];
+					double mid      = u[i * u_stride];
+					double upper    = u[i * u_stride + stride];
+					f[i * f_stride] = add * f[i * f_stride] + (upper - 2 * mid + lower) / h2[axis];
+				}
+			});
+		});
+	}
+	/**
+	 * @brief Compute the residual r = f - A u on a single patch in one pass
+	 *
+	 * The axis contributions are summed in the same order as applySinglePatch, so the result
+	 * matches applying the operator and then subtracting from f.
+	 */
+	void residualSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                         const std::vector<LocalData<D, T>> &fs,
+	                         const std::vector<LocalData<D, T>> &us,
+	                         std::vector<LocalData<D, T>> &      rs) const override
+	{
+		std::array<double, D> h2 = pinfo->spacings;
+		for (size_t i = 0; i < D; i++) {
+			h2[i] *= h2[i];
+		}
+
+		setPatchBoundaryGhosts(pinfo, us[0], false);
+
+		if (usesFixedSizeKernels() && HasUnitStride(fs[0]) && HasUnitStride(us[0])
+		    && HasUnitStride(rs[0])) {
+			fixed_kernels.residual(fs[0], us[0], rs[0], h2);
+			return;
+		}
+		int                n        = us[0].getLengths()[0];
+		int                u_stride = us[0].getStrides()[0];
+		int                f_stride = fs[0].getStrides()[0];
+		int                r_stride = rs[0].getStrides()[0];
+		std::array<int, D> strides  = us[0].getStrides();
+		us[0].forEachLine([&](const std::array<int, D> &coord, const T *u) {
+			const T *f = fs[0].getPtr(coord);
+			T *      r = rs[0].getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				r[i * r_stride] = f[i * f_stride] - applyStencil(u + i * u_stride, strides, h2);
 			}
-			LocalData<D - 1>       upper     = us[0].getGhostSliceOnSide(upper_side, 1);
-			const LocalData<D - 1> upper_mid = us[0].getSliceOnSide(upper_side);
-			if (!pinfo->hasNbr(upper_side) && neumann) {
-				nested_loop<D - 1>(
-				upper_mid.getStart(), upper_mid.getEnd(),
-				[&](std::array<int, D - 1> coord) { upper[coord] = upper_mid[coord]; });
-			} else if (!pinfo->hasNbr(upper_side) || treat_interior_boundary_as_dirichlet) {
-				nested_loop<D - 1>(
-				upper_mid.getStart(), upper_mid.getEnd(),
-				[&](std::array<int, D - 1> coord) { upper[coord] = -upper_mid[coord]; });
+		});
+	}
+	void getDiagonalSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                            std::vector<LocalData<D, T>> &      ds) const override
+	{
+		double center = 0;
+		for (int axis = 0; axis < D; axis++) {
+			center -= 2 / (pinfo->spacings[axis] * pinfo->spacings[axis]);
+		}
+		int n        = ds[0].getLengths()[0];
+		int d_stride = ds[0].getStrides()[0];
+		ds[0].forEachLine([&](const std::array<int, D> &coord, T *d) {
+			for (int i = 0; i < n; i++) {
+				d[i * d_stride] = center;
+			}
+		});
+		// the boundary ghost cells are a multiple of the adjacent cell
+		double sign = neumann ? 1 : -1;
+		for (Side<D> s : Side<D>::getValues()) {
+			if (!pinfo->hasNbr(s)) {
+				double              h2    = pow(pinfo->spacings[s.getAxisIndex()], 2);
+				LocalData<D - 1, T> inner = ds[0].getSliceOnSide(s);
+				nested_loop<D - 1>(inner.getStart(), inner.getEnd(),
+				                   [&](const std::array<int, D - 1> &coord) {
+					                   inner[coord] += sign / h2;
+				                   });
+			}
+		}
+	}
+	void relaxSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                      const std::vector<LocalData<D, T>> &fs,
+	                      const std::vector<LocalData<D, T>> &us,
+	                      const std::vector<LocalData<D, T>> &ds, int color,
+	                      double weight) const override
+	{
+		std::array<double, D> h2 = pinfo->spacings;
+		for (size_t i = 0; i < D; i++) {
+			h2[i] *= h2[i];
+		}
+
+		setPatchBoundaryGhosts(pinfo, us[0], false);
+
+		LocalData<D, T>    u        = us[0];
+		int                n        = u.getLengths()[0];
+		int                u_stride = u.getStrides()[0];
+		int                f_stride = fs[0].getStrides()[0];
+		int                d_stride = ds[0].getStrides()[0];
+		std::array<int, D> strides  = u.getStrides();
+		u.forEachLine([&](const std::array<int, D> &coord, T *u_line) {
+			const T *f     = fs[0].getPtr(coord);
+			const T *d     = ds[0].getPtr(coord);
+			int      first = color;
+			for (int axis = 0; axis < D; axis++) {
+				first += coord[axis];
+			}
+			for (int i = first % 2; i < n; i += 2) {
+				T *    ptr   = u_line + i * u_stride;
+				double resid = f[i * f_stride] - applyStencil(ptr, strides, h2);
+				ptr[0] += weight * resid / d[i * d_stride];
 			}
-			int stride = us[0].getStrides()[axis];
-			nested_loop<D>(us[0].getStart(), us[0].getEnd(), [&](std::array<int, D> coord) {
-				const double *ptr   = us[0].getPtr(coord);
-				double        lower = *(ptr - stride);
-				double        mid   = *ptr;
-				double        upper = *(ptr + stride);
-				fs[0][coord] = addValue(axis) * fs[0][coord] + (upper - 2 * mid + lower) / h2[axis];
-			});
 		});
 	}
 	void addGhostToRHS(std::shared_ptr<const PatchInfo<D>> pinfo,
-	                   const std::vector<LocalData<D>> &   us,
-	                   std::vector<LocalData<D>> &         fs) const override
+	                   const std::vector<LocalData<D, T>> &us,
+	                   std::vector<LocalData<D, T>> &      fs) const override
 	{
 		for (Side<D> s : Side<D>::getValues()) {
 			if (pinfo->hasNbr(s)) {
 				double                 h2      = pow(pinfo->spacings[s.getAxisIndex()], 2);
-				LocalData<D - 1>       f_inner = fs[0].getSliceOnSide(s);
-				LocalData<D - 1>       u_ghost = us[0].getSliceOnSide(s, -1);
-				const LocalData<D - 1> u_inner = us[0].getSliceOnSide(s);
+				LocalData<D - 1, T>       f_inner = fs[0].getSliceOnSide(s);
+				LocalData<D - 1, T>       u_ghost = us[0].getSliceOnSide(s, -1);
+				const LocalData<D - 1, T> u_inner = us[0].getSliceOnSide(s);
 				nested_loop<D - 1>(f_inner.getStart(), f_inner.getEnd(),
 				                   [&](const std::array<int, D - 1> &coord) {
 					                   f_inner[coord] -= (u_ghost[coord] + u_inner[coord]) / h2;
@@ -134,16 +409,16 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 	 * @param f the right hand side vector
 	 * @param gfunc the exact solution
 	 */
-	void addDrichletBCToRHS(std::shared_ptr<Vector<D>>                           f,
+	void addDrichletBCToRHS(std::shared_ptr<Vector<D, T>>                        f,
 	                        std::function<double(const std::array<double, D> &)> gfunc)
 	{
 		for (int i = 0; i < f->getNumLocalPatches(); i++) {
-			LocalData<D> f_ld  = f->getLocalData(0, i);
-			auto         pinfo = this->domain->getPatchInfoVector()[i];
+			LocalData<D, T> f_ld  = f->getLocalData(0, i);
+			auto            pinfo = this->domain->getPatchInfoVector()[i];
 			for (Side<D> s : Side<D>::getValues()) {
 				if (!pinfo->hasNbr(s)) {
-					double           h2 = pow(pinfo->spacings[s.getAxisIndex()], 2);
-					LocalData<D - 1> ld = f_ld.getSliceOnSide(s);
+					double              h2 = pow(pinfo->spacings[s.getAxisIndex()], 2);
+					LocalData<D - 1, T> ld = f_ld.getSliceOnSide(s);
 					nested_loop<D - 1>(
 					ld.getStart(), ld.getEnd(), [&](const std::array<int, D - 1> &coord) {
 						std::array<double, D> real_coord;
@@ -162,16 +437,16 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 	 * @param gfunc_grad the gradient of gfunc
 	 */
 	void addNeumannBCToRHS(
-	std::shared_ptr<Vector<D>> f, std::function<double(const std::array<double, D> &)> gfunc,
+	std::shared_ptr<Vector<D, T>> f, std::function<double(const std::array<double, D> &)> gfunc,
 	std::array<std::function<double(const std::array<double, D> &)>, D> gfunc_grad)
 	{
 		for (int i = 0; i < f->getNumLocalPatches(); i++) {
-			LocalData<D> f_ld  = f->getLocalData(0, i);
-			auto         pinfo = this->domain->getPatchInfoVector()[i];
+			LocalData<D, T> f_ld  = f->getLocalData(0, i);
+			auto            pinfo = this->domain->getPatchInfoVector()[i];
 			for (Side<D> s : Side<D>::getValues()) {
 				if (!pinfo->hasNbr(s)) {
-					double           h  = pinfo->spacings[s.getAxisIndex()];
-					LocalData<D - 1> ld = f_ld.getSliceOnSide(s);
+					double              h  = pinfo->spacings[s.getAxisIndex()];
+					LocalData<D - 1, T> ld = f_ld.getSliceOnSide(s);
 					if (s.isLowerOnAxis()) {
 						nested_loop<D - 1>(
 						ld.getStart(), ld.getEnd(), [&](const std::array<int, D - 1> &coord) {
@@ -194,6 +469,8 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 };
 extern template class StarPatchOperator<2>;
 extern template class StarPatchOperator<3>;
+extern template class StarPatchOperator<2, float>;
+extern template class StarPatchOperator<3, float>;
 
 } // namespace Poisson
 } // namespace ThunderEgg
@@ -0,0 +1,126 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_REDUCTIONREQUEST_H
+#define THUNDEREGG_REDUCTIONREQUEST_H
+#include <ThunderEgg/RuntimeError.h>
+#include <algorithm>
+#include <mpi.h>
+#include <string>
+namespace ThunderEgg
+{
+/**
+ * @brief A handle for a non-blocking MPI_Allreduce of a few double values
+ *
+ * The local values are copied into storage inside this object, so the reduction can be overlapped
+ * with other work without allocating. The destructor will wait on the reduction if it has not
+ * already been waited on.
+ */
+class ReductionRequest
+{
+	public:
+	/**
+	 * @brief the maximum number of values that can be reduced
+	 */
+	static constexpr int max_values = 4;
+
+	private:
+	/**
+	 * @brief the number of values that are being reduced
+	 */
+	int num_values;
+	/**
+	 * @brief the local values that are being reduced
+	 */
+	double local_values[max_values];
+	/**
+	 * @brief the reduced values
+	 */
+	double global_values[max_values];
+	/**
+	 * @brief the MPI request for the reduction
+	 */
+	MPI_Request request = MPI_REQUEST_NULL;
+
+	public:
+	/**
+	 * @brief Construct a new ReductionRequest object and start the reduction
+	 *
+	 * @param values the local values to reduce
+	 * @param num_values the number of values, at most max_values
+	 * @param op the MPI operation to reduce with
+	 * @param comm the MPI_Comm to reduce over
+	 */
+	ReductionRequest(const double *values, int num_values, MPI_Op op, MPI_Comm comm)
+	: num_values(num_values)
+	{
+		if (num_values > max_values) {
+			throw RuntimeError("ReductionRequest can reduce at most " + std::to_string(max_values)
+			                   + " values, " + std::to_string(num_values) + " were given");
+		}
+		std::copy(values, values + num_values, local_values);
+		MPI_Iallreduce(local_values, global_values, num_values, MPI_DOUBLE, op, comm, &request);
+	}
+	ReductionRequest(const ReductionRequest &) = delete;
+	ReductionRequest &operator=(const ReductionRequest &) = delete;
+	/**
+	 * @brief Move constructor
+	 *
+	 * MPI writes the result into the buffers of the original object, so this waits on the
+	 * reduction before copying the result. Returning a request by value is normally elided, so
+	 * this is rarely called.
+	 */
+	ReductionRequest(ReductionRequest &&other) : num_values(other.num_values)
+	{
+		other.wait();
+		std::copy(other.global_values, other.global_values + num_values, global_values);
+	}
+	/**
+	 * @brief Destroy the ReductionRequest object, waiting on the reduction if necessary
+	 */
+	~ReductionRequest()
+	{
+		wait();
+	}
+	/**
+	 * @brief Get the number of values that are being reduced
+	 *
+	 * @return int the number of values
+	 */
+	int getNumValues() const
+	{
+		return num_values;
+	}
+	/**
+	 * @brief Wait for the reduction to finish
+	 *
+	 * @return const double* the reduced values
+	 */
+	const double *wait()
+	{
+		if (request != MPI_REQUEST_NULL) {
+			MPI_Wait(&request, MPI_STATUS_IGNORE);
+		}
+		return global_values;
+	}
+};
+} // namespace ThunderEgg
+#endif
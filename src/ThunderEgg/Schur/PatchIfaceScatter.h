@@ -21,6 +21,7 @@
 
 #ifndef THUNDEREGG_SCHUR_PATCHIFACESCATTER_H
 #define THUNDEREGG_SCHUR_PATCHIFACESCATTER_H
+#include <ThunderEgg/GhostExchangeBackend.h>
 #include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/Schur/InterfaceDomain.h>
 #include <ThunderEgg/ValVector.h>
@@ -34,6 +35,10 @@ namespace Schur
  * The scatters functions are split with a Start and Finish, this allows for local computation to
  * occur while the communicating
  *
+ * Interfaces are exchanged with point-to-point messages by default. With the NeighborCollective
+ * backend, each scatter is a single neighborhood alltoallv on a distributed graph communicator of
+ * the ranks that interfaces are exchanged with.
+ *
  * @tparam D the number of cartesian dimensions on a patch
  */
 template <int D> class PatchIfaceScatter
@@ -80,9 +85,17 @@ template <int D> class PatchIfaceScatter
 	 */
 	std::vector<std::vector<int>> send_local_indexes;
 	/**
-	 * @brief MPI Send buffers
+	 * @brief number of values sent to each rank
+	 */
+	std::vector<int> send_counts;
+	/**
+	 * @brief offset of the values for each rank in the send buffer
 	 */
-	std::vector<std::vector<double>> send_buffers;
+	std::vector<int> send_displs;
+	/**
+	 * @brief MPI Send buffer
+	 */
+	std::vector<double> send_buffer;
 	/**
 	 * @brief number of MPI recvs
 	 */
@@ -100,9 +113,30 @@ template <int D> class PatchIfaceScatter
 	 */
 	std::vector<std::vector<int>> recv_local_indexes;
 	/**
-	 * @brief MPI recv buffers
+	 * @brief number of values recieved from each rank
+	 */
+	std::vector<int> recv_counts;
+	/**
+	 * @brief offset of the values for each rank in the recv buffer
+	 */
+	std::vector<int> recv_displs;
+	/**
+	 * @brief MPI recv buffer
+	 */
+	std::vector<double> recv_buffer;
+	/**
+	 * @brief the backend used to exchange interfaces with other ranks
+	 */
+	GhostExchangeBackend backend;
+	/**
+	 * @brief distributed graph communicator from the recv ranks to the send ranks, only created for
+	 * the NeighborCollective backend
 	 */
-	std::vector<std::vector<double>> recv_buffers;
+	MPI_Comm nbr_comm = MPI_COMM_NULL;
+	/**
+	 * @brief the request for the neighborhood alltoallv
+	 */
+	MPI_Request collective_request = MPI_REQUEST_NULL;
 
 	/**
 	 * @brief Set the incoming buffer maps (incoming_rank_to_local_indexes) and set
@@ -140,7 +174,6 @@ template <int D> class PatchIfaceScatter
 		recv_ranks.resize(num_recvs);
 		recv_requests.resize(num_recvs);
 		recv_local_indexes.resize(num_recvs);
-		recv_buffers.resize(num_recvs);
 
 		int recv_index = 0;
 		for (const auto &rank_to_id_local_index_pairs : incoming_ranks_to_id_local_index_pairs) {
@@ -181,7 +214,6 @@ template <int D> class PatchIfaceScatter
 		send_ranks.resize(num_sends);
 		send_requests.resize(num_sends);
 		send_local_indexes.resize(num_sends);
-		send_buffers.resize(num_sends);
 
 		int send_index = 0;
 		for (const auto &rank_to_id_local_index_pairs : outgoing_ranks_to_id_local_index_pairs) {
@@ -197,39 +229,64 @@ template <int D> class PatchIfaceScatter
 		}
 	}
 	/**
-	 * @brief Initialize the mpi buffers
+	 * @brief Set the number of values exchanged with each rank, and where they are in the buffers
 	 */
-	void initializeMPIBuffers()
+	void setCountsAndDispls()
 	{
+		send_counts.resize(num_sends);
+		send_displs.resize(num_sends);
+		int send_offset = 0;
 		for (int send_index = 0; send_index < num_sends; send_index++) {
-			send_buffers[send_index].resize(send_local_indexes[send_index].size() * iface_stride);
+			send_counts[send_index] = send_local_indexes[send_index].size() * iface_stride;
+			send_displs[send_index] = send_offset;
+			send_offset += send_counts[send_index];
 		}
 
+		recv_counts.resize(num_recvs);
+		recv_displs.resize(num_recvs);
+		int recv_offset = 0;
 		for (int recv_index = 0; recv_index < num_recvs; recv_index++) {
-			recv_buffers[recv_index].resize(recv_local_indexes[recv_index].size() * iface_stride);
+			recv_counts[recv_index] = recv_local_indexes[recv_index].size() * iface_stride;
+			recv_displs[recv_index] = recv_offset;
+			recv_offset += recv_counts[recv_index];
 		}
 	}
 	/**
-	 * @brief Destroy the mpi buffers
+	 * @brief Initialize the mpi buffers
 	 */
-	void destroyMPIBuffers()
+	void initializeMPIBuffers()
 	{
-		for (int send_index = 0; send_index < num_sends; send_index++) {
-			send_buffers[send_index] = std::vector<double>();
+		if (num_sends > 0) {
+			send_buffer.resize(send_displs.back() + send_counts.back());
 		}
-		for (int recv_index = 0; recv_index < num_recvs; recv_index++) {
-			recv_buffers[recv_index] = std::vector<double>();
+		if (num_recvs > 0) {
+			recv_buffer.resize(recv_displs.back() + recv_counts.back());
 		}
 	}
+	/**
+	 * @brief Destroy the mpi buffers
+	 */
+	void destroyMPIBuffers()
+	{
+		send_buffer = std::vector<double>();
+		recv_buffer = std::vector<double>();
+	}
 
 	public:
 	/**
 	 * @brief Construct a new PatchIfaceScatter object
 	 *
 	 * @param iface_domain the InterfaceDomain
+	 * @param backend the backend used to exchange interfaces with other ranks. Every rank has to
+	 * use the same backend. The SharedMemory backend is not supported.
 	 */
-	explicit PatchIfaceScatter(std::shared_ptr<const InterfaceDomain<D>> iface_domain)
+	explicit PatchIfaceScatter(std::shared_ptr<const InterfaceDomain<D>> iface_domain,
+	                           GhostExchangeBackend backend = GhostExchangeBackend::PointToPoint)
+	: backend(backend)
 	{
+		if (backend == GhostExchangeBackend::SharedMemory) {
+			throw RuntimeError("PatchIfaceScatter does not support the SharedMemory backend");
+		}
 		std::array<int, D> ns = iface_domain->getDomain()->getNs();
 		for (int i = 1; i < D; i++) {
 			if (ns[0] != ns[i]) {
@@ -242,6 +299,12 @@ template <int D> class PatchIfaceScatter
 		iface_stride = std::pow(ns[0], D - 1);
 		setIncomingBufferMapsAndDetermineLocalVectorSize(iface_domain);
 		setOutgoingBufferMaps(iface_domain);
+		setCountsAndDispls();
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD, num_recvs, recv_ranks.data(),
+			                               MPI_UNWEIGHTED, num_sends, send_ranks.data(),
+			                               MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &nbr_comm);
+		}
 	}
 	PatchIfaceScatter(const PatchIfaceScatter &) = delete;
 	PatchIfaceScatter &operator=(const PatchIfaceScatter &) = delete;
@@ -252,11 +315,32 @@ template <int D> class PatchIfaceScatter
 	 */
 	~PatchIfaceScatter()
 	{
+		int finalized;
+		MPI_Finalized(&finalized);
+		if (finalized) {
+			return;
+		}
 		if (communicating) {
-			MPI_Waitall(num_recvs, recv_requests.data(), MPI_STATUSES_IGNORE);
-			MPI_Waitall(num_sends, send_requests.data(), MPI_STATUSES_IGNORE);
+			if (backend == GhostExchangeBackend::NeighborCollective) {
+				MPI_Wait(&collective_request, MPI_STATUS_IGNORE);
+			} else {
+				MPI_Waitall(num_recvs, recv_requests.data(), MPI_STATUSES_IGNORE);
+				MPI_Waitall(num_sends, send_requests.data(), MPI_STATUSES_IGNORE);
+			}
+		}
+		if (nbr_comm != MPI_COMM_NULL) {
+			MPI_Comm_free(&nbr_comm);
 		}
 	}
+	/**
+	 * @brief Get the backend used to exchange interfaces with other ranks
+	 *
+	 * @return GhostExchangeBackend the backend
+	 */
+	GhostExchangeBackend getExchangeBackend() const
+	{
+		return backend;
+	}
 	/**
 	 * @brief Get a nw local patch iface vector
 	 *
@@ -296,26 +380,36 @@ template <int D> class PatchIfaceScatter
 
 		initializeMPIBuffers();
 
-		for (int recv_index = 0; recv_index < num_recvs; recv_index++) {
-			MPI_Irecv(recv_buffers[recv_index].data(), recv_buffers[recv_index].size(), MPI_DOUBLE,
-			          recv_ranks[recv_index], 0, MPI_COMM_WORLD, &recv_requests[recv_index]);
+		if (backend == GhostExchangeBackend::PointToPoint) {
+			for (int recv_index = 0; recv_index < num_recvs; recv_index++) {
+				MPI_Irecv(recv_buffer.data() + recv_displs[recv_index], recv_counts[recv_index],
+				          MPI_DOUBLE, recv_ranks[recv_index], 0, MPI_COMM_WORLD,
+				          &recv_requests[recv_index]);
+			}
 		}
 
 		for (int send_index = 0; send_index < num_sends; send_index++) {
-			std::vector<double> &buffer = send_buffers[send_index];
-
-			int buffer_index = 0;
+			int buffer_index = send_displs[send_index];
 			for (int local_index : send_local_indexes[send_index]) {
 				auto local_data = global_vector->getLocalData(0, local_index);
 				nested_loop<D - 1>(local_data.getStart(), local_data.getEnd(),
 				                   [&](const std::array<int, D - 1> &coord) {
-					                   buffer[buffer_index] = local_data[coord];
+					                   send_buffer[buffer_index] = local_data[coord];
 					                   buffer_index++;
 				                   });
 			}
 
-			MPI_Isend(buffer.data(), buffer.size(), MPI_DOUBLE, send_ranks[send_index], 0,
-			          MPI_COMM_WORLD, &send_requests[send_index]);
+			if (backend == GhostExchangeBackend::PointToPoint) {
+				MPI_Isend(send_buffer.data() + send_displs[send_index], send_counts[send_index],
+				          MPI_DOUBLE, send_ranks[send_index], 0, MPI_COMM_WORLD,
+				          &send_requests[send_index]);
+			}
+		}
+
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Ineighbor_alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(),
+			                        MPI_DOUBLE, recv_buffer.data(), recv_counts.data(),
+			                        recv_displs.data(), MPI_DOUBLE, nbr_comm, &collective_request);
 		}
 
 		for (int local_iface = 0; local_iface < global_vector->getNumLocalPatches();
@@ -349,25 +443,30 @@ template <int D> class PatchIfaceScatter
 			"Different vectors were passed ot scatterFinish than were passed to scatterStart");
 		}
 
-		for (int i = 0; i < num_recvs; i++) {
-			MPI_Status status;
-			int        recv_index;
-			MPI_Waitany(num_recvs, recv_requests.data(), &recv_index, &status);
+		if (backend == GhostExchangeBackend::NeighborCollective) {
+			MPI_Wait(&collective_request, MPI_STATUS_IGNORE);
+		}
 
-			std::vector<double> &buffer = recv_buffers[recv_index];
+		for (int i = 0; i < num_recvs; i++) {
+			int recv_index = i;
+			if (backend == GhostExchangeBackend::PointToPoint) {
+				MPI_Waitany(num_recvs, recv_requests.data(), &recv_index, MPI_STATUS_IGNORE);
+			}
 
-			int buffer_index = 0;
+			int buffer_index = recv_displs[recv_index];
 			for (int local_index : recv_local_indexes[recv_index]) {
 				auto local_data = local_patch_iface_vector->getLocalData(0, local_index);
 				nested_loop<D - 1>(local_data.getStart(), local_data.getEnd(),
 				                   [&](const std::array<int, D - 1> &coord) {
-					                   local_data[coord] = buffer[buffer_index];
+					                   local_data[coord] = recv_buffer[buffer_index];
 					                   buffer_index++;
 				                   });
 			}
 		}
 
-		MPI_Waitall(num_sends, send_requests.data(), MPI_STATUSES_IGNORE);
+		if (backend == GhostExchangeBackend::PointToPoint) {
+			MPI_Waitall(num_sends, send_requests.data(), MPI_STATUSES_IGNORE);
+		}
 
 		curr_global_vector = nullptr;
 		curr_local_vector  = nullptr;
@@ -22,6 +22,7 @@
 #ifndef THUNDEREGG_SCHUR_PATCHSOLVERWRAPPER_H
 #define THUNDEREGG_SCHUR_PATCHSOLVERWRAPPER_H
 
+#include <ThunderEgg/PatchLoop.h>
 #include <ThunderEgg/PatchSolver.h>
 #include <ThunderEgg/Schur/PatchIfaceScatter.h>
 #include <ThunderEgg/ValVectorGenerator.h>
@@ -93,6 +94,8 @@ template <int D> class PatchSolverWrapper : public Operator<D - 1>
 	/**
 	 * @brief Apply Schur matrix
 	 *
+	 * The patches are solved on several threads if the PatchSolver is thread safe.
+	 *
 	 * @param x the input vector.
 	 * @param b the output vector.
 	 */
@@ -125,11 +128,13 @@ template <int D> class PatchSolverWrapper : public Operator<D - 1>
 			}
 		}
 		// go ahead and solve for patches with only local interfaces
-		for (auto piinfo : patches_with_only_local_ifaces) {
-			auto us = u->getLocalDatas(piinfo->pinfo->local_index);
-			auto fs = f->getLocalDatas(piinfo->pinfo->local_index);
+		bool threaded = solver->isThreadSafe();
+		ParallelPatchLoop(patches_with_only_local_ifaces.size(), threaded, [&](int i) {
+			auto piinfo = patches_with_only_local_ifaces[i];
+			auto us     = u->getLocalDatas(piinfo->pinfo->local_index);
+			auto fs     = f->getLocalDatas(piinfo->pinfo->local_index);
 			solver->solveSinglePatch(piinfo->pinfo, fs, us);
-		}
+		});
 
 		scatter.scatterFinish(x, local_x);
 
@@ -149,11 +154,12 @@ template <int D> class PatchSolverWrapper : public Operator<D - 1>
 			}
 		}
 		// solve the remaining patches
-		for (auto piinfo : patches_with_ifaces_on_neighbor_rank) {
-			auto us = u->getLocalDatas(piinfo->pinfo->local_index);
-			auto fs = f->getLocalDatas(piinfo->pinfo->local_index);
+		ParallelPatchLoop(patches_with_ifaces_on_neighbor_rank.size(), threaded, [&](int i) {
+			auto piinfo = patches_with_ifaces_on_neighbor_rank[i];
+			auto us     = u->getLocalDatas(piinfo->pinfo->local_index);
+			auto fs     = f->getLocalDatas(piinfo->pinfo->local_index);
 			solver->solveSinglePatch(piinfo->pinfo, fs, us);
-		}
+		});
 
 		solver->getGhostFiller()->fillGhost(u);
 
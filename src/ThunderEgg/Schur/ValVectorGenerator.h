@@ -24,6 +24,7 @@
 #include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/Schur/InterfaceDomain.h>
 #include <ThunderEgg/ValVector.h>
+#include <ThunderEgg/ValVectorPool.h>
 #include <ThunderEgg/VectorGenerator.h>
 namespace ThunderEgg
 {
@@ -32,6 +33,9 @@ namespace Schur
 /**
  * @brief Generates new ValVector objects for a given InterfaceDomain
  *
+ * Vectors are recycled through a ValVectorPool, so a vector that is released is reused by a
+ * later call to getNewVector.
+ *
  * @tparam D the number of Cartesian dimensions
  */
 template <int D> class ValVectorGenerator : public VectorGenerator<D>
@@ -45,6 +49,10 @@ template <int D> class ValVectorGenerator : public VectorGenerator<D>
 	 * @brief The InterfaceDomain
 	 */
 	std::shared_ptr<InterfaceDomain<D + 1>> iface_domain;
+	/**
+	 * @brief The pool that vectors are drawn from
+	 */
+	std::shared_ptr<ValVectorPool<D>> pool;
 
 	public:
 	/**
@@ -64,11 +72,19 @@ template <int D> class ValVectorGenerator : public VectorGenerator<D>
 		}
 
 		iface_ns.fill(ns[0]);
+		pool = std::make_shared<ValVectorPool<D>>(MPI_COMM_WORLD, iface_ns, 0, 1,
+		                                          iface_domain->getNumLocalInterfaces());
 	}
 	std::shared_ptr<Vector<D>> getNewVector() const override
 	{
-		return std::make_shared<ValVector<D>>(MPI_COMM_WORLD, iface_ns, 0, 1,
-		                                      iface_domain->getNumLocalInterfaces());
+		return pool->getVector();
+	}
+	/**
+	 * @brief Get the pool that vectors are drawn from
+	 */
+	std::shared_ptr<ValVectorPool<D>> getPool() const
+	{
+		return pool;
 	}
 };
 } // namespace Schur
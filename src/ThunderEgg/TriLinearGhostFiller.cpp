@@ -45,57 +45,81 @@ static std::array<int, 2> getOffset(const std::array<int, 3> ns, Side<3> s, Orth
 	}
 	return offset;
 }
-void TriLinearGhostFiller::fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<3>> pinfo,
-                                                     const std::vector<LocalData<3>> &local_datas,
-                                                     const std::vector<LocalData<3>> &nbr_datas,
-                                                     const Side<3> side, const NbrType nbr_type,
-                                                     const Orthant<3> orthant) const
+/**
+ * @brief Get the lengths of the slice on a side of the patch
+ */
+static std::array<int, 2> getSliceLengths(const std::array<int, 3> ns, Side<3> s)
+{
+	std::array<int, 2> lengths;
+	for (size_t i = 0; i < s.getAxisIndex(); i++) {
+		lengths[i] = ns[i];
+	}
+	for (size_t i = s.getAxisIndex() + 1; i < 3; i++) {
+		lengths[i - 1] = ns[i];
+	}
+	return lengths;
+}
+template <typename T>
+void BasicTriLinearGhostFiller<T>::fillGhostCellsForNbrPatch(
+std::shared_ptr<const PatchInfo<3>> pinfo, const std::vector<LocalData<3, T>> &local_datas,
+const std::vector<LocalData<3, T>> &nbr_datas, const Side<3> side, const NbrType nbr_type,
+const Orthant<3> orthant) const
 {
 	if (nbr_type == NbrType::Normal) {
 		for (size_t c = 0; c < local_datas.size(); c++) {
-			auto local_slice = local_datas[c].getSliceOnSide(side);
-			auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-			nested_loop<2>(
-			nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-			[&](const std::array<int, 2> &coord) { nbr_ghosts[coord] = local_slice[coord]; });
+			auto local_slice  = local_datas[c].getSliceOnSide(side);
+			auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+			int  n            = nbr_ghosts.getLengths()[0];
+			int  ghost_stride = nbr_ghosts.getStrides()[0];
+			int  local_stride = local_slice.getStrides()[0];
+			nbr_ghosts.forEachLine([&](const std::array<int, 2> &coord, T *ghosts) {
+				const T *local = local_slice.getPtr(coord);
+				for (int i = 0; i < n; i++) {
+					ghosts[i * ghost_stride] = local[i * local_stride];
+				}
+			});
 		}
 	} else if (nbr_type == NbrType::Coarse) {
-		auto               nbr_info = pinfo->getCoarseNbrInfo(side);
 		std::array<int, 2> offset
 		= getOffset(pinfo->ns, side, orthant.collapseOnAxis(side.getAxisIndex()));
 		for (size_t c = 0; c < local_datas.size(); c++) {
-			auto local_slice = local_datas[c].getSliceOnSide(side);
-			auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-			nested_loop<2>(nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-			               [&](const std::array<int, 2> &coord) {
-				               std::array<int, 2> coarse_coord;
-				               for (int i = 0; i < 2; i++) {
-					               coarse_coord[i] = (coord[i] + offset[i]) / 2;
-				               }
-				               nbr_ghosts[coarse_coord] += 1.0 / 3.0 * local_slice[coord];
-			               });
+			auto local_slice  = local_datas[c].getSliceOnSide(side);
+			auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+			int  n            = nbr_ghosts.getLengths()[0];
+			int  ghost_stride = nbr_ghosts.getStrides()[0];
+			int  local_stride = local_slice.getStrides()[0];
+			nbr_ghosts.forEachLine([&](const std::array<int, 2> &coord, T *) {
+				const T *local  = local_slice.getPtr(coord);
+				T *      coarse = nbr_ghosts.getPtr({coord[0], (coord[1] + offset[1]) / 2});
+				for (int i = 0; i < n; i++) {
+					coarse[(i + offset[0]) / 2 * ghost_stride]
+					+= 1.0 / 3.0 * local[i * local_stride];
+				}
+			});
 		}
 	} else if (nbr_type == NbrType::Fine) {
-		auto               nbr_info = pinfo->getFineNbrInfo(side);
 		std::array<int, 2> offset
 		= getOffset(pinfo->ns, side, orthant.collapseOnAxis(side.getAxisIndex()));
 		for (size_t c = 0; c < local_datas.size(); c++) {
-			auto local_slice = local_datas[c].getSliceOnSide(side);
-			auto nbr_ghosts  = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
-			nested_loop<2>(nbr_ghosts.getStart(), nbr_ghosts.getEnd(),
-			               [&](const std::array<int, 2> &coord) {
-				               std::array<int, 2> coarse_coord;
-				               for (int i = 0; i < 2; i++) {
-					               coarse_coord[i] = (coord[i] + offset[i]) / 2;
-				               }
-				               nbr_ghosts[coord] += 4.0 / 6.0 * local_slice[coarse_coord];
-			               });
+			auto local_slice  = local_datas[c].getSliceOnSide(side);
+			auto nbr_ghosts   = nbr_datas[c].getGhostSliceOnSide(side.opposite(), 1);
+			int  n            = nbr_ghosts.getLengths()[0];
+			int  ghost_stride = nbr_ghosts.getStrides()[0];
+			int  local_stride = local_slice.getStrides()[0];
+			nbr_ghosts.forEachLine([&](const std::array<int, 2> &coord, T *ghosts) {
+				const T *coarse = local_slice.getPtr({coord[0], (coord[1] + offset[1]) / 2});
+				for (int i = 0; i < n; i++) {
+					ghosts[i * ghost_stride]
+					+= 4.0 / 6.0 * coarse[(i + offset[0]) / 2 * local_stride];
+				}
+			});
 		}
 	}
 }
 
-void TriLinearGhostFiller::fillGhostCellsForLocalPatch(
-std::shared_ptr<const PatchInfo<3>> pinfo, const std::vector<LocalData<3>> &local_datas) const
+template <typename T>
+void BasicTriLinearGhostFiller<T>::fillGhostCellsForLocalPatch(
+std::shared_ptr<const PatchInfo<3>> pinfo, const std::vector<LocalData<3, T>> &local_datas) const
 {
 	for (auto &local_data : local_datas) {
 		for (Side<3> side : Side<3>::getValues()) {
@@ -106,36 +130,121 @@ std::shared_ptr<const PatchInfo<3>> pinfo, const std::vector<LocalData<3>> &loca
 					auto               local_ghosts = local_data.getGhostSliceOnSide(side, 1);
 					auto               nbr_info     = pinfo->getCoarseNbrInfo(side);
 					std::array<int, 2> offset = getOffset(pinfo->ns, side, nbr_info.orth_on_coarse);
-					nested_loop<2>(
-					local_ghosts.getStart(), local_ghosts.getEnd(),
-					[&](const std::array<int, 2> &coord) {
-						std::array<int, 2> offset_coord;
-						for (int i = 0; i < 2; i++) {
-							if ((coord[i] + offset[i]) % 2 == 0) {
-								offset_coord[i] = coord[i] + 1;
+					int                n            = local_ghosts.getLengths()[0];
+					int                ghost_stride = local_ghosts.getStrides()[0];
+					int                local_stride = local_slice.getStrides()[0];
+					local_ghosts.forEachLine([&](const std::array<int, 2> &coord, T *ghosts) {
+						int offset_j;
+						if ((coord[1] + offset[1]) % 2 == 0) {
+							offset_j = coord[1] + 1;
+						} else {
+							offset_j = coord[1] - 1;
+						}
+						const T *local        = local_slice.getPtr(coord);
+						const T *local_offset = local_slice.getPtr({coord[0], offset_j});
+						for (int i = 0; i < n; i++) {
+							int offset_i;
+							if ((i + offset[0]) % 2 == 0) {
+								offset_i = i + 1;
 							} else {
-								offset_coord[i] = coord[i] - 1;
+								offset_i = i - 1;
 							}
+							T &ghost = ghosts[i * ghost_stride];
+							ghost += 5.0 / 6.0 * local[i * local_stride];
+							ghost -= 1.0 / 6.0 * local[offset_i * local_stride];
+							ghost -= 1.0 / 6.0 * local_offset[i * local_stride];
+							ghost -= 1.0 / 6.0 * local_offset[offset_i * local_stride];
 						}
-						local_ghosts[coord] += 5.0 / 6.0 * local_slice[coord];
-						local_ghosts[coord] -= 1.0 / 6.0 * local_slice[{offset_coord[0], coord[1]}];
-						local_ghosts[coord] -= 1.0 / 6.0 * local_slice[{coord[0], offset_coord[1]}];
-						local_ghosts[coord] -= 1.0 / 6.0 * local_slice[offset_coord];
 					});
 				} else if (nbr_type == NbrType::Fine) {
 					auto local_slice  = local_data.getSliceOnSide(side);
 					auto local_ghosts = local_data.getGhostSliceOnSide(side, 1);
-					nested_loop<2>(local_ghosts.getStart(), local_ghosts.getEnd(),
-					               [&](const std::array<int, 2> &coord) {
-						               local_ghosts[coord] -= 1.0 / 3.0 * local_slice[coord];
-					               });
+					int  n            = local_ghosts.getLengths()[0];
+					int  ghost_stride = local_ghosts.getStrides()[0];
+					int  local_stride = local_slice.getStrides()[0];
+					local_ghosts.forEachLine([&](const std::array<int, 2> &coord, T *ghosts) {
+						const T *local = local_slice.getPtr(coord);
+						for (int i = 0; i < n; i++) {
+							ghosts[i * ghost_stride] -= 1.0 / 3.0 * local[i * local_stride];
+						}
+					});
+				}
+			}
+		}
+	}
+}
+template <typename T>
+bool BasicTriLinearGhostFiller<T>::getNbrPatchStencil(std::shared_ptr<const PatchInfo<3>> pinfo,
+                                                      const Side<3> side, const NbrType nbr_type,
+                                                      const Orthant<3>               orthant,
+                                                      std::vector<GhostFillTerm<3>> &terms) const
+{
+	std::array<int, 2> lengths = getSliceLengths(pinfo->ns, side);
+	std::array<int, 2> offset
+	= getOffset(pinfo->ns, side, orthant.collapseOnAxis(side.getAxisIndex()));
+	auto local = [&](int i, int j) {
+		return GhostFillTerm<3>::CoordOnSide(pinfo->ns, side, 0, {i, j});
+	};
+	auto ghost = [&](int i, int j) {
+		return GhostFillTerm<3>::CoordOnSide(pinfo->ns, side.opposite(), -1, {i, j});
+	};
+	for (int j = 0; j < lengths[1]; j++) {
+		for (int i = 0; i < lengths[0]; i++) {
+			if (nbr_type == NbrType::Normal) {
+				terms.push_back({local(i, j), ghost(i, j), 1});
+			} else if (nbr_type == NbrType::Coarse) {
+				terms.push_back(
+				{local(i, j), ghost((i + offset[0]) / 2, (j + offset[1]) / 2), 1.0 / 3.0});
+			} else if (nbr_type == NbrType::Fine) {
+				terms.push_back(
+				{local((i + offset[0]) / 2, (j + offset[1]) / 2), ghost(i, j), 4.0 / 6.0});
+			}
+		}
+	}
+	return true;
+}
+template <typename T>
+bool BasicTriLinearGhostFiller<T>::getLocalPatchStencil(
+std::shared_ptr<const PatchInfo<3>> pinfo, std::vector<GhostFillTerm<3>> &terms) const
+{
+	for (Side<3> side : Side<3>::getValues()) {
+		if (pinfo->hasNbr(side)) {
+			auto local = [&](int i, int j) {
+				return GhostFillTerm<3>::CoordOnSide(pinfo->ns, side, 0, {i, j});
+			};
+			auto ghost = [&](int i, int j) {
+				return GhostFillTerm<3>::CoordOnSide(pinfo->ns, side, -1, {i, j});
+			};
+			NbrType            nbr_type = pinfo->getNbrType(side);
+			std::array<int, 2> lengths  = getSliceLengths(pinfo->ns, side);
+			if (nbr_type == NbrType::Coarse) {
+				auto               nbr_info = pinfo->getCoarseNbrInfo(side);
+				std::array<int, 2> offset   = getOffset(pinfo->ns, side, nbr_info.orth_on_coarse);
+				for (int j = 0; j < lengths[1]; j++) {
+					int offset_j = (j + offset[1]) % 2 == 0 ? j + 1 : j - 1;
+					for (int i = 0; i < lengths[0]; i++) {
+						int offset_i = (i + offset[0]) % 2 == 0 ? i + 1 : i - 1;
+						terms.push_back({local(i, j), ghost(i, j), 5.0 / 6.0});
+						terms.push_back({local(offset_i, j), ghost(i, j), -1.0 / 6.0});
+						terms.push_back({local(i, offset_j), ghost(i, j), -1.0 / 6.0});
+						terms.push_back({local(offset_i, offset_j), ghost(i, j), -1.0 / 6.0});
+					}
+				}
+			} else if (nbr_type == NbrType::Fine) {
+				for (int j = 0; j < lengths[1]; j++) {
+					for (int i = 0; i < lengths[0]; i++) {
+						terms.push_back({local(i, j), ghost(i, j), -1.0 / 3.0});
+					}
 				}
 			}
 		}
 	}
+	return true;
 }
-TriLinearGhostFiller::TriLinearGhostFiller(std::shared_ptr<const Domain<3>> domain)
-: MPIGhostFiller<3>(domain, 1)
+template <typename T>
+BasicTriLinearGhostFiller<T>::BasicTriLinearGhostFiller(
+std::shared_ptr<const Domain<3>> domain, GhostExchangeBackend backend, bool fill_diagonal_ghosts)
+: MPIGhostFiller<3, T>(domain, 1, backend, fill_diagonal_ghosts)
 {
 	for (int n : domain->getNs()) {
 		if (n % 2 != 0) {
@@ -144,4 +253,7 @@ TriLinearGhostFiller::TriLinearGhostFiller(std::shared_ptr<const Domain<3>> doma
 	}
 }
 
-} // namespace ThunderEgg
\ No newline at end of file
+} // namespace ThunderEgg
+// explicit instantiation
+template class ThunderEgg::BasicTriLinearGhostFiller<double>;
+template class ThunderEgg::BasicTriLinearGhostFiller<float>;
@@ -30,25 +30,48 @@ namespace ThunderEgg
  *
  * It only uses the coarse cell, and the four cooresponding fine cells to interpolate on the
  * coarse-fine boundary.
+ *
+ * @tparam T the scalar type of the vector values
  */
-class TriLinearGhostFiller : public MPIGhostFiller<3>
+template <typename T> class BasicTriLinearGhostFiller : public MPIGhostFiller<3, T>
 {
 	public:
 	void fillGhostCellsForNbrPatch(std::shared_ptr<const PatchInfo<3>> pinfo,
-	                               const std::vector<LocalData<3>> &   local_datas,
-	                               const std::vector<LocalData<3>> &nbr_datas, const Side<3> side,
-	                               const NbrType nbr_type, const Orthant<3> orthant) const override;
+	                               const std::vector<LocalData<3, T>> &local_datas,
+	                               const std::vector<LocalData<3, T>> &nbr_datas,
+	                               const Side<3> side, const NbrType nbr_type,
+	                               const Orthant<3> orthant) const override;
+
+	void
+	fillGhostCellsForLocalPatch(std::shared_ptr<const PatchInfo<3>> pinfo,
+	                            const std::vector<LocalData<3, T>> &local_datas) const override;
+
+	bool getNbrPatchStencil(std::shared_ptr<const PatchInfo<3>> pinfo, const Side<3> side,
+	                        const NbrType nbr_type, const Orthant<3> orthant,
+	                        std::vector<GhostFillTerm<3>> &terms) const override;
 
-	void fillGhostCellsForLocalPatch(std::shared_ptr<const PatchInfo<3>> pinfo,
-	                                 const std::vector<LocalData<3>> &local_datas) const override;
+	bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<3>> pinfo,
+	                          std::vector<GhostFillTerm<3>> &     terms) const override;
 	/**
-	 * @brief Construct a new TriLinearGhostFiller object
+	 * @brief Construct a new BasicTriLinearGhostFiller object
 	 *
 	 * Currently, this only supports an even number of cells on each axis of the patch
 	 *
 	 * @param domain the domain on which ghosts will be filled
+	 * @param backend the backend used to exchange ghost values with other ranks
+	 * @param fill_diagonal_ghosts also fill the edge and corner ghost cells
 	 */
-	explicit TriLinearGhostFiller(std::shared_ptr<const Domain<3>> domain);
+	explicit BasicTriLinearGhostFiller(
+	std::shared_ptr<const Domain<3>> domain,
+	GhostExchangeBackend             backend              = GhostExchangeBackend::PointToPoint,
+	bool                             fill_diagonal_ghosts = false);
 };
+/**
+ * @brief BasicTriLinearGhostFiller for double vectors
+ */
+using TriLinearGhostFiller = BasicTriLinearGhostFiller<double>;
 } // namespace ThunderEgg
+// explicit instantiation
+extern template class ThunderEgg::BasicTriLinearGhostFiller<double>;
+extern template class ThunderEgg::BasicTriLinearGhostFiller<float>;
 #endif
@@ -21,16 +21,52 @@
 
 #ifndef THUNDEREGG_VALVECTOR_H
 #define THUNDEREGG_VALVECTOR_H
+#include <ThunderEgg/PatchLoop.h>
 #include <ThunderEgg/Vector.h>
-#include <valarray>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
 namespace ThunderEgg
 {
 /**
- * @brief Vector class the uses std::valarray for data storage
+ * @brief Options for how a ValVector lays out and initializes its storage
+ */
+struct ValVectorStorage {
+	/**
+	 * @brief Pad the rows of each patch so that every line of non-ghost cells starts on a 64-byte
+	 * (cache line) boundary
+	 */
+	bool padded = false;
+	/**
+	 * @brief Zero the storage patch by patch, in the same order that patches are processed,
+	 * instead of all at once when it is allocated
+	 *
+	 * On NUMA systems, this lets the pages of each patch be placed by the first-touch policy
+	 * on the memory nearest to whoever processes that patch.
+	 */
+	bool first_touch = false;
+	/**
+	 * @brief Store the components of each cell next to each other (array of structures), instead
+	 * of storing each component in a separate block
+	 *
+	 * The LocalData for a component then has a stride of the number of components along the first
+	 * axis. Code that goes through all the components of a cell at once touches a single cache line
+	 * instead of one per component.
+	 */
+	bool interleaved = false;
+};
+/**
+ * @brief Vector class that uses a single contiguous buffer for data storage
+ *
+ * The first non-ghost cell is always aligned to a 64-byte boundary. With
+ * ValVectorStorage::padded, every line of non-ghost cells is aligned. With
+ * ValVectorStorage::interleaved, the components of each cell are stored together.
  *
  * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the values
  */
-template <int D> class ValVector : public Vector<D>
+template <int D, typename T = double> class ValVector : public Vector<D, T>
 
 {
 	private:
@@ -59,9 +95,35 @@ template <int D> class ValVector : public Vector<D>
 	 */
 	int first_offset;
 	/**
-	 * @brief the underlying vector
+	 * @brief true if the components of each cell are stored next to each other
+	 */
+	bool interleaved;
+	/**
+	 * @brief the number of consecutive non-ghost values in each line from loopOverInteriorLines
+	 */
+	int line_length;
+	/**
+	 * @brief the alignment, in bytes, of the first non-ghost cell in each line
 	 */
-	std::valarray<double> vec;
+	static constexpr int alignment = 64;
+	/**
+	 * @brief the number of values in the storage, including ghost cells and padding
+	 */
+	size_t size;
+	/**
+	 * @brief the allocated buffer, this has some slack at the front for alignment
+	 */
+	std::unique_ptr<T[]> buffer;
+	/**
+	 * @brief the start of the storage, within buffer
+	 */
+	T *data;
+	/**
+	 * @brief scratch space for the per-patch results of sumOverInteriorLines and infNorm
+	 *
+	 * This is grown as needed and kept with the vector, so the reductions do not allocate.
+	 */
+	mutable std::vector<double> patch_sums_buffer;
 
 	/**
 	 * @brief Calculate the number of local (non-ghost) cells
@@ -78,6 +140,159 @@ template <int D> class ValVector : public Vector<D>
 		}
 		return num_patches * num_cells_in_patch;
 	}
+	/**
+	 * @brief Round a number of values up to a multiple of the alignment
+	 *
+	 * @param n the number of values
+	 * @return int the padded number of values
+	 */
+	static int PadToAlignment(int n)
+	{
+		int values_per_line = alignment / sizeof(T);
+		return (n + values_per_line - 1) / values_per_line * values_per_line;
+	}
+	/**
+	 * @brief Allocate the buffer and zero the storage
+	 *
+	 * @param first_touch zero the storage one patch at a time, in the same static patch loop that
+	 * the vector operations use
+	 */
+	void allocate(bool first_touch)
+	{
+		int values_per_line = alignment / sizeof(T);
+		buffer.reset(new T[size + values_per_line - 1]);
+		uintptr_t first_address = reinterpret_cast<uintptr_t>(buffer.get() + first_offset);
+		int       shift = (alignment - first_address % alignment) % alignment / sizeof(T);
+		data            = buffer.get() + shift;
+		if (first_touch) {
+			ParallelPatchLoop(
+			this->getNumLocalPatches(), true,
+			[&](int p) { std::fill(data + patch_stride * p, data + patch_stride * (p + 1), 0.0); },
+			PatchSchedule::Static);
+		} else {
+			std::fill(data, data + size, 0.0);
+		}
+	}
+	/**
+	 * @brief Call a function for each contiguous line of non-ghost cells in a patch
+	 *
+	 * The lines run along the first axis, so each line has line_length consecutive values. When
+	 * the components are interleaved, a line holds all the components of its cells.
+	 *
+	 * @param p the local index of the patch
+	 * @param func called with the offset (from the start of the storage) of the first value in the
+	 * line
+	 */
+	template <typename Func> void loopOverInteriorLinesOfPatch(int p, Func func) const
+	{
+		std::array<int, D - 1> start;
+		std::array<int, D - 1> end;
+		for (size_t i = 0; i < D - 1; i++) {
+			start[i] = 0;
+			end[i]   = lengths[i + 1] - 1;
+		}
+		int num_line_components = interleaved ? 1 : this->getNumComponents();
+		for (int c = 0; c < num_line_components; c++) {
+			int patch_offset = patch_stride * p + component_stride * c + first_offset;
+			nested_loop<D - 1>(start, end, [&](const std::array<int, D - 1> &coord) {
+				int offset = patch_offset;
+				for (size_t i = 0; i < D - 1; i++) {
+					offset += strides[i + 1] * coord[i];
+				}
+				func(offset);
+			});
+		}
+	}
+	/**
+	 * @brief Call a function for each contiguous line of non-ghost cells in the vector
+	 *
+	 * The patches are spread over the threads with a static schedule, so func has to be safe to
+	 * call for lines of different patches at the same time.
+	 *
+	 * @param func called with the offset (from the start of the storage) of the first value in the
+	 * line
+	 */
+	template <typename Func> void loopOverInteriorLines(Func func) const
+	{
+		ParallelPatchLoop(
+		this->getNumLocalPatches(), true, [&](int p) { loopOverInteriorLinesOfPatch(p, func); },
+		PatchSchedule::Static);
+	}
+	/**
+	 * @brief Get scratch space for num_sums values for each patch
+	 *
+	 * The values for each patch start on their own cache line, so that threads working on
+	 * neighboring patches do not write to the same cache line.
+	 *
+	 * @param num_sums the number of values for each patch
+	 * @param patch_sums_stride set to the striding between the values of consecutive patches
+	 * @return double* the start of the values for the first patch
+	 */
+	double *getPatchSums(int num_sums, int &patch_sums_stride) const
+	{
+		int    values_per_line = alignment / sizeof(double);
+		int    num_lines       = (num_sums + values_per_line - 1) / values_per_line;
+		size_t size_needed     = num_lines * values_per_line * this->getNumLocalPatches();
+		if (patch_sums_buffer.size() < size_needed + values_per_line - 1) {
+			patch_sums_buffer.resize(size_needed + values_per_line - 1);
+		}
+		patch_sums_stride = num_lines * values_per_line;
+		uintptr_t address = reinterpret_cast<uintptr_t>(patch_sums_buffer.data());
+		int       shift   = (alignment - address % alignment) % alignment / sizeof(double);
+		return patch_sums_buffer.data() + shift;
+	}
+	/**
+	 * @brief Sum up values over the lines of non-ghost cells
+	 *
+	 * The sums for each patch are computed in a patch loop, and then added up in patch order, so
+	 * the result does not depend on the number of threads. Since the sums for each patch are kept
+	 * in a buffer owned by the vector, this should not be called on the same vector from more than
+	 * one thread at a time.
+	 *
+	 * @param num_sums the number of sums
+	 * @param sums the output sums
+	 * @param func called with the offset of the first value in each line, and a pointer to
+	 * num_sums values that the sums for the line are added to
+	 */
+	template <typename Func> void sumOverInteriorLines(int num_sums, double *sums, Func func) const
+	{
+		int     num_patches = this->getNumLocalPatches();
+		int     patch_sums_stride;
+		double *patch_sums = getPatchSums(num_sums, patch_sums_stride);
+		ParallelPatchLoop(
+		num_patches, true,
+		[&](int p) {
+			double *my_sums = patch_sums + patch_sums_stride * p;
+			std::fill(my_sums, my_sums + num_sums, 0.0);
+			loopOverInteriorLinesOfPatch(p, [&](int offset) { func(offset, my_sums); });
+		},
+		PatchSchedule::Static);
+		std::fill(sums, sums + num_sums, 0.0);
+		for (int p = 0; p < num_patches; p++) {
+			for (int j = 0; j < num_sums; j++) {
+				sums[j] += patch_sums[patch_sums_stride * p + j];
+			}
+		}
+	}
+	/**
+	 * @brief Get the other vector as a ValVector, if it has the same layout as this vector
+	 *
+	 * @param b the other vector
+	 * @return const ValVector<D, T>* the ValVector, nullptr if b is not a ValVector with the same
+	 * layout
+	 */
+	const ValVector<D, T> *getMatchingValVector(const std::shared_ptr<const Vector<D, T>> &b) const
+	{
+		const ValVector<D, T> *b_val = dynamic_cast<const ValVector<D, T> *>(b.get());
+		if (b_val != nullptr && b_val->lengths == lengths && b_val->strides == strides
+		    && b_val->num_ghost_cells == num_ghost_cells
+		    && b_val->component_stride == component_stride
+		    && b_val->getNumComponents() == this->getNumComponents()
+		    && b_val->getNumLocalPatches() == this->getNumLocalPatches()) {
+			return b_val;
+		}
+		return nullptr;
+	}
 
 	public:
 	/**
@@ -88,51 +303,312 @@ template <int D> class ValVector : public Vector<D>
 	 * @param num_ghost_cells the number of ghost cells padding each side of a patch
 	 * @param num_components the number of components for each cell
 	 * @param num_patches the number of patches in this vector
+	 * @param storage how to lay out and initialize the storage
 	 */
 	ValVector(MPI_Comm comm, const std::array<int, D> &lengths, int num_ghost_cells,
-	          int num_components, int num_patches)
-	: Vector<D>(comm, num_components, num_patches, GetNumLocalCells(lengths, num_patches)),
-	  lengths(lengths), num_ghost_cells(num_ghost_cells)
+	          int num_components, int num_patches, ValVectorStorage storage = ValVectorStorage())
+	: Vector<D, T>(comm, num_components, num_patches, GetNumLocalCells(lengths, num_patches)),
+	  lengths(lengths), num_ghost_cells(num_ghost_cells), interleaved(storage.interleaved)
 	{
-		int size            = 1;
+		int my_size         = interleaved ? num_components : 1;
 		int my_first_offset = 0;
 		for (size_t i = 0; i < D; i++) {
-			strides[i] = size;
-			size *= (this->lengths[i] + 2 * num_ghost_cells);
+			strides[i] = my_size;
+			my_size *= (this->lengths[i] + 2 * num_ghost_cells);
+			if (storage.padded && i == 0) {
+				my_size = PadToAlignment(my_size);
+			}
 			my_first_offset += strides[i] * num_ghost_cells;
 		}
-		first_offset     = my_first_offset;
-		component_stride = size;
-		size *= num_components;
-		patch_stride = size;
-		size *= num_patches;
-		vec.resize(size);
+		first_offset = my_first_offset;
+		if (interleaved) {
+			component_stride = 1;
+			line_length      = lengths[0] * num_components;
+		} else {
+			component_stride = my_size;
+			line_length      = lengths[0];
+			my_size *= num_components;
+		}
+		patch_stride = my_size;
+		my_size *= num_patches;
+		size = my_size;
+		allocate(storage.first_touch);
 	}
 	/**
 	 * @brief Get a new ValVector object for a given Domain
 	 *
 	 * @param domain the Domain
 	 * @param num_components the number of components for each cell
-	 * @return std::shared_ptr<ValVector<D>> the new Vector
+	 * @param storage how to lay out and initialize the storage
+	 * @return std::shared_ptr<ValVector<D, T>> the new Vector
 	 */
-	static std::shared_ptr<ValVector<D>> GetNewVector(std::shared_ptr<const Domain<D>> domain,
-	                                                  int num_components)
+	static std::shared_ptr<ValVector<D, T>>
+	GetNewVector(std::shared_ptr<const Domain<D>> domain, int num_components,
+	             ValVectorStorage storage = ValVectorStorage())
 	{
-		return std::shared_ptr<ValVector<D>>(
-		new ValVector<D>(MPI_COMM_WORLD, domain->getNs(), domain->getNumGhostCells(),
-		                 num_components, domain->getNumLocalPatches()));
+		return std::shared_ptr<ValVector<D, T>>(
+		new ValVector<D, T>(MPI_COMM_WORLD, domain->getNs(), domain->getNumGhostCells(),
+		                    num_components, domain->getNumLocalPatches(), storage));
 	}
-	LocalData<D> getLocalData(int component_index, int local_patch_index) override
+	LocalData<D, T> getLocalData(int component_index, int local_patch_index) override
 	{
-		double *data = &vec[patch_stride * local_patch_index + first_offset
-		                    + component_stride * component_index];
-		return LocalData<D>(data, strides, lengths, num_ghost_cells, nullptr);
+		T *ptr = data + patch_stride * local_patch_index + first_offset
+		         + component_stride * component_index;
+		return LocalData<D, T>(ptr, strides, lengths, num_ghost_cells, nullptr);
 	}
-	const LocalData<D> getLocalData(int component_index, int local_patch_index) const override
+	const LocalData<D, T> getLocalData(int component_index, int local_patch_index) const override
 	{
-		double *data = const_cast<double *>(
-		&vec[patch_stride * local_patch_index + first_offset + component_stride * component_index]);
-		return LocalData<D>(data, strides, lengths, num_ghost_cells, nullptr);
+		T *ptr = data + patch_stride * local_patch_index + first_offset
+		         + component_stride * component_index;
+		return LocalData<D, T>(ptr, strides, lengths, num_ghost_cells, nullptr);
+	}
+
+	void set(double alpha) override
+	{
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *x = &data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] = alpha;
+			}
+		});
+	}
+	void setWithGhost(double alpha) override
+	{
+		ParallelPatchLoop(
+		this->getNumLocalPatches(), true,
+		[&](int p) { std::fill(data + patch_stride * p, data + patch_stride * (p + 1), alpha); },
+		PatchSchedule::Static);
+	}
+	void scale(double alpha) override
+	{
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *x = &data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] *= alpha;
+			}
+		});
+	}
+	void shift(double delta) override
+	{
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *x = &data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] += delta;
+			}
+		});
+	}
+	void copy(std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			Vector<D, T>::copy(b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] = b_x[i];
+			}
+		});
+	}
+	void add(std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			Vector<D, T>::add(b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] += b_x[i];
+			}
+		});
+	}
+	void addScaled(double alpha, std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			Vector<D, T>::addScaled(alpha, b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] += b_x[i] * alpha;
+			}
+		});
+	}
+	void addScaled(double alpha, std::shared_ptr<const Vector<D, T>> a, double beta,
+	               std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *a_val = getMatchingValVector(a);
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (a_val == nullptr || b_val == nullptr) {
+			Vector<D, T>::addScaled(alpha, a, beta, b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *a_x = &a_val->data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] += a_x[i] * alpha + b_x[i] * beta;
+			}
+		});
+	}
+	void scaleThenAdd(double alpha, std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			Vector<D, T>::scaleThenAdd(alpha, b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] = alpha * x[i] + b_x[i];
+			}
+		});
+	}
+	void scaleThenAddScaled(double alpha, double beta,
+	                        std::shared_ptr<const Vector<D, T>> b) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			Vector<D, T>::scaleThenAddScaled(alpha, beta, b);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] = alpha * x[i] + beta * b_x[i];
+			}
+		});
+	}
+	void scaleThenAddScaled(double alpha, double beta, std::shared_ptr<const Vector<D, T>> b,
+	                        double gamma, std::shared_ptr<const Vector<D, T>> c) override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		const ValVector<D, T> *c_val = getMatchingValVector(c);
+		if (b_val == nullptr || c_val == nullptr) {
+			Vector<D, T>::scaleThenAddScaled(alpha, beta, b, gamma, c);
+			return;
+		}
+		int n = line_length;
+		loopOverInteriorLines([&](int offset) {
+			T *      x   = &data[offset];
+			const T *b_x = &b_val->data[offset];
+			const T *c_x = &c_val->data[offset];
+			for (int i = 0; i < n; i++) {
+				x[i] = alpha * x[i] + beta * b_x[i] + gamma * c_x[i];
+			}
+		});
+	}
+	double twoNorm() const override
+	{
+		double sum = 0;
+		int    n   = line_length;
+		sumOverInteriorLines(1, &sum, [&](int offset, double *sums) {
+			const T *x        = &data[offset];
+			double   line_sum = 0;
+			for (int i = 0; i < n; i++) {
+				line_sum += x[i] * x[i];
+			}
+			sums[0] += line_sum;
+		});
+		double global_sum;
+		MPI_Allreduce(&sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, this->getMPIComm());
+		return sqrt(global_sum);
+	}
+	double infNorm() const override
+	{
+		int     n = line_length;
+		int     patch_maxes_stride;
+		double *patch_maxes = getPatchSums(1, patch_maxes_stride);
+		ParallelPatchLoop(
+		this->getNumLocalPatches(), true,
+		[&](int p) {
+			double patch_max = 0;
+			loopOverInteriorLinesOfPatch(p, [&](int offset) {
+				const T *x = &data[offset];
+				for (int i = 0; i < n; i++) {
+					patch_max = fmax(fabs(x[i]), patch_max);
+				}
+			});
+			patch_maxes[patch_maxes_stride * p] = patch_max;
+		},
+		PatchSchedule::Static);
+		double max = 0;
+		for (int p = 0; p < this->getNumLocalPatches(); p++) {
+			max = fmax(patch_maxes[patch_maxes_stride * p], max);
+		}
+		double global_max;
+		MPI_Allreduce(&max, &global_max, 1, MPI_DOUBLE, MPI_MAX, this->getMPIComm());
+		return global_max;
+	}
+	double localDot(std::shared_ptr<const Vector<D, T>> b) const override
+	{
+		const ValVector<D, T> *b_val = getMatchingValVector(b);
+		if (b_val == nullptr) {
+			return Vector<D, T>::localDot(b);
+		}
+		double retval = 0;
+		int    n      = line_length;
+		sumOverInteriorLines(1, &retval, [&](int offset, double *sums) {
+			const T *x        = &data[offset];
+			const T *b_x      = &b_val->data[offset];
+			double   line_sum = 0;
+			for (int i = 0; i < n; i++) {
+				line_sum += x[i] * b_x[i];
+			}
+			sums[0] += line_sum;
+		});
+		return retval;
+	}
+	void localMultiDot(const std::vector<std::shared_ptr<const Vector<D, T>>> &bs,
+	                   double *                                                sums) const override
+	{
+		size_t                               num_bs = bs.size();
+		std::vector<const ValVector<D, T> *> b_vals(num_bs);
+		for (size_t j = 0; j < num_bs; j++) {
+			b_vals[j] = getMatchingValVector(bs[j]);
+			if (b_vals[j] == nullptr) {
+				Vector<D, T>::localMultiDot(bs, sums);
+				return;
+			}
+		}
+		int n = line_length;
+		sumOverInteriorLines(num_bs + 1, sums, [&](int offset, double *line_sums) {
+			const T *x = &data[offset];
+			for (size_t j = 0; j < num_bs; j++) {
+				const T *b_x      = &b_vals[j]->data[offset];
+				double   line_sum = 0;
+				for (int i = 0; i < n; i++) {
+					line_sum += x[i] * b_x[i];
+				}
+				line_sums[j] += line_sum;
+			}
+			double line_sum = 0;
+			for (int i = 0; i < n; i++) {
+				line_sum += x[i] * x[i];
+			}
+			line_sums[num_bs] += line_sum;
+		});
 	}
 
 	/**
@@ -145,13 +621,42 @@ template <int D> class ValVector : public Vector<D>
 		return num_ghost_cells;
 	}
 	/**
-	 * @brief Get a reference to the underlying valarray
+	 * @brief Get the number of values in the storage, including ghost cells and padding
+	 *
+	 * @return size_t the number of values
+	 */
+	size_t getSize() const
+	{
+		return size;
+	}
+	bool hasThreadSafeLocalData() const override
+	{
+		return true;
+	}
+	bool hasInterleavedComponents() const override
+	{
+		return interleaved;
+	}
+	/**
+	 * @brief Get a pointer to the start of the storage
+	 *
+	 * Without padding or interleaving, the values for each component of each patch are stored
+	 * contiguously, with the first axis varying fastest.
+	 *
+	 * @return T* the pointer
+	 */
+	T *getData()
+	{
+		return data;
+	}
+	/**
+	 * @brief Get a pointer to the start of the storage
 	 *
-	 * @return std::valarray<int>& a reference to the underlying valarray
+	 * @return const T* the pointer
 	 */
-	std::valarray<double> &getValArray()
+	const T *getData() const
 	{
-		return vec;
+		return data;
 	}
 };
 } // namespace ThunderEgg
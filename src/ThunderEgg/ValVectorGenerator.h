@@ -22,16 +22,20 @@
 #ifndef THUNDEREGG_VALVECTORGENERATOR_H
 #define THUNDEREGG_VALVECTORGENERATOR_H
 #include <ThunderEgg/ValVector.h>
+#include <ThunderEgg/ValVectorPool.h>
 #include <ThunderEgg/VectorGenerator.h>
-#include <valarray>
 namespace ThunderEgg
 {
 /**
  * @brief Generates new ValVector objects for a given Domain
  *
+ * Vectors are recycled through a ValVectorPool, so a vector that is released is reused by a
+ * later call to getNewVector. Copies of a generator share the same pool.
+ *
  * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the values
  */
-template <int D> class ValVectorGenerator : public VectorGenerator<D>
+template <int D, typename T = double> class ValVectorGenerator : public VectorGenerator<D, T>
 {
 	private:
 	/**
@@ -42,6 +46,10 @@ template <int D> class ValVectorGenerator : public VectorGenerator<D>
 	 * @brief The number of components in each cell
 	 */
 	int num_components;
+	/**
+	 * @brief The pool that vectors are drawn from
+	 */
+	std::shared_ptr<ValVectorPool<D, T>> pool;
 
 	public:
 	/**
@@ -49,14 +57,26 @@ template <int D> class ValVectorGenerator : public VectorGenerator<D>
 	 *
 	 * @param domain the Domain to generate ValVector objects for
 	 * @param num_components the number of components for each cell
+	 * @param storage how to lay out and initialize the storage of the vectors
 	 */
-	explicit ValVectorGenerator(std::shared_ptr<const Domain<D>> domain, int num_components)
-	: domain(domain), num_components(num_components)
+	explicit ValVectorGenerator(std::shared_ptr<const Domain<D>> domain, int num_components,
+	                            ValVectorStorage storage = ValVectorStorage())
+	: domain(domain), num_components(num_components),
+	  pool(std::make_shared<ValVectorPool<D, T>>(MPI_COMM_WORLD, domain->getNs(),
+	                                             domain->getNumGhostCells(), num_components,
+	                                             domain->getNumLocalPatches(), storage))
 	{
 	}
-	std::shared_ptr<Vector<D>> getNewVector() const override
+	std::shared_ptr<Vector<D, T>> getNewVector() const override
+	{
+		return pool->getVector();
+	}
+	/**
+	 * @brief Get the pool that vectors are drawn from
+	 */
+	std::shared_ptr<ValVectorPool<D, T>> getPool() const
 	{
-		return ValVector<D>::GetNewVector(domain, num_components);
+		return pool;
 	}
 };
 } // namespace ThunderEgg
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#ifndef THUNDEREGG_VALVECTORPOOL_H
+#define THUNDEREGG_VALVECTORPOOL_H
+#include <ThunderEgg/ValVector.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+namespace ThunderEgg
+{
+/**
+ * @brief A pool of identically shaped ValVector objects
+ *
+ * The pool keeps a shared_ptr to every vector it has created, and getVector hands out copies of
+ * them. A vector is free again once the pool holds the only reference to it. Since the handles
+ * share the control block that was created along with the vector, once a solve has reached its
+ * peak number of live vectors, later calls to getVector do not allocate at all.
+ *
+ * Vectors that outlive the pool are deleted normally.
+ *
+ * This class is not thread safe.
+ *
+ * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the values
+ */
+template <int D, typename T = double> class ValVectorPool
+{
+	private:
+	/**
+	 * @brief the MPI comm for the vectors
+	 */
+	MPI_Comm comm;
+	/**
+	 * @brief the number of cells along each axis of a patch
+	 */
+	std::array<int, D> lengths;
+	/**
+	 * @brief the number of ghost cells on each side of a patch
+	 */
+	int num_ghost_cells;
+	/**
+	 * @brief the number of components for each cell
+	 */
+	int num_components;
+	/**
+	 * @brief the number of local patches
+	 */
+	int num_patches;
+	/**
+	 * @brief how to lay out and initialize the storage of the vectors
+	 */
+	ValVectorStorage storage;
+	/**
+	 * @brief every vector created by the pool, the ones with a use count of 1 are free
+	 */
+	std::vector<std::shared_ptr<ValVector<D, T>>> vectors;
+
+	/**
+	 * @brief Check if a vector is only referenced by the pool
+	 */
+	static bool IsFree(const std::shared_ptr<ValVector<D, T>> &vec)
+	{
+		return vec.use_count() == 1;
+	}
+
+	public:
+	/**
+	 * @brief Construct a new ValVectorPool object
+	 *
+	 * The arguments are the same as the ValVector constructor.
+	 *
+	 * @param comm the MPI comm for the vectors
+	 * @param lengths the number of cells along each axis of a patch
+	 * @param num_ghost_cells the number of ghost cells on each side of a patch
+	 * @param num_components the number of components for each cell
+	 * @param num_patches the number of local patches
+	 * @param storage how to lay out and initialize the storage of the vectors
+	 */
+	ValVectorPool(MPI_Comm comm, const std::array<int, D> &lengths, int num_ghost_cells,
+	              int num_components, int num_patches,
+	              ValVectorStorage storage = ValVectorStorage())
+	: comm(comm), lengths(lengths), num_ghost_cells(num_ghost_cells),
+	  num_components(num_components), num_patches(num_patches), storage(storage)
+	{
+	}
+	/**
+	 * @brief Get a vector from the pool, allocating a new one if the pool is empty
+	 *
+	 * Recycled vectors are zeroed, including the ghost cells, so the result is
+	 * indistinguishable from a newly allocated ValVector.
+	 *
+	 * @return std::shared_ptr<ValVector<D, T>> the vector
+	 */
+	std::shared_ptr<ValVector<D, T>> getVector()
+	{
+		for (const std::shared_ptr<ValVector<D, T>> &vec : vectors) {
+			if (IsFree(vec)) {
+				vec->setWithGhost(0);
+				return vec;
+			}
+		}
+		vectors.push_back(std::make_shared<ValVector<D, T>>(comm, lengths, num_ghost_cells,
+		                                                     num_components, num_patches, storage));
+		return vectors.back();
+	}
+	/**
+	 * @brief Get the number of vectors currently waiting in the pool
+	 */
+	size_t getNumFreeVectors() const
+	{
+		return std::count_if(vectors.begin(), vectors.end(), IsFree);
+	}
+	/**
+	 * @brief Free all of the vectors currently waiting in the pool
+	 *
+	 * Vectors that are in use are deleted normally once they are released.
+	 */
+	void clear()
+	{
+		vectors.erase(std::remove_if(vectors.begin(), vectors.end(), IsFree), vectors.end());
+	}
+};
+} // namespace ThunderEgg
+#endif
@@ -25,6 +25,7 @@
 #include <ThunderEgg/DomainTools.h>
 #include <ThunderEgg/GMG/Level.h>
 #include <ThunderEgg/GhostFiller.h>
+#include <ThunderEgg/PatchKernelRegistry.h>
 #include <ThunderEgg/PatchOperator.h>
 #include <ThunderEgg/RuntimeError.h>
 #include <ThunderEgg/ValVector.h>
@@ -49,6 +50,172 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 	{
 		return (axis == 0) ? 0 : 1;
 	}
+	/**
+	 * @brief Set the ghost cells on the physical boundaries of the patch
+	 *
+	 * @param pinfo the patch
+	 * @param u the patch data
+	 * @param treat_interior_boundary_as_dirichlet also set the ghost cells on interior sides
+	 */
+	void setPatchBoundaryGhosts(std::shared_ptr<const PatchInfo<D>> pinfo, const LocalData<D> &u,
+	                            bool treat_interior_boundary_as_dirichlet) const
+	{
+		for (Side<D> s : Side<D>::getValues()) {
+			if (!pinfo->hasNbr(s) || treat_interior_boundary_as_dirichlet) {
+				LocalData<D - 1>       ghosts = u.getGhostSliceOnSide(s, 1);
+				const LocalData<D - 1> mid    = u.getSliceOnSide(s);
+				nested_loop<D - 1>(mid.getStart(), mid.getEnd(), [&](std::array<int, D - 1> coord) {
+					ghosts[coord] = -mid[coord];
+				});
+			}
+		}
+	}
+
+	/**
+	 * @brief Evaluate the stencil at a cell
+	 *
+	 * @param u pointer to the cell
+	 * @param c pointer to the coefficient of the cell
+	 * @param strides the strides of the patch data
+	 * @param c_strides the strides of the coefficient data
+	 * @param h2 the squared cell spacings
+	 * @return double the value of the operator at the cell
+	 */
+	static double applyStencil(const double *u, const double *c, const std::array<int, D> &strides,
+	                           const std::array<int, D> &   c_strides,
+	                           const std::array<double, D> &h2)
+	{
+		double sum = 0;
+		for (int axis = 0; axis < D; axis++) {
+			double lower   = u[-strides[axis]];
+			double mid     = u[0];
+			double upper   = u[strides[axis]];
+			double c_lower = c[-c_strides[axis]];
+			double c_mid   = c[0];
+			double c_upper = c[c_strides[axis]];
+			sum += ((c_upper + c_mid) * (upper - mid) - (c_lower + c_mid) * (mid - lower))
+			       / (2 * h2[axis]);
+		}
+		return sum;
+	}
+
+	private:
+	/**
+	 * @brief Kernels for a fixed patch size
+	 */
+	struct FixedSizeKernels {
+		/**
+		 * @brief computes f = A u on a patch
+		 */
+		void (*apply)(const LocalData<D> &c, const LocalData<D> &u, LocalData<D> &f,
+		              const std::array<double, D> &h2)
+		= nullptr;
+		/**
+		 * @brief computes r = f - A u on a patch
+		 */
+		void (*residual)(const LocalData<D> &c, const LocalData<D> &f, const LocalData<D> &u,
+		                 LocalData<D> &r, const std::array<double, D> &h2)
+		= nullptr;
+	};
+	/**
+	 * @brief The kernels for the patch size of the domain, nullptr if there are none
+	 */
+	FixedSizeKernels fixed_kernels;
+	/**
+	 * @brief Evaluate the stencil at a cell, with unit stride along the first axis
+	 */
+	static double applyStencilUnitStride(const double *u, const double *c,
+	                                     const std::array<int, D> &   strides,
+	                                     const std::array<int, D> &   c_strides,
+	                                     const std::array<double, D> &h2)
+	{
+		double sum = 0;
+		sum += ((c[1] + c[0]) * (u[1] - u[0]) - (c[-1] + c[0]) * (u[0] - u[-1])) / (2 * h2[0]);
+		for (int axis = 1; axis < D; axis++) {
+			double lower   = u[-strides[axis]];
+			double mid     = u[0];
+			double upper   = u[strides[axis]];
+			double c_lower = c[-c_strides[axis]];
+			double c_mid   = c[0];
+			double c_upper = c[c_strides[axis]];
+			sum += ((c_upper + c_mid) * (upper - mid) - (c_lower + c_mid) * (mid - lower))
+			       / (2 * h2[axis]);
+		}
+		return sum;
+	}
+	/**
+	 * @brief Compute f = A u on a patch with N cells along each axis
+	 *
+	 * The first axis has to have unit stride in c, u, and f.
+	 */
+	template <int N>
+	static void ApplyFixedSize(const LocalData<D> &c, const LocalData<D> &u, LocalData<D> &f,
+	                           const std::array<double, D> &h2)
+	{
+		std::array<int, D> strides   = u.getStrides();
+		std::array<int, D> c_strides = c.getStrides();
+		f.forEachLine([&](const std::array<int, D> &coord, double *f_line) {
+			const double *c_line = c.getPtr(coord);
+			const double *u_line = u.getPtr(coord);
+			for (int i = 0; i < N; i++) {
+				f_line[i] = applyStencilUnitStride(u_line + i, c_line + i, strides, c_strides, h2);
+			}
+		});
+	}
+	/**
+	 * @brief Compute r = f - A u on a patch with N cells along each axis
+	 *
+	 * The first axis has to have unit stride in c, f, u, and r.
+	 */
+	template <int N>
+	static void ResidualFixedSize(const LocalData<D> &c, const LocalData<D> &f,
+	                              const LocalData<D> &u, LocalData<D> &r,
+	                              const std::array<double, D> &h2)
+	{
+		std::array<int, D> strides   = u.getStrides();
+		std::array<int, D> c_strides = c.getStrides();
+		r.forEachLine([&](const std::array<int, D> &coord, double *r_line) {
+			const double *c_line = c.getPtr(coord);
+			const double *f_line = f.getPtr(coord);
+			const double *u_line = u.getPtr(coord);
+			for (int i = 0; i < N; i++) {
+				double sum
+				= applyStencilUnitStride(u_line + i, c_line + i, strides, c_strides, h2);
+				r_line[i] = f_line[i] - sum;
+			}
+		});
+	}
+	/**
+	 * @brief Get the kernels for patches with N cells along each axis
+	 */
+	template <int N> static FixedSizeKernels GetFixedSizeKernels()
+	{
+		FixedSizeKernels kernels;
+		kernels.apply    = &ApplyFixedSize<N>;
+		kernels.residual = &ResidualFixedSize<N>;
+		return kernels;
+	}
+	/**
+	 * @brief Get the registry of fixed size kernels, with 8, 16, and 32 cells registered
+	 */
+	static PatchKernelRegistry<D, FixedSizeKernels> &GetKernelRegistry()
+	{
+		static PatchKernelRegistry<D, FixedSizeKernels> registry = []() {
+			PatchKernelRegistry<D, FixedSizeKernels> defaults;
+			defaults.add(8, GetFixedSizeKernels<8>());
+			defaults.add(16, GetFixedSizeKernels<16>());
+			defaults.add(32, GetFixedSizeKernels<32>());
+			return defaults;
+		}();
+		return registry;
+	}
+	/**
+	 * @brief Check if the fixed size kernels can be used on the data
+	 */
+	static bool HasUnitStride(const LocalData<D> &ld)
+	{
+		return ld.getStrides()[0] == 1;
+	}
 
 	public:
 	/**
@@ -67,6 +234,37 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 			throw RuntimeError("StarPatchOperator needs at least one set of ghost cells");
 		}
 		this->ghost_filler->fillGhost(this->coeffs);
+		fixed_kernels = GetKernelRegistry().find(this->domain->getNs());
+	}
+	/**
+	 * @brief Register kernels for patches with N cells along each axis
+	 *
+	 * Operators that are constructed afterwards on a Domain with this patch size will use loops
+	 * with a fixed trip count. This is not thread safe.
+	 *
+	 * @tparam N the number of cells along each axis
+	 */
+	template <int N> static void RegisterPatchSize()
+	{
+		GetKernelRegistry().add(N, GetFixedSizeKernels<N>());
+	}
+	/**
+	 * @brief Check if this operator has kernels specialized for the patch size of the Domain
+	 *
+	 * @return true if it does
+	 */
+	bool usesFixedSizeKernels() const
+	{
+		return fixed_kernels.apply != nullptr;
+	}
+	/**
+	 * @brief The single patch functions only write to the patch that they are called for
+	 *
+	 * @return true
+	 */
+	bool isThreadSafe() const override
+	{
+		return true;
 	}
 	void applySinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
 	                      const std::vector<LocalData<D>> &us, std::vector<LocalData<D>> &fs,
@@ -77,23 +275,13 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 		for (size_t i = 0; i < D; i++) {
 			h2[i] *= h2[i];
 		}
+		setPatchBoundaryGhosts(pinfo, us[0], treat_interior_boundary_as_dirichlet);
+		if (usesFixedSizeKernels() && HasUnitStride(c) && HasUnitStride(us[0])
+		    && HasUnitStride(fs[0])) {
+			fixed_kernels.apply(c, us[0], fs[0], h2);
+			return;
+		}
 		loop<0, D - 1>([&](int axis) {
-			Side<D> lower_side(axis * 2);
-			Side<D> upper_side(axis * 2 + 1);
-			if (!pinfo->hasNbr(lower_side) || treat_interior_boundary_as_dirichlet) {
-				LocalData<D - 1>       lower = us[0].getGhostSliceOnSide(lower_side, 1);
-				const LocalData<D - 1> mid   = us[0].getSliceOnSide(lower_side);
-				nested_loop<D - 1>(mid.getStart(), mid.getEnd(), [&](std::array<int, D - 1> coord) {
-					lower[coord] = -mid[coord];
-				});
-			}
-			if (!pinfo->hasNbr(upper_side) || treat_interior_boundary_as_dirichlet) {
-				LocalData<D - 1>       upper = us[0].getGhostSliceOnSide(upper_side, 1);
-				const LocalData<D - 1> mid   = us[0].getSliceOnSide(upper_side);
-				nested_loop<D - 1>(mid.getStart(), mid.getEnd(), [&](std::array<int, D - 1> coord) {
-					upper[coord] = -mid[coord];
-				});
-			}
 			int stride   = us[0].getStrides()[axis];
 			int c_stride = c.getStrides()[axis];
 			nested_loop<D>(us[0].getStart(), us[0].getEnd(), [&](std::array<int, D> coord) {
@@ -112,6 +300,125 @@ template <int D> class StarPatchOperator : public PatchOperator<D>
 			});
 		});
 	}
+	/**
+	 * @brief Compute the residual r = f - A u on a single patch in one pass
+	 *
+	 * The axis contributions are summed in the same order as applySinglePatch, so the result
+	 * matches applying the operator and then subtracting from f.
+	 */
+	void residualSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                         const std::vector<LocalData<D>> &   fs,
+	                         const std::vector<LocalData<D>> &   us,
+	                         std::vector<LocalData<D>> &         rs) const override
+	{
+		const LocalData<D>    c  = coeffs->getLocalData(0, pinfo->local_index);
+		std::array<double, D> h2 = pinfo->spacings;
+		for (size_t i = 0; i < D; i++) {
+			h2[i] *= h2[i];
+		}
+
+		setPatchBoundaryGhosts(pinfo, us[0], false);
+		if (usesFixedSizeKernels() && HasUnitStride(c) && HasUnitStride(fs[0])
+		    && HasUnitStride(us[0]) && HasUnitStride(rs[0])) {
+			fixed_kernels.residual(c, fs[0], us[0], rs[0], h2);
+			return;
+		}
+
+		int                n         = us[0].getLengths()[0];
+		int                u_stride  = us[0].getStrides()[0];
+		int                c_stride  = c.getStrides()[0];
+		int                f_stride  = fs[0].getStrides()[0];
+		int                r_stride  = rs[0].getStrides()[0];
+		std::array<int, D> strides   = us[0].getStrides();
+		std::array<int, D> c_strides = c.getStrides();
+		us[0].forEachLine([&](const std::array<int, D> &coord, const double *u) {
+			const double *c_line = c.getPtr(coord);
+			const double *f      = fs[0].getPtr(coord);
+			double *      r      = rs[0].getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				double sum = applyStencil(u + i * u_stride, c_line + i * c_stride, strides,
+				                          c_strides, h2);
+				r[i * r_stride] = f[i * f_stride] - sum;
+			}
+		});
+	}
+	void getDiagonalSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                            std::vector<LocalData<D>> &         ds) const override
+	{
+		const LocalData<D>    c  = coeffs->getLocalData(0, pinfo->local_index);
+		std::array<double, D> h2 = pinfo->spacings;
+		for (size_t i = 0; i < D; i++) {
+			h2[i] *= h2[i];
+		}
+
+		int                n         = ds[0].getLengths()[0];
+		int                c_stride  = c.getStrides()[0];
+		int                d_stride  = ds[0].getStrides()[0];
+		std::array<int, D> c_strides = c.getStrides();
+		ds[0].forEachLine([&](const std::array<int, D> &coord, double *d) {
+			const double *c_line = c.getPtr(coord);
+			for (int i = 0; i < n; i++) {
+				const double *c_ptr = c_line + i * c_stride;
+				double        sum   = 0;
+				for (int axis = 0; axis < D; axis++) {
+					double c_lower = c_ptr[-c_strides[axis]];
+					double c_upper = c_ptr[c_strides[axis]];
+					sum -= (c_upper + 2 * c_ptr[0] + c_lower) / (2 * h2[axis]);
+				}
+				d[i * d_stride] = sum;
+			}
+		});
+		// the boundary ghost cells are the negative of the adjacent cell
+		for (Side<D> s : Side<D>::getValues()) {
+			if (!pinfo->hasNbr(s)) {
+				double                 h2_axis = h2[s.getAxisIndex()];
+				LocalData<D - 1>       inner   = ds[0].getSliceOnSide(s);
+				const LocalData<D - 1> c_ghost = c.getGhostSliceOnSide(s, 1);
+				const LocalData<D - 1> c_inner = c.getSliceOnSide(s);
+				nested_loop<D - 1>(
+				inner.getStart(), inner.getEnd(), [&](const std::array<int, D - 1> &coord) {
+					inner[coord] -= (c_ghost[coord] + c_inner[coord]) / (2 * h2_axis);
+				});
+			}
+		}
+	}
+	void relaxSinglePatch(std::shared_ptr<const PatchInfo<D>> pinfo,
+	                      const std::vector<LocalData<D>> &fs, const std::vector<LocalData<D>> &us,
+	                      const std::vector<LocalData<D>> &ds, int color,
+	                      double weight) const override
+	{
+		const LocalData<D>    c  = coeffs->getLocalData(0, pinfo->local_index);
+		std::array<double, D> h2 = pinfo->spacings;
+		for (size_t i = 0; i < D; i++) {
+			h2[i] *= h2[i];
+		}
+
+		setPatchBoundaryGhosts(pinfo, us[0], false);
+
+		LocalData<D>       u         = us[0];
+		int                n         = u.getLengths()[0];
+		int                u_stride  = u.getStrides()[0];
+		int                c_stride  = c.getStrides()[0];
+		int                f_stride  = fs[0].getStrides()[0];
+		int                d_stride  = ds[0].getStrides()[0];
+		std::array<int, D> strides   = u.getStrides();
+		std::array<int, D> c_strides = c.getStrides();
+		u.forEachLine([&](const std::array<int, D> &coord, double *u_line) {
+			const double *c_line = c.getPtr(coord);
+			const double *f      = fs[0].getPtr(coord);
+			const double *d      = ds[0].getPtr(coord);
+			int           first  = color;
+			for (int axis = 0; axis < D; axis++) {
+				first += coord[axis];
+			}
+			for (int i = first % 2; i < n; i += 2) {
+				double *ptr   = u_line + i * u_stride;
+				double  resid = f[i * f_stride]
+				               - applyStencil(ptr, c_line + i * c_stride, strides, c_strides, h2);
+				ptr[0] += weight * resid / d[i * d_stride];
+			}
+		});
+	}
 	void addGhostToRHS(std::shared_ptr<const PatchInfo<D>> pinfo,
 	                   const std::vector<LocalData<D>> &   us,
 	                   std::vector<LocalData<D>> &         fs) const override
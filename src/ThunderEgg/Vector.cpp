@@ -28,4 +28,10 @@ template class LocalData<3>;
 template class Vector<1>;
 template class Vector<2>;
 template class Vector<3>;
+template class LocalData<1, float>;
+template class LocalData<2, float>;
+template class LocalData<3, float>;
+template class Vector<1, float>;
+template class Vector<2, float>;
+template class Vector<3, float>;
 } // namespace ThunderEgg
@@ -23,6 +23,7 @@
 #define THUNDEREGG_VECTOR_H
 #include <ThunderEgg/LocalData.h>
 #include <ThunderEgg/Loops.h>
+#include <ThunderEgg/ReductionRequest.h>
 #include <ThunderEgg/Side.h>
 #include <algorithm>
 #include <cmath>
@@ -34,9 +35,13 @@ namespace ThunderEgg
 /**
  * @brief Vector class for use in thunderegg
  *
+ * The scalar type only affects how values are stored. Scalar arguments are always passed as
+ * double, and norms and dot products are always accumulated in double.
+ *
  * @tparam D the number of cartesian dimensions
+ * @tparam T the scalar type of the values
  */
-template <int D> class Vector
+template <int D, typename T = double> class Vector
 {
 	private:
 	/**
@@ -104,32 +109,58 @@ template <int D> class Vector
 	{
 		return num_local_cells;
 	}
+	/**
+	 * @brief Check if getLocalData can be called for different patches from several threads at
+	 * the same time
+	 *
+	 * Patch loops only run on more than one thread for vectors where this is true.
+	 *
+	 * @return true if it can
+	 */
+	virtual bool hasThreadSafeLocalData() const
+	{
+		return false;
+	}
+	/**
+	 * @brief Check if the components of each cell are stored next to each other
+	 *
+	 * If true, the LocalData for component c of a patch starts c values after the LocalData for
+	 * component 0, and all of the components have the same strides. Code that goes through all
+	 * of the components of a cell can then read them as one contiguous run.
+	 *
+	 * @return true if they are
+	 */
+	virtual bool hasInterleavedComponents() const
+	{
+		return false;
+	}
 	/**
 	 * @brief Get the LocalData object for the specified patch and component
 	 *
 	 * @param component_index the index of the component access
 	 * @param patch_local_index the local index of the patch
-	 * @return LocalData<D> the LocalData object
+	 * @return LocalData<D, T> the LocalData object
 	 */
-	virtual LocalData<D> getLocalData(int component_index, int patch_local_index) = 0;
+	virtual LocalData<D, T> getLocalData(int component_index, int patch_local_index) = 0;
 	/**
 	 * @brief Get the LocalData object for the specified patch and component
 	 *
 	 * @param component_index the index of the component access
 	 * @param patch_local_index the local index of the patch
-	 * @return LocalData<D> the LocalData object
+	 * @return LocalData<D, T> the LocalData object
 	 */
-	virtual const LocalData<D> getLocalData(int component_index, int patch_local_index) const = 0;
+	virtual const LocalData<D, T> getLocalData(int component_index,
+	                                           int patch_local_index) const = 0;
 	/**
 	 * @brief Get the LocalData objects for the specified patch
 	 * index of LocalData object will correspond to component index
 	 *
 	 * @param patch_local_index the local index of the patch
-	 * @return LocalData<D> the LocalData object
+	 * @return LocalData<D, T> the LocalData object
 	 */
-	std::vector<LocalData<D>> getLocalDatas(int patch_local_index)
+	std::vector<LocalData<D, T>> getLocalDatas(int patch_local_index)
 	{
-		std::vector<LocalData<D>> local_datas;
+		std::vector<LocalData<D, T>> local_datas;
 		local_datas.reserve(num_components);
 		for (int c = 0; c < num_components; c++) {
 			local_datas.emplace_back(std::move(getLocalData(c, patch_local_index)));
@@ -141,11 +172,11 @@ template <int D> class Vector
 	 * index of LocalData object will correspond to component index
 	 *
 	 * @param patch_local_index the local index of the patch
-	 * @return LocalData<D> the LocalData object
+	 * @return LocalData<D, T> the LocalData object
 	 */
-	const std::vector<LocalData<D>> getLocalDatas(int patch_local_index) const
+	const std::vector<LocalData<D, T>> getLocalDatas(int patch_local_index) const
 	{
-		std::vector<LocalData<D>> local_datas;
+		std::vector<LocalData<D, T>> local_datas;
 		local_datas.reserve(num_components);
 		for (int c = 0; c < num_components; c++) {
 			local_datas.emplace_back(std::move(getLocalData(c, patch_local_index)));
@@ -161,10 +192,15 @@ template <int D> class Vector
 	virtual void set(double alpha)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>> lds = getLocalDatas(i);
+			std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (auto &ld : lds) {
-				nested_loop<D>(ld.getStart(), ld.getEnd(),
-				               [&](std::array<int, D> coord) { ld[coord] = alpha; });
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &, T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = alpha;
+					}
+				});
 			}
 		}
 	}
@@ -176,10 +212,15 @@ template <int D> class Vector
 	virtual void setWithGhost(double alpha)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>> lds = getLocalDatas(i);
+			std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (auto &ld : lds) {
-				nested_loop<D>(ld.getGhostStart(), ld.getGhostEnd(),
-				               [&](std::array<int, D> coord) { ld[coord] = alpha; });
+				int n      = ld.getLengths()[0] + 2 * ld.getNumGhostCells();
+				int stride = ld.getStrides()[0];
+				ld.forEachLineWithGhosts([&](const std::array<int, D> &, T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = alpha;
+					}
+				});
 			}
 		}
 	}
@@ -191,10 +232,15 @@ template <int D> class Vector
 	virtual void scale(double alpha)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>> lds = getLocalDatas(i);
+			std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (auto &ld : lds) {
-				nested_loop<D>(ld.getStart(), ld.getEnd(),
-				               [&](std::array<int, D> coord) { ld[coord] *= alpha; });
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &, T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] *= alpha;
+					}
+				});
 			}
 		}
 	}
@@ -206,10 +252,15 @@ template <int D> class Vector
 	virtual void shift(double delta)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>> lds = getLocalDatas(i);
+			std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (auto &ld : lds) {
-				nested_loop<D>(ld.getStart(), ld.getEnd(),
-				               [&](std::array<int, D> coord) { ld[coord] += delta; });
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &, T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] += delta;
+					}
+				});
 			}
 		}
 	}
@@ -218,14 +269,47 @@ template <int D> class Vector
 	 *
 	 * @param b the other vector
 	 */
-	virtual void copy(std::shared_ptr<const Vector<D>> b)
+	virtual void copy(std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(),
-				               [&](std::array<int, D> coord) { lds[c][coord] = lds_b[c][coord]; });
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = line_b[xi * stride_b];
+					}
+				});
+			}
+		}
+	}
+	/**
+	 * @brief copy the values of a vector with a different scalar type, converting each value
+	 *
+	 * This is how values are moved between the levels of a mixed-precision solve.
+	 *
+	 * @tparam U the scalar type of the other vector
+	 * @param b the other vector
+	 */
+	template <typename U> void copyWithConversion(const Vector<D, U> &b)
+	{
+		for (int i = 0; i < num_local_patches; i++) {
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, U>> lds_b = b.getLocalDatas(i);
+			for (int c = 0; c < num_components; c++) {
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const U *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = static_cast<T>(line_b[xi * stride_b]);
+					}
+				});
 			}
 		}
 	}
@@ -234,28 +318,41 @@ template <int D> class Vector
 	 *
 	 * @param b the other vector
 	 */
-	virtual void add(std::shared_ptr<const Vector<D>> b)
+	virtual void add(std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(),
-				               [&](std::array<int, D> coord) { lds[c][coord] += lds_b[c][coord]; });
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] += line_b[xi * stride_b];
+					}
+				});
 			}
 		}
 	}
 	/**
 	 * @brief `this = this + alpha * b`
 	 */
-	virtual void addScaled(double alpha, std::shared_ptr<const Vector<D>> b)
+	virtual void addScaled(double alpha, std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(), [&](std::array<int, D> coord) {
-					lds[c][coord] += lds_b[c][coord] * alpha;
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] += line_b[xi * stride_b] * alpha;
+					}
 				});
 			}
 		}
@@ -263,16 +360,25 @@ template <int D> class Vector
 	/**
 	 * @brief `this = this + alpha * a + beta * b`
 	 */
-	virtual void addScaled(double alpha, std::shared_ptr<const Vector<D>> a, double beta,
-	                       std::shared_ptr<const Vector<D>> b)
+	virtual void addScaled(double alpha, std::shared_ptr<const Vector<D, T>> a, double beta,
+	                       std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_a = a->getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_a = a->getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(), [&](std::array<int, D> coord) {
-					lds[c][coord] += lds_a[c][coord] * alpha + lds_b[c][coord] * beta;
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_a = lds_a[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_a = lds_a[c].getPtr(coord);
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride]
+						+= line_a[xi * stride_a] * alpha + line_b[xi * stride_b] * beta;
+					}
 				});
 			}
 		}
@@ -280,14 +386,20 @@ template <int D> class Vector
 	/**
 	 * @brief `this = alpha * this + b`
 	 */
-	virtual void scaleThenAdd(double alpha, std::shared_ptr<const Vector<D>> b)
+	virtual void scaleThenAdd(double alpha, std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(), [&](std::array<int, D> coord) {
-					lds[c][coord] = alpha * lds[c][coord] + lds_b[c][coord];
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = alpha * line[xi * stride] + line_b[xi * stride_b];
+					}
 				});
 			}
 		}
@@ -295,14 +407,22 @@ template <int D> class Vector
 	/**
 	 * @brief `this = alpha * this + beta * b`
 	 */
-	virtual void scaleThenAddScaled(double alpha, double beta, std::shared_ptr<const Vector<D>> b)
+	virtual void scaleThenAddScaled(double alpha, double beta,
+	                                std::shared_ptr<const Vector<D, T>> b)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(), [&](std::array<int, D> coord) {
-					lds[c][coord] = alpha * lds[c][coord] + beta * lds_b[c][coord];
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride]
+						= alpha * line[xi * stride] + beta * line_b[xi * stride_b];
+					}
 				});
 			}
 		}
@@ -310,18 +430,26 @@ template <int D> class Vector
 	/**
 	 * @brief `this = alpha * this + beta * b + gamma * c`
 	 */
-	virtual void scaleThenAddScaled(double alpha, double beta, std::shared_ptr<const Vector<D>> b,
-	                                double gamma, std::shared_ptr<const Vector<D>> c)
+	virtual void scaleThenAddScaled(double alpha, double beta,
+	                                std::shared_ptr<const Vector<D, T>> b, double gamma,
+	                                std::shared_ptr<const Vector<D, T>> c)
 	{
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_c = c->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_c = c->getLocalDatas(i);
 			for (int comp = 0; comp < num_components; comp++) {
-				nested_loop<D>(
-				lds[comp].getStart(), lds[comp].getEnd(), [&](std::array<int, D> coord) {
-					lds[comp][coord] = alpha * lds[comp][coord] + beta * lds_b[comp][coord]
-					                   + gamma * lds_c[comp][coord];
+				int n        = lds[comp].getLengths()[0];
+				int stride   = lds[comp].getStrides()[0];
+				int stride_b = lds_b[comp].getStrides()[0];
+				int stride_c = lds_c[comp].getStrides()[0];
+				lds[comp].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[comp].getPtr(coord);
+					const T *line_c = lds_c[comp].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						line[xi * stride] = alpha * line[xi * stride] + beta * line_b[xi * stride_b]
+						                    + gamma * line_c[xi * stride_c];
+					}
 				});
 			}
 		}
@@ -333,10 +461,15 @@ template <int D> class Vector
 	{
 		double sum = 0;
 		for (int i = 0; i < num_local_patches; i++) {
-			const std::vector<LocalData<D>> lds = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (const auto &ld : lds) {
-				nested_loop<D>(ld.getStart(), ld.getEnd(),
-				               [&](std::array<int, D> coord) { sum += ld[coord] * ld[coord]; });
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &, const T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						sum += line[xi * stride] * line[xi * stride];
+					}
+				});
 			}
 		}
 		double global_sum;
@@ -350,10 +483,15 @@ template <int D> class Vector
 	{
 		double max = 0;
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>> lds = getLocalDatas(i);
+			std::vector<LocalData<D, T>> lds = getLocalDatas(i);
 			for (const auto &ld : lds) {
-				nested_loop<D>(ld.getStart(), ld.getEnd(),
-				               [&](std::array<int, D> coord) { max = fmax(fabs(ld[coord]), max); });
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &, const T *line) {
+					for (int xi = 0; xi < n; xi++) {
+						max = fmax(fabs(line[xi * stride]), max);
+					}
+				});
 			}
 		}
 		double global_max;
@@ -363,25 +501,187 @@ template <int D> class Vector
 	/**
 	 * @brief get the dot product
 	 */
-	virtual double dot(std::shared_ptr<const Vector<D>> b) const
+	virtual double dot(std::shared_ptr<const Vector<D, T>> b) const
+	{
+		double retval = localDot(b);
+		double global_retval;
+		MPI_Allreduce(&retval, &global_retval, 1, MPI_DOUBLE, MPI_SUM, comm);
+		return global_retval;
+	}
+	/**
+	 * @brief Get the local (unreduced) dot product of this vector with another vector
+	 *
+	 * @param b the other vector
+	 * @return double the local dot product
+	 */
+	virtual double localDot(std::shared_ptr<const Vector<D, T>> b) const
 	{
 		double retval = 0;
 		for (int i = 0; i < num_local_patches; i++) {
-			std::vector<LocalData<D>>       lds   = getLocalDatas(i);
-			const std::vector<LocalData<D>> lds_b = b->getLocalDatas(i);
+			std::vector<LocalData<D, T>>       lds   = getLocalDatas(i);
+			const std::vector<LocalData<D, T>> lds_b = b->getLocalDatas(i);
 			for (int c = 0; c < num_components; c++) {
-				nested_loop<D>(lds[c].getStart(), lds[c].getEnd(), [&](std::array<int, D> coord) {
-					retval += lds[c][coord] * lds_b[c][coord];
+				int n        = lds[c].getLengths()[0];
+				int stride   = lds[c].getStrides()[0];
+				int stride_b = lds_b[c].getStrides()[0];
+				lds[c].forEachLine([&](const std::array<int, D> &coord, T *line) {
+					const T *line_b = lds_b[c].getPtr(coord);
+					for (int xi = 0; xi < n; xi++) {
+						retval += line[xi * stride] * line_b[xi * stride_b];
+					}
 				});
 			}
 		}
-		double global_retval;
-		MPI_Allreduce(&retval, &global_retval, 1, MPI_DOUBLE, MPI_SUM, comm);
-		return global_retval;
+		return retval;
+	}
+	/**
+	 * @brief Get the local (unreduced) dot products of this vector with each of the other vectors
+	 *
+	 * All the dot products are calculated in a single pass over this vector.
+	 *
+	 * @param bs the other vectors
+	 * @param sums array of size bs.size() + 1. The first bs.size() entries will be set to the local
+	 * dot product with the corresponding vector in bs, and the last entry will be set to the local
+	 * dot product of this vector with itself.
+	 */
+	virtual void localMultiDot(const std::vector<std::shared_ptr<const Vector<D, T>>> &bs,
+	                           double *                                                sums) const
+	{
+		size_t num_bs = bs.size();
+		std::fill(sums, sums + num_bs + 1, 0.0);
+		std::vector<LocalData<D, T>> lds_b(num_bs);
+		std::vector<const T *>       lines_b(num_bs);
+		std::vector<int>             strides_b(num_bs);
+		for (int i = 0; i < num_local_patches; i++) {
+			for (int c = 0; c < num_components; c++) {
+				const LocalData<D, T> ld = getLocalData(c, i);
+				for (size_t j = 0; j < num_bs; j++) {
+					lds_b[j]     = bs[j]->getLocalData(c, i);
+					strides_b[j] = lds_b[j].getStrides()[0];
+				}
+				int n      = ld.getLengths()[0];
+				int stride = ld.getStrides()[0];
+				ld.forEachLine([&](const std::array<int, D> &coord, const T *line) {
+					for (size_t j = 0; j < num_bs; j++) {
+						lines_b[j] = lds_b[j].getPtr(coord);
+					}
+					for (int xi = 0; xi < n; xi++) {
+						double value = line[xi * stride];
+						for (size_t j = 0; j < num_bs; j++) {
+							sums[j] += value * lines_b[j][xi * strides_b[j]];
+						}
+						sums[num_bs] += value * value;
+					}
+				});
+			}
+		}
+	}
+	/**
+	 * @brief get the dot products of this vector with each of the other vectors
+	 *
+	 * This only does a single pass over this vector, and a single MPI_Allreduce
+	 *
+	 * @param bs the other vectors
+	 * @return std::vector<double> the dot products, in the same order as bs
+	 */
+	std::vector<double> multiDot(const std::vector<std::shared_ptr<const Vector<D, T>>> &bs) const
+	{
+		std::vector<double> local_sums(bs.size() + 1);
+		localMultiDot(bs, local_sums.data());
+		std::vector<double> global_sums(bs.size());
+		MPI_Allreduce(local_sums.data(), global_sums.data(), bs.size(), MPI_DOUBLE, MPI_SUM, comm);
+		return global_sums;
+	}
+	/**
+	 * @brief get the dot products of this vector with each of the other vectors, along with the
+	 * dot product of this vector with itself
+	 *
+	 * This only does a single pass over this vector, and a single MPI_Allreduce
+	 *
+	 * @param bs the other vectors
+	 * @return std::vector<double> the dot products, in the same order as bs, followed by the dot
+	 * product of this vector with itself
+	 */
+	std::vector<double>
+	multiDotAndSelfDot(const std::vector<std::shared_ptr<const Vector<D, T>>> &bs) const
+	{
+		std::vector<double> local_sums(bs.size() + 1);
+		localMultiDot(bs, local_sums.data());
+		std::vector<double> global_sums(bs.size() + 1);
+		MPI_Allreduce(local_sums.data(), global_sums.data(), bs.size() + 1, MPI_DOUBLE, MPI_SUM,
+		              comm);
+		return global_sums;
+	}
+	/**
+	 * @brief get the dot products of this vector with each of the other vectors, along with the
+	 * l2norm of this vector
+	 *
+	 * This only does a single pass over this vector, and a single MPI_Allreduce
+	 *
+	 * @param bs the other vectors
+	 * @return std::vector<double> the dot products, in the same order as bs, followed by the l2norm
+	 */
+	std::vector<double>
+	multiDotAndTwoNorm(const std::vector<std::shared_ptr<const Vector<D, T>>> &bs) const
+	{
+		std::vector<double> global_sums = multiDotAndSelfDot(bs);
+		global_sums.back()              = sqrt(global_sums.back());
+		return global_sums;
+	}
+	/**
+	 * @brief Start a non-blocking dot product
+	 *
+	 * The local part of the dot product is calculated before returning, then the reduction is
+	 * started with MPI_Iallreduce. Use dotFinish to get the result.
+	 *
+	 * @param b the other vector
+	 * @return ReductionRequest the request to pass to dotFinish
+	 */
+	ReductionRequest dotStart(std::shared_ptr<const Vector<D, T>> b) const
+	{
+		double local_sum = localDot(b);
+		return ReductionRequest(&local_sum, 1, MPI_SUM, comm);
+	}
+	/**
+	 * @brief Finish a non-blocking dot product started with dotStart
+	 *
+	 * @param request the request returned by dotStart
+	 * @return double the dot product
+	 */
+	double dotFinish(ReductionRequest &request) const
+	{
+		return request.wait()[0];
+	}
+	/**
+	 * @brief Start a non-blocking l2norm
+	 *
+	 * The local part of the norm is calculated before returning, then the reduction is started
+	 * with MPI_Iallreduce. Use twoNormFinish to get the result.
+	 *
+	 * @return ReductionRequest the request to pass to twoNormFinish
+	 */
+	ReductionRequest twoNormStart() const
+	{
+		double local_sum;
+		localMultiDot({}, &local_sum);
+		return ReductionRequest(&local_sum, 1, MPI_SUM, comm);
+	}
+	/**
+	 * @brief Finish a non-blocking l2norm started with twoNormStart
+	 *
+	 * @param request the request returned by twoNormStart
+	 * @return double the l2norm
+	 */
+	double twoNormFinish(ReductionRequest &request) const
+	{
+		return sqrt(request.wait()[0]);
 	}
 };
 extern template class Vector<1>;
 extern template class Vector<2>;
 extern template class Vector<3>;
+extern template class Vector<1, float>;
+extern template class Vector<2, float>;
+extern template class Vector<3, float>;
 } // namespace ThunderEgg
 #endif
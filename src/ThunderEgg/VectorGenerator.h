@@ -37,8 +37,9 @@ namespace ThunderEgg
  * This is used in various ThunderEgg classes to generate needed work vectors
  *
  * @tparam D the number of Cartesian dimensions
+ * @tparam T the scalar type of the values
  */
-template <int D> class VectorGenerator
+template <int D, typename T = double> class VectorGenerator
 {
 	public:
 	/**
@@ -48,9 +49,9 @@ template <int D> class VectorGenerator
 	/**
 	 * @brief Get a new Vector
 	 *
-	 * @return std::shared_ptr<Vector<D>> the Vector
+	 * @return std::shared_ptr<Vector<D, T>> the Vector
 	 */
-	virtual std::shared_ptr<Vector<D>> getNewVector() const = 0;
+	virtual std::shared_ptr<Vector<D, T>> getNewVector() const = 0;
 };
 } // namespace ThunderEgg
 #endif
@@ -2,6 +2,8 @@
 #include "catch.hpp"
 #include "utils/DomainReader.h"
 #include <ThunderEgg/BiCGStabPatchSolver.h>
+#include <ThunderEgg/BiLinearGhostFiller.h>
+#include <ThunderEgg/Poisson/StarPatchOperator.h>
 #include <ThunderEgg/ValVector.h>
 #include <list>
 #include <sstream>
@@ -110,4 +112,20 @@ TEST_CASE("BiCGStabPatchSolver does not propagate BreakdownError", "[BiCGStabPat
 	BiCGStabPatchSolver<2> bcgs_solver(mpo, -1, 1000, true);
 
 	CHECK_NOTHROW(bcgs_solver.smooth(f, u));
-}
\ No newline at end of file
+}
+TEST_CASE("BiCGStabPatchSolver is only thread safe with MPI_THREAD_MULTIPLE",
+          "[BiCGStabPatchSolver]")
+{
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(cross_mesh_file, {4, 4}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf = make_shared<BiLinearGhostFiller>(d_fine);
+	auto op = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	int provided;
+	MPI_Query_thread(&provided);
+
+	BiCGStabPatchSolver<2> bcgs_solver(op);
+	CHECK(bcgs_solver.isThreadSafe() == (provided == MPI_THREAD_MULTIPLE));
+}
@@ -177,6 +177,15 @@ class MockVector : public Vector<2>
 			return norm_calls * 1e6;
 		}
 	}
+	void localMultiDot(const std::vector<std::shared_ptr<const Vector<2>>> &bs,
+	                   double *                                             sums) const override
+	{
+		for (size_t j = 0; j < bs.size(); j++) {
+			sums[j] = dot_value;
+		}
+		double norm     = twoNorm();
+		sums[bs.size()] = norm * norm;
+	}
 };
 class MockVectorGenerator : public VectorGenerator<2>
 {
@@ -117,4 +117,262 @@ TEST_CASE("exchange various meshes 2D BiLinearGhostFiller ghost already set",
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("exchange various meshes 2D BiLinearGhostFiller other backends match point-to-point",
+          "[BiLinearGhostFiller]")
+{
+	auto backend
+	= GENERATE(GhostExchangeBackend::NeighborCollective, GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 10);
+	auto ny        = GENERATE(2, 10);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 2);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 2);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return 1 + ((x * 0.3) + y);
+	};
+
+	DomainTools::SetValues<2>(d, vec, f, f);
+	DomainTools::SetValues<2>(d, expected, f, f);
+
+	BiLinearGhostFiller other_blgf(d, backend);
+	other_blgf.fillGhost(vec);
+	BiLinearGhostFiller blgf(d);
+	blgf.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 2; c++) {
+			LocalData<2> vec_ld      = vec->getLocalData(c, pinfo->local_index);
+			LocalData<2> expected_ld = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 2> &coord) {
+				               ///
+				               REQUIRE(vec_ld[coord] == expected_ld[coord]);
+			               });
+		}
+	}
+}
+TEST_CASE("exchange various meshes 2D BiLinearGhostFiller interleaved matches separate components",
+          "[BiLinearGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 10);
+	auto ny        = GENERATE(2, 10);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	ValVectorStorage storage;
+	storage.interleaved = true;
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 2, storage);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 2);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return 1 + ((x * 0.3) + y);
+	};
+	auto g = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return 99 + ((x * 7) + y * 0.1);
+	};
+
+	DomainTools::SetValues<2>(d, vec, f, g);
+	DomainTools::SetValues<2>(d, expected, f, g);
+
+	BiLinearGhostFiller blgf(d, backend);
+	blgf.fillGhost(vec);
+	blgf.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 2; c++) {
+			INFO("component: " << c);
+			LocalData<2> vec_ld      = vec->getLocalData(c, pinfo->local_index);
+			LocalData<2> expected_ld = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 2> &coord) {
+				               INFO("coord:  " << coord[0] << ", " << coord[1]);
+				               CHECK(vec_ld[coord] == expected_ld[coord]);
+			               });
+		}
+	}
+}
+TEST_CASE("exchange various meshes 2D BiLinearGhostFiller in single precision matches double",
+          "[BiLinearGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 10);
+	auto ny        = GENERATE(2, 10);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2, float>> vec      = ValVector<2, float>::GetNewVector(d, 2);
+	shared_ptr<ValVector<2>>        expected = ValVector<2>::GetNewVector(d, 2);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return 1 + ((x * 0.3) + y);
+	};
+
+	DomainTools::SetValues<2>(d, expected, f, f);
+	vec->copyWithConversion(*expected);
+
+	BasicBiLinearGhostFiller<float> float_blgf(d, backend);
+	float_blgf.fillGhost(vec);
+	BiLinearGhostFiller blgf(d, backend);
+	blgf.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 2; c++) {
+			LocalData<2, float> vec_ld      = vec->getLocalData(c, pinfo->local_index);
+			LocalData<2>        expected_ld = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 2> &coord) {
+				               ///
+				               REQUIRE(vec_ld[coord] == Approx(expected_ld[coord]).epsilon(1e-6));
+			               });
+		}
+	}
+}
+TEST_CASE("exchange various meshes 2D BiLinearGhostFiller fills corner ghosts",
+          "[BiLinearGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 1);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 1);
+
+	// values from neighbors on the same level are copied, so a linear function is exact on a
+	// uniform mesh. Across refinement levels only a constant function is exact.
+	bool uniform_mesh = mesh_file == uniform;
+	auto f            = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return uniform_mesh ? 1 + x * 0.3 + y : 2.5;
+	};
+
+	DomainTools::SetValues<2>(d, vec, f);
+	DomainTools::SetValuesWithGhost<2>(d, expected, f);
+
+	BiLinearGhostFiller blgf(d, backend, true);
+	blgf.fillGhost(vec);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> expected_ld = expected->getLocalData(0, pinfo->local_index);
+		auto check_diagonal_ghost = [&](const array<int, 2> &coord) {
+			int num_outside = 0;
+			for (int i = 0; i < 2; i++) {
+				num_outside += coord[i] < 0 || coord[i] >= pinfo->ns[i];
+			}
+			std::array<double, 2> real_coord;
+			DomainTools::GetRealCoordGhost<2>(pinfo, coord, real_coord);
+			bool in_domain = true;
+			for (double x : real_coord) {
+				in_domain = in_domain && x > 0 && x < 1;
+			}
+			if (num_outside >= 2 && in_domain) {
+				INFO("coord: " << coord[0] << " " << coord[1]);
+				CHECK(vec_ld[coord] == Approx(expected_ld[coord]));
+			}
+		};
+		nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(), check_diagonal_ghost);
+	}
+}
+TEST_CASE("BiLinearGhostFiller overwrites stale ghost values", "[BiLinearGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 5);
+	auto ny        = GENERATE(2, 5);
+	int  num_ghost = GENERATE(1, 2);
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 1);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 1);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		double value = 1;
+		for (double x : coord) {
+			value = value * exp(x) + 1.0 / 3.0;
+		}
+		return value;
+	};
+	auto stale = [&](const std::array<double, 2> coord) -> double {
+		return 1e10;
+	};
+
+	DomainTools::SetValuesWithGhost<2>(d, vec, stale);
+	DomainTools::SetValues<2>(d, vec, f);
+	DomainTools::SetValues<2>(d, expected, f);
+
+	BiLinearGhostFiller filler(d, backend);
+	filler.fillGhost(vec);
+	filler.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> expected_ld = expected->getLocalData(0, pinfo->local_index);
+		for (Side<2> s : Side<2>::getValues()) {
+			if (pinfo->hasNbr(s)) {
+				INFO("side:      " << s);
+				for (int i = 0; i < num_ghost; i++) {
+					LocalData<1> vec_ghost      = vec_ld.getGhostSliceOnSide(s, i + 1);
+					LocalData<1> expected_ghost = expected_ld.getGhostSliceOnSide(s, i + 1);
+					nested_loop<1>(vec_ghost.getStart(), vec_ghost.getEnd(),
+					               [&](const array<int, 1> &coord) {
+						               CHECK(vec_ghost[coord] == expected_ghost[coord]);
+					               });
+				}
+			}
+		}
+	}
+}
@@ -117,4 +117,61 @@ TEST_CASE("exchange various meshes 2D BiLinearGhostFiller ghost already set",
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("exchange various meshes 2D BiLinearGhostFiller fills corner ghosts",
+          "[BiLinearGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 1);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 1);
+
+	// values from neighbors on the same level are copied, so a linear function is exact on a
+	// uniform mesh. Across refinement levels only a constant function is exact.
+	bool uniform_mesh = mesh_file == uniform;
+	auto f            = [&](const std::array<double, 2> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		return uniform_mesh ? 1 + x * 0.3 + y : 2.5;
+	};
+
+	DomainTools::SetValues<2>(d, vec, f);
+	DomainTools::SetValuesWithGhost<2>(d, expected, f);
+
+	BiLinearGhostFiller blgf(d, backend, true);
+	blgf.fillGhost(vec);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> expected_ld = expected->getLocalData(0, pinfo->local_index);
+		auto check_diagonal_ghost = [&](const array<int, 2> &coord) {
+			int num_outside = 0;
+			for (int i = 0; i < 2; i++) {
+				num_outside += coord[i] < 0 || coord[i] >= pinfo->ns[i];
+			}
+			std::array<double, 2> real_coord;
+			DomainTools::GetRealCoordGhost<2>(pinfo, coord, real_coord);
+			bool in_domain = true;
+			for (double x : real_coord) {
+				in_domain = in_domain && x > 0 && x < 1;
+			}
+			if (num_outside >= 2 && in_domain) {
+				INFO("coord: " << coord[0] << " " << coord[1]);
+				CHECK(vec_ld[coord] == Approx(expected_ld[coord]));
+			}
+		};
+		nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(), check_diagonal_ghost);
+	}
+}
@@ -516,4 +516,67 @@ TEST_CASE("exchange various meshes 2D BiQuadraticGhostFiller ghost already set t
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+namespace
+{
+/**
+ * @brief a BiQuadraticGhostFiller that fills ghosts without the compiled table
+ */
+class NoStencilBiQuadraticGhostFiller : public BiQuadraticGhostFiller
+{
+	public:
+	using BiQuadraticGhostFiller::BiQuadraticGhostFiller;
+	bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo,
+	                          std::vector<GhostFillTerm<2>> &     terms) const override
+	{
+		return false;
+	}
+};
+} // namespace
+TEST_CASE("BiQuadraticGhostFiller compiled table matches the ghost fill",
+          "[BiQuadraticGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file,
+	                          cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(4, 7);
+	auto ny        = GENERATE(4, 7);
+	int  num_ghost = 1;
+
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<2>> vec      = ValVector<2>::GetNewVector(d, 2);
+	shared_ptr<ValVector<2>> expected = ValVector<2>::GetNewVector(d, 2);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		double value = 1;
+		for (double x : coord) {
+			value = value * exp(x) + 1.0 / 3.0;
+		}
+		return value;
+	};
+	auto g = [&](const std::array<double, 2> coord) -> double {
+		return sin(coord[0] + 2 * coord[1]);
+	};
+
+	DomainTools::SetValues<2>(d, vec, f, g);
+	DomainTools::SetValues<2>(d, expected, f, g);
+
+	BiQuadraticGhostFiller          filler(d);
+	NoStencilBiQuadraticGhostFiller no_stencil_filler(d);
+	filler.fillGhost(vec);
+	no_stencil_filler.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 2; c++) {
+			LocalData<2> vec_ld      = vec->getLocalData(c, pinfo->local_index);
+			LocalData<2> expected_ld = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 2> &coord) {
+				               CHECK(vec_ld[coord] == Approx(expected_ld[coord]).margin(1e-12));
+			               });
+		}
+	}
+}
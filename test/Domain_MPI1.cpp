@@ -1,4 +1,5 @@
 #include "catch.hpp"
+#include "utils/DomainReader.h"
 #include <ThunderEgg/Domain.h>
 using namespace std;
 using namespace ThunderEgg;
@@ -148,3 +149,110 @@ TEST_CASE("Domain to_json", "[Domain]")
 	REQUIRE(j.size() == 1);
 	REQUIRE(j[0]["id"] == 0);
 }
+TEST_CASE("Domain findDiagonalNbrs uniform 2D", "[Domain]")
+{
+	auto n         = GENERATE(2, 4);
+	int  num_ghost = GENERATE(1, 2);
+
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	auto infos = d->findDiagonalNbrs();
+
+	// each patch has a single corner neighbor
+	REQUIRE(infos.size() == 4);
+	for (auto &info : infos) {
+		CHECK(info.nbr_type == NbrType::Normal);
+		CHECK(info.local_index != -1);
+		CHECK(info.nbr_local_index != -1);
+		CHECK(info.getNumCells() == num_ghost * num_ghost);
+		for (int i = 0; i < 2; i++) {
+			CHECK(info.direction[i] != 0);
+			CHECK(info.offset[i] == -info.direction[i] * n);
+			if (info.direction[i] == -1) {
+				CHECK(info.start[i] == -num_ghost);
+				CHECK(info.end[i] == -1);
+			} else {
+				CHECK(info.start[i] == n);
+				CHECK(info.end[i] == n + num_ghost - 1);
+			}
+		}
+	}
+}
+TEST_CASE("Domain findDiagonalNbrs uniform 3D", "[Domain]")
+{
+	auto n         = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<3> domain_reader("mesh_inputs/3d_uniform_2x2x2_mpi1.json", {n, n, n}, num_ghost);
+	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
+
+	auto infos = d->findDiagonalNbrs();
+
+	// each patch has three edge neighbors and one corner neighbor
+	REQUIRE(infos.size() == 8 * 4);
+	int num_corners = 0;
+	for (auto &info : infos) {
+		CHECK(info.nbr_type == NbrType::Normal);
+		int num_nonzero = 0;
+		for (int i = 0; i < 3; i++) {
+			num_nonzero += info.direction[i] != 0;
+		}
+		if (num_nonzero == 3) {
+			num_corners++;
+			CHECK(info.getNumCells() == 1);
+		} else {
+			CHECK(info.getNumCells() == n);
+		}
+	}
+	CHECK(num_corners == 8);
+}
+TEST_CASE("Domain findDiagonalNbrs ranges lie in the ghost cells and the neighbor", "[Domain]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, "mesh_inputs/2d_uniform_2x2_refined_nw_mpi1.json",
+	                          "mesh_inputs/2d_uniform_8x8_refined_cross_mpi1.json");
+	INFO("MESH: " << mesh_file);
+	auto n         = GENERATE(2, 4);
+	int  num_ghost = GENERATE(1, 2);
+
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	auto infos = d->findDiagonalNbrs();
+
+	bool has_coarse = false;
+	bool has_fine   = false;
+	for (auto &info : infos) {
+		INFO("id: " << info.id << " nbr_id: " << info.nbr_id);
+		has_coarse = has_coarse || info.nbr_type == NbrType::Coarse;
+		has_fine   = has_fine || info.nbr_type == NbrType::Fine;
+		for (int i = 0; i < 2; i++) {
+			int lower = -num_ghost;
+			int upper = -1;
+			if (info.direction[i] == 0) {
+				lower = 0;
+				upper = n - 1;
+			} else if (info.direction[i] == 1) {
+				lower = n;
+				upper = n + num_ghost - 1;
+			}
+			CHECK(info.start[i] >= lower);
+			CHECK(info.end[i] <= upper);
+			CHECK(info.start[i] <= info.end[i]);
+
+			int nbr_lower = info.start[i] + info.offset[i];
+			int nbr_upper = info.end[i] + info.offset[i];
+			if (info.nbr_type == NbrType::Coarse) {
+				nbr_lower /= 2;
+				nbr_upper /= 2;
+			} else if (info.nbr_type == NbrType::Fine) {
+				nbr_lower = 2 * info.start[i] + info.offset[i];
+				nbr_upper = 2 * info.end[i] + info.offset[i] + 1;
+			}
+			CHECK(nbr_lower >= 0);
+			CHECK(nbr_upper <= n - 1);
+		}
+	}
+	CHECK(has_coarse);
+	CHECK(has_fine);
+}
@@ -0,0 +1,40 @@
+#include "catch.hpp"
+#include "utils/DomainReader.h"
+#include <ThunderEgg/Domain.h>
+using namespace std;
+using namespace ThunderEgg;
+TEST_CASE("Domain findDiagonalNbrs uniform 2D MPI3", "[Domain]")
+{
+	auto n         = GENERATE(2, 4);
+	int  num_ghost = GENERATE(1, 2);
+
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi3.json", {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d = domain_reader.getFinerDomain();
+
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	auto infos = d->findDiagonalNbrs();
+
+	// each pair is found on the rank of the patch and on the rank of the neighbor
+	int num_patch_infos = 0;
+	int num_nbr_infos   = 0;
+	for (auto &info : infos) {
+		INFO("id: " << info.id << " nbr_id: " << info.nbr_id);
+		CHECK((info.rank == rank || info.nbr_rank == rank));
+		CHECK((info.local_index != -1) == (info.rank == rank));
+		CHECK((info.nbr_local_index != -1) == (info.nbr_rank == rank));
+		CHECK(info.nbr_type == NbrType::Normal);
+		CHECK(info.getNumCells() == num_ghost * num_ghost);
+		num_patch_infos += info.rank == rank;
+		num_nbr_infos += info.nbr_rank == rank;
+	}
+	int global_num_patch_infos;
+	int global_num_nbr_infos;
+	MPI_Allreduce(&num_patch_infos, &global_num_patch_infos, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	MPI_Allreduce(&num_nbr_infos, &global_num_nbr_infos, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+	// each patch has a single corner neighbor
+	CHECK(global_num_patch_infos == 4);
+	CHECK(global_num_nbr_infos == 4);
+}
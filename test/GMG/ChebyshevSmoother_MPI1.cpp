@@ -0,0 +1,70 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "../utils/DomainReader.h"
+#include "../utils/SmootherFixtures.h"
+#include "catch.hpp"
+#include <ThunderEgg/GMG/ChebyshevSmoother.h>
+using namespace std;
+using namespace ThunderEgg;
+TEST_CASE("ChebyshevSmoother estimates the largest eigenvalue", "[GMG::ChebyshevSmoother]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto type = GENERATE(as<std::string>{}, "Poisson", "Neumann", "VarPoisson");
+	INFO("OPERATOR: " << type);
+	DomainReader<2>       domain_reader(mesh_file, {8, 8}, 1, type == "Neumann");
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	GMG::ChebyshevSmoother<2> smoother(GetOperator(d_fine, type), 2, 20);
+	// the largest eigenvalue of the diagonally scaled Laplacian is just under 2
+	CHECK(smoother.getMaxEigenvalueEstimate() > 1.5);
+	CHECK(smoother.getMaxEigenvalueEstimate() < 2.1);
+}
+TEST_CASE("ChebyshevSmoother getDegree", "[GMG::ChebyshevSmoother]")
+{
+	DomainReader<2>       domain_reader(uniform_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto degree = GENERATE(1, 2, 5);
+
+	GMG::ChebyshevSmoother<2> smoother(GetOperator(d_fine, "Poisson"), degree);
+	CHECK(smoother.getDegree() == degree);
+}
+TEST_CASE("ChebyshevSmoother throws exception for degree less than 1", "[GMG::ChebyshevSmoother]")
+{
+	DomainReader<2>       domain_reader(uniform_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto op = GetOperator(d_fine, "Poisson");
+	CHECK_THROWS_AS(GMG::ChebyshevSmoother<2>(op, 0), RuntimeError);
+}
+TEST_CASE("ChebyshevSmoother throws exception for a zero on the diagonal",
+          "[GMG::ChebyshevSmoother]")
+{
+	DomainReader<2>       domain_reader(uniform_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf    = make_shared<BiLinearGhostFiller>(d_fine);
+	auto h_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	auto op    = make_shared<VarPoisson::StarPatchOperator<2>>(h_vec, d_fine, gf);
+	CHECK_THROWS_AS(GMG::ChebyshevSmoother<2>(op), RuntimeError);
+}
@@ -19,8 +19,11 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  ***************************************************************************/
 
+#include "../utils/DomainReader.h"
 #include "catch.hpp"
+#include <ThunderEgg/BiLinearGhostFiller.h>
 #include <ThunderEgg/GMG/CycleBuilder.h>
+#include <ThunderEgg/Poisson/StarPatchOperator.h>
 #include <ThunderEgg/ValVector.h>
 #include <memory>
 using namespace std;
@@ -770,4 +773,96 @@ TEST_CASE("CycleBuilder getCycle throws exception if no calls are made", "[GMG::
 	GMG::CycleBuilder<2> builder(opts);
 
 	CHECK_THROWS_AS(builder.getCycle(), RuntimeError);
+}
+TEST_CASE("CycleBuilder selects smoothers with smoother_types", "[GMG::CycleBuilder]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {4, 4}, 1);
+	shared_ptr<Domain<2>> domain = domain_reader.getFinerDomain();
+	auto                  gf     = make_shared<BiLinearGhostFiller>(domain);
+	auto                  op     = make_shared<Poisson::StarPatchOperator<2>>(domain, gf);
+
+	auto smoother     = make_shared<MockSmoother>();
+	auto restrictor   = make_shared<MockRestrictor>();
+	auto interpolator = make_shared<MockInterpolator>();
+	auto vg           = make_shared<MockVectorGenerator>();
+
+	GMG::CycleOpts opts;
+	opts.smoother_types = {"given", "rbgs", "jacobi"};
+	opts.jacobi_weight  = 0.8;
+	opts.rbgs_weight    = 1.2;
+	GMG::CycleBuilder<2> builder(opts);
+	builder.addFinestLevel(op, smoother, restrictor, vg);
+	builder.addIntermediateLevel(op, nullptr, restrictor, interpolator, vg);
+	builder.addIntermediateLevel(op, nullptr, restrictor, interpolator, vg);
+	builder.addCoarsestLevel(op, nullptr, interpolator, vg);
+
+	auto level = builder.getCycle()->getFinestLevel();
+	CHECK(level->getSmoother() == smoother);
+
+	level = level->getCoarser();
+	auto rbgs
+	= dynamic_pointer_cast<const GMG::RedBlackGaussSeidelSmoother<2>>(level->getSmoother());
+	REQUIRE(rbgs != nullptr);
+	CHECK(rbgs->getWeight() == 1.2);
+
+	// the last entry is used for the rest of the levels
+	for (int i = 0; i < 2; i++) {
+		level       = level->getCoarser();
+		auto jacobi = dynamic_pointer_cast<const GMG::JacobiSmoother<2>>(level->getSmoother());
+		REQUIRE(jacobi != nullptr);
+		CHECK(jacobi->getWeight() == 0.8);
+	}
+}
+TEST_CASE("CycleBuilder selects a Chebyshev smoother with smoother_types", "[GMG::CycleBuilder]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {4, 4}, 1);
+	shared_ptr<Domain<2>> domain = domain_reader.getFinerDomain();
+	auto                  gf     = make_shared<BiLinearGhostFiller>(domain);
+	auto                  op     = make_shared<Poisson::StarPatchOperator<2>>(domain, gf);
+
+	auto restrictor   = make_shared<MockRestrictor>();
+	auto interpolator = make_shared<MockInterpolator>();
+	auto vg           = make_shared<MockVectorGenerator>();
+
+	GMG::CycleOpts opts;
+	opts.smoother_types   = {"chebyshev"};
+	opts.chebyshev_degree = 3;
+	GMG::CycleBuilder<2> builder(opts);
+	builder.addFinestLevel(op, nullptr, restrictor, vg);
+	builder.addCoarsestLevel(op, nullptr, interpolator, vg);
+
+	auto level = builder.getCycle()->getFinestLevel();
+	for (int i = 0; i < 2; i++) {
+		auto cheb = dynamic_pointer_cast<const GMG::ChebyshevSmoother<2>>(level->getSmoother());
+		REQUIRE(cheb != nullptr);
+		CHECK(cheb->getDegree() == 3);
+		level = level->getCoarser();
+	}
+}
+TEST_CASE("CycleBuilder smoother_types throws exception for an operator that isn't a PatchOperator",
+          "[GMG::CycleBuilder]")
+{
+	auto type = GENERATE(as<std::string>{}, "jacobi", "rbgs");
+
+	GMG::CycleOpts opts;
+	opts.smoother_types = {type};
+	GMG::CycleBuilder<2> builder(opts);
+
+	CHECK_THROWS_AS(builder.addFinestLevel(make_shared<MockOperator>(), make_shared<MockSmoother>(),
+	                                       make_shared<MockRestrictor>(),
+	                                       make_shared<MockVectorGenerator>()),
+	                RuntimeError);
+}
+TEST_CASE("CycleBuilder smoother_types throws exception for an unknown type", "[GMG::CycleBuilder]")
+{
+	GMG::CycleOpts opts;
+	opts.smoother_types = {"given", "sor"};
+	GMG::CycleBuilder<2> builder(opts);
+
+	builder.addFinestLevel(make_shared<MockOperator>(), make_shared<MockSmoother>(),
+	                       make_shared<MockRestrictor>(), make_shared<MockVectorGenerator>());
+	CHECK_THROWS_AS(builder.addCoarsestLevel(make_shared<MockOperator>(), nullptr,
+	                                         make_shared<MockInterpolator>(),
+	                                         make_shared<MockVectorGenerator>()),
+	                RuntimeError);
 }
\ No newline at end of file
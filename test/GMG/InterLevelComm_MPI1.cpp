@@ -135,4 +135,26 @@ TEST_CASE("1-processor sendGhostPatches on uniform 4x4", "[GMG::InterLevelComm]"
 			}
 		});
 	}
-}
\ No newline at end of file
+}TEST_CASE("1-processor InterLevelComm getExchangeBackend", "[GMG::InterLevelComm]")
+{
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
+	DomainReader<2>       domain_reader(mesh_file, {2, 2}, 1);
+	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
+	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
+	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, 1, d_fine, backend);
+
+	CHECK(ilc->getExchangeBackend() == backend);
+}
+TEST_CASE("1-processor InterLevelComm throws exception for SharedMemory backend",
+          "[GMG::InterLevelComm]")
+{
+	DomainReader<2>       domain_reader(mesh_file, {2, 2}, 1);
+	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
+	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
+
+	CHECK_THROWS_AS(
+	(GMG::InterLevelComm<2>(d_coarse, 1, d_fine, GhostExchangeBackend::SharedMemory)),
+	RuntimeError);
+}
@@ -118,6 +118,9 @@ TEST_CASE("2-processor getNewGhostVector on uniform quad", "[GMG::InterLevelComm
 }
 TEST_CASE("2-processor sendGhostPatches on uniform quad", "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -126,7 +129,8 @@ TEST_CASE("2-processor sendGhostPatches on uniform quad", "[GMG::InterLevelComm]
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	auto coarse_vec = ValVector<2>::GetNewVector(d_coarse, num_components);
 
@@ -322,6 +326,9 @@ TEST_CASE(
 }
 TEST_CASE("2-processor getGhostPatches on uniform quad", "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -330,7 +337,8 @@ TEST_CASE("2-processor getGhostPatches on uniform quad", "[GMG::InterLevelComm]"
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	auto coarse_vec = ValVector<2>::GetNewVector(d_coarse, num_components);
 
@@ -595,6 +603,9 @@ TEST_CASE(
 }
 TEST_CASE("2-processor getGhostPatches called twice on uniform quad", "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -603,7 +614,8 @@ TEST_CASE("2-processor getGhostPatches called twice on uniform quad", "[GMG::Int
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	int rank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -651,6 +663,9 @@ TEST_CASE("2-processor getGhostPatches called twice on uniform quad", "[GMG::Int
 }
 TEST_CASE("2-processor sendGhostPatches called twice on uniform quad", "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -659,7 +674,8 @@ TEST_CASE("2-processor sendGhostPatches called twice on uniform quad", "[GMG::In
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	int rank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -710,6 +726,9 @@ TEST_CASE("2-processor sendGhostPatches called twice on uniform quad", "[GMG::In
 TEST_CASE("2-processor sendGhostPatches then getGhostPaches called on uniform quad",
           "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -718,7 +737,8 @@ TEST_CASE("2-processor sendGhostPatches then getGhostPaches called on uniform qu
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	int rank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -800,6 +820,9 @@ TEST_CASE("2-processor sendGhostPatches then getGhostPaches called on uniform qu
 TEST_CASE("2-processor getGhostPatches then sendGhostPaches called on uniform quad",
           "[GMG::InterLevelComm]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto                  mesh_file      = GENERATE(as<std::string>{}, MESHES);
 	auto                  num_components = GENERATE(1, 2, 3);
 	auto                  nx             = GENERATE(2, 10);
@@ -808,7 +831,8 @@ TEST_CASE("2-processor getGhostPatches then sendGhostPaches called on uniform qu
 	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
 	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
 	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
-	auto ilc = std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine);
+	auto ilc
+	= std::make_shared<GMG::InterLevelComm<2>>(d_coarse, num_components, d_fine, backend);
 
 	int rank;
 	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
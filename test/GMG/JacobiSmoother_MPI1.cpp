@@ -0,0 +1,72 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "../utils/DomainReader.h"
+#include "../utils/SmootherFixtures.h"
+#include "catch.hpp"
+#include <ThunderEgg/GMG/JacobiSmoother.h>
+using namespace std;
+using namespace ThunderEgg;
+TEST_CASE("JacobiSmoother sweep matches a hand computed update on a single patch",
+          "[GMG::JacobiSmoother]")
+{
+	auto                  weight = GENERATE(2.0 / 3.0, 1.0);
+	shared_ptr<Domain<2>> d      = GetSinglePatchDomain();
+	auto                  gf     = make_shared<BiLinearGhostFiller>(d);
+	auto                  op     = make_shared<Poisson::StarPatchOperator<2>>(d, gf);
+
+	SinglePatchValues u;
+	SinglePatchValues f;
+	GetSinglePatchProblem(u, f);
+	auto u_vec = ValVector<2>::GetNewVector(d, 1);
+	auto f_vec = ValVector<2>::GetNewVector(d, 1);
+	SetSinglePatchValues(u_vec, u);
+	SetSinglePatchValues(f_vec, f);
+
+	// u + w * D^-1 (f - A u), with every cell using the values from before the sweep
+	SinglePatchValues expected;
+	for (int xi = 0; xi < single_n; xi++) {
+		for (int yi = 0; yi < single_n; yi++) {
+			double resid     = f[xi][yi] - HandLaplacian(u, xi, yi);
+			expected[xi][yi] = u[xi][yi] + weight * resid / HandDiagonal(xi, yi);
+		}
+	}
+
+	GMG::JacobiSmoother<2> smoother(op, weight);
+	smoother.smooth(f_vec, u_vec);
+
+	LocalData<2> u_ld = u_vec->getLocalData(0, 0);
+	nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+		INFO("xi:    " << coord[0]);
+		INFO("yi:    " << coord[1]);
+		CHECK(u_ld[coord] == Approx(expected[coord[0]][coord[1]]));
+	});
+}
+TEST_CASE("JacobiSmoother getWeight", "[GMG::JacobiSmoother]")
+{
+	DomainReader<2>       domain_reader(uniform_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto weight = GENERATE(0.5, 1.0, 1.5);
+
+	GMG::JacobiSmoother<2> smoother(GetOperator(d_fine, "Poisson"), weight);
+	CHECK(smoother.getWeight() == weight);
+}
\ No newline at end of file
@@ -278,4 +278,54 @@ TEST_CASE("Linear Test LinearRestrictor two components dont extrapolate boundary
 			               });
 		}
 	}
-}
\ No newline at end of file
+}TEST_CASE("LinearRestrictor interleaved components match separate components",
+          "[GMG::LinearRestrictor]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto extrapolate = GENERATE(false, true);
+	INFO("EXTRAPOLATE: " << extrapolate);
+	int                   n         = 6;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
+	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
+
+	ValVectorStorage storage;
+	storage.interleaved = true;
+
+	auto fine_vec        = ValVector<2>::GetNewVector(d_fine, 3, storage);
+	auto coarse_vec      = ValVector<2>::GetNewVector(d_coarse, 3, storage);
+	auto fine_expected   = ValVector<2>::GetNewVector(d_fine, 3);
+	auto coarse_expected = ValVector<2>::GetNewVector(d_coarse, 3);
+
+	auto f = [&](const std::array<double, 2> coord) -> double {
+		return 1 + coord[0] * 0.3 + coord[1];
+	};
+	auto g = [&](const std::array<double, 2> coord) -> double {
+		return 9 + coord[0] * 0.9 + coord[1] * 4;
+	};
+	auto h = [&](const std::array<double, 2> coord) -> double {
+		return coord[0] * coord[1];
+	};
+	DomainTools::SetValuesWithGhost<2>(d_fine, fine_vec, f, g, h);
+	DomainTools::SetValuesWithGhost<2>(d_fine, fine_expected, f, g, h);
+
+	auto restrictor = std::make_shared<GMG::LinearRestrictor<2>>(d_fine, d_coarse, 3, extrapolate);
+	restrictor->restrict(fine_vec, coarse_vec);
+	restrictor->restrict(fine_expected, coarse_expected);
+
+	for (auto pinfo : d_coarse->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 3; c++) {
+			INFO("component: " << c);
+			LocalData<2> vec_ld      = coarse_vec->getLocalData(c, pinfo->local_index);
+			LocalData<2> expected_ld = coarse_expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 2> &coord) {
+				               INFO("coord:  " << coord[0] << ", " << coord[1]);
+				               CHECK(vec_ld[coord] == expected_ld[coord]);
+			               });
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "../utils/DomainReader.h"
+#include "../utils/SmootherFixtures.h"
+#include "catch.hpp"
+#include <ThunderEgg/GMG/RedBlackGaussSeidelSmoother.h>
+using namespace std;
+using namespace ThunderEgg;
+TEST_CASE("RedBlackGaussSeidelSmoother sweep matches a hand computed update on a single patch",
+          "[GMG::RedBlackGaussSeidelSmoother]")
+{
+	auto                  weight = GENERATE(1.0, 1.2);
+	shared_ptr<Domain<2>> d      = GetSinglePatchDomain();
+	auto                  gf     = make_shared<BiLinearGhostFiller>(d);
+	auto                  op     = make_shared<Poisson::StarPatchOperator<2>>(d, gf);
+
+	SinglePatchValues u;
+	SinglePatchValues f;
+	GetSinglePatchProblem(u, f);
+	auto u_vec = ValVector<2>::GetNewVector(d, 1);
+	auto f_vec = ValVector<2>::GetNewVector(d, 1);
+	SetSinglePatchValues(u_vec, u);
+	SetSinglePatchValues(f_vec, f);
+
+	// the red cells (even xi + yi) only have black neighbors, so they are updated from the values
+	// before the sweep, and then the black cells are updated from the new red values
+	SinglePatchValues expected = u;
+	for (int color = 0; color < 2; color++) {
+		for (int xi = 0; xi < single_n; xi++) {
+			for (int yi = 0; yi < single_n; yi++) {
+				if ((xi + yi) % 2 == color) {
+					double resid = f[xi][yi] - HandLaplacian(expected, xi, yi);
+					expected[xi][yi] += weight * resid / HandDiagonal(xi, yi);
+				}
+			}
+		}
+	}
+
+	GMG::RedBlackGaussSeidelSmoother<2> smoother(op, weight);
+	smoother.smooth(f_vec, u_vec);
+
+	LocalData<2> u_ld = u_vec->getLocalData(0, 0);
+	nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+		INFO("xi:    " << coord[0]);
+		INFO("yi:    " << coord[1]);
+		CHECK(u_ld[coord] == Approx(expected[coord[0]][coord[1]]));
+	});
+	// the cell at (1, 0) is black, and a sweep that used the old red values would differ there
+	double resid_old_red = f[1][0] - HandLaplacian(u, 1, 0);
+	double stale_black   = u[1][0] + weight * resid_old_red / HandDiagonal(1, 0);
+	CHECK(u_ld[{1, 0}] != Approx(stale_black));
+}
+TEST_CASE("RedBlackGaussSeidelSmoother getWeight", "[GMG::RedBlackGaussSeidelSmoother]")
+{
+	DomainReader<2>       domain_reader(uniform_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto weight = GENERATE(0.5, 1.0, 1.5);
+
+	GMG::RedBlackGaussSeidelSmoother<2> smoother(GetOperator(d_fine, "Poisson"), weight);
+	CHECK(smoother.getWeight() == weight);
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "../utils/DomainReader.h"
+#include "../utils/SmootherFixtures.h"
+#include "catch.hpp"
+#include <ThunderEgg/GMG/ChebyshevSmoother.h>
+#include <ThunderEgg/GMG/JacobiSmoother.h>
+#include <ThunderEgg/GMG/RedBlackGaussSeidelSmoother.h>
+using namespace std;
+using namespace ThunderEgg;
+namespace
+{
+/**
+ * @brief Get the smoothers of a given type that the common smoother tests are run with
+ */
+template <class SmootherType>
+vector<shared_ptr<GMG::Smoother<2>>> GetSmoothers(shared_ptr<PatchOperator<2>> op);
+template <>
+vector<shared_ptr<GMG::Smoother<2>>>
+GetSmoothers<GMG::JacobiSmoother<2>>(shared_ptr<PatchOperator<2>> op)
+{
+	return {make_shared<GMG::JacobiSmoother<2>>(op)};
+}
+template <>
+vector<shared_ptr<GMG::Smoother<2>>>
+GetSmoothers<GMG::RedBlackGaussSeidelSmoother<2>>(shared_ptr<PatchOperator<2>> op)
+{
+	return {make_shared<GMG::RedBlackGaussSeidelSmoother<2>>(op),
+	        make_shared<GMG::RedBlackGaussSeidelSmoother<2>>(op, 1.2)};
+}
+template <>
+vector<shared_ptr<GMG::Smoother<2>>>
+GetSmoothers<GMG::ChebyshevSmoother<2>>(shared_ptr<PatchOperator<2>> op)
+{
+	return {make_shared<GMG::ChebyshevSmoother<2>>(op, 1),
+	        make_shared<GMG::ChebyshevSmoother<2>>(op, 2),
+	        make_shared<GMG::ChebyshevSmoother<2>>(op, 4)};
+}
+} // namespace
+TEMPLATE_TEST_CASE("Smoother does not change the discrete solution", "[GMG::Smoother]",
+                   GMG::JacobiSmoother<2>, GMG::RedBlackGaussSeidelSmoother<2>,
+                   GMG::ChebyshevSmoother<2>)
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto type = GENERATE(as<std::string>{}, "Poisson", "Neumann", "VarPoisson");
+	INFO("OPERATOR: " << type);
+	int                   n         = 8;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost, type == "Neumann");
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto op = GetOperator(d_fine, type);
+
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	op->apply(g_vec, f_vec);
+
+	auto u_vec = ValVector<2>::GetNewVector(d_fine, 1);
+
+	vector<shared_ptr<GMG::Smoother<2>>> smoothers = GetSmoothers<TestType>(op);
+	for (size_t i = 0; i < smoothers.size(); i++) {
+		INFO("SMOOTHER: " << i);
+		u_vec->copy(g_vec);
+		smoothers[i]->smooth(f_vec, u_vec);
+
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			INFO("Patch: " << pinfo->id);
+			LocalData<2> u_ld = u_vec->getLocalData(0, pinfo->local_index);
+			LocalData<2> g_ld = g_vec->getLocalData(0, pinfo->local_index);
+			nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+				INFO("xi:    " << coord[0]);
+				INFO("yi:    " << coord[1]);
+				CHECK(u_ld[coord] == Approx(g_ld[coord]).margin(1e-10));
+			});
+		}
+	}
+}
+TEMPLATE_TEST_CASE("Smoother reduces the error", "[GMG::Smoother]", GMG::JacobiSmoother<2>,
+                   GMG::RedBlackGaussSeidelSmoother<2>, GMG::ChebyshevSmoother<2>)
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto type = GENERATE(as<std::string>{}, "Poisson", "Neumann", "VarPoisson");
+	INFO("OPERATOR: " << type);
+	int                   n         = 8;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost, type == "Neumann");
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto op = GetOperator(d_fine, type);
+
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	op->apply(g_vec, f_vec);
+
+	auto u_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	auto e_vec = ValVector<2>::GetNewVector(d_fine, 1);
+
+	vector<shared_ptr<GMG::Smoother<2>>> smoothers = GetSmoothers<TestType>(op);
+	for (size_t i = 0; i < smoothers.size(); i++) {
+		INFO("SMOOTHER: " << i);
+		u_vec->set(0);
+		double error = g_vec->twoNorm();
+		for (int sweep = 0; sweep < 5; sweep++) {
+			smoothers[i]->smooth(f_vec, u_vec);
+			e_vec->copy(u_vec);
+			e_vec->addScaled(-1.0, g_vec);
+			double new_error = e_vec->twoNorm();
+			INFO("SWEEP: " << sweep);
+			CHECK(new_error < error);
+			error = new_error;
+		}
+	}
+}
@@ -0,0 +1,135 @@
+#include "catch.hpp"
+#include "utils/DomainReader.h"
+#include <ThunderEgg/GhostFillTable.h>
+#include <ThunderEgg/ValVector.h>
+using namespace std;
+using namespace ThunderEgg;
+
+TEST_CASE("GhostFillTerm CoordOnSide matches the slices of LocalData", "[GhostFillTable]")
+{
+	auto nx        = GENERATE(1, 2, 5);
+	auto ny        = GENERATE(1, 2, 5);
+	auto nz        = GENERATE(1, 2, 5);
+	int  num_ghost = 2;
+
+	ValVector<3>       vec(MPI_COMM_WORLD, {nx, ny, nz}, num_ghost, 1, 1);
+	const LocalData<3> ld = vec.getLocalData(0, 0);
+
+	for (Side<3> s : Side<3>::getValues()) {
+		for (int offset = -num_ghost; offset < 2; offset++) {
+			INFO("side: " << s << " offset: " << offset);
+			const LocalData<2> slice = ld.getSliceOnSide(s, offset);
+			nested_loop<2>(slice.getStart(), slice.getEnd(), [&](const array<int, 2> &coord) {
+				array<int, 3> patch_coord
+				= GhostFillTerm<3>::CoordOnSide(ld.getLengths(), s, offset, coord);
+				CHECK(ld.getPtr(patch_coord) == slice.getPtr(coord));
+			});
+		}
+	}
+}
+TEST_CASE("GhostFillTable applies the terms in order", "[GhostFillTable]")
+{
+	int               n = 4;
+	ValVector<2>      vec(MPI_COMM_WORLD, {n, n}, 1, 1, 2);
+	LocalData<2>      ld0 = vec.getLocalData(0, 0);
+	LocalData<2>      ld1 = vec.getLocalData(0, 1);
+	GhostFillTable<2> table;
+
+	ld0[{1, 2}] = 3;
+	ld0[{3, 0}] = 5;
+	ld1[{0, 0}] = 7;
+
+	table.addBlock(0, 1, {{{1, 2}, {-1, 0}, 2}, {{3, 0}, {-1, 0}, 0.5}});
+	table.addBlock(1, 0, {{{0, 0}, {4, 4}, -1}});
+	table.addBlock(1, 1, {});
+	CHECK(table.getNumTerms() == 3);
+
+	table.compile(ld0.getStrides());
+	table.apply<double>({ld0.getPtr(), ld1.getPtr()});
+
+	CHECK(ld1[{-1, 0}] == 3 * 2 + 5 * 0.5);
+	CHECK(ld0[{4, 4}] == -7);
+}
+TEST_CASE("GhostFillTable can be recompiled for different strides", "[GhostFillTable]")
+{
+	int               n = 3;
+	GhostFillTable<2> table;
+	table.addBlock(0, 0, {{{0, 1}, {-1, 1}, 1}, {{2, 2}, {2, 3}, 2}});
+
+	for (bool interleaved : {false, true, false}) {
+		INFO("interleaved: " << interleaved);
+		ValVectorStorage storage;
+		storage.interleaved = interleaved;
+		ValVector<2>       vec(MPI_COMM_WORLD, {n, n}, 1, 2, 1, storage);
+		for (int c = 0; c < 2; c++) {
+			LocalData<2> ld = vec.getLocalData(c, 0);
+			ld[{0, 1}]      = 1 + c;
+			ld[{2, 2}]      = 3 + c;
+		}
+		table.compile(vec.getLocalData(0, 0).getStrides());
+		for (int c = 0; c < 2; c++) {
+			table.apply<double>({vec.getLocalData(c, 0).getPtr()});
+		}
+		for (int c = 0; c < 2; c++) {
+			LocalData<2> ld = vec.getLocalData(c, 0);
+			CHECK(ld[{-1, 1}] == 1 + c);
+			CHECK(ld[{2, 3}] == 2 * (3 + c));
+		}
+	}
+}
+TEST_CASE("GhostFillTable applies the terms to all interleaved components at once",
+          "[GhostFillTable]")
+{
+	int               n              = 3;
+	int               num_components = 3;
+	GhostFillTable<2> table;
+	table.addBlock(0, 1, {{{0, 1}, {-1, 1}, 1}, {{2, 2}, {-1, 1}, 0.5}}, {true, false});
+	table.addBlock(1, 0, {{{2, 2}, {2, 3}, 2}});
+
+	ValVectorStorage storage;
+	storage.interleaved = true;
+	ValVector<2> vec(MPI_COMM_WORLD, {n, n}, 1, num_components, 2, storage);
+	for (int c = 0; c < num_components; c++) {
+		for (int p = 0; p < 2; p++) {
+			LocalData<2> ld = vec.getLocalData(c, p);
+			ld[{0, 1}]      = 1 + c + 10 * p;
+			ld[{2, 2}]      = 3 + c + 10 * p;
+			ld[{-1, 1}]     = 100;
+			ld[{2, 3}]      = 100;
+		}
+	}
+	REQUIRE(vec.hasInterleavedComponents());
+	table.compile(vec.getLocalData(0, 0).getStrides());
+	table.apply<double>({vec.getLocalData(0, 0).getPtr(), vec.getLocalData(0, 1).getPtr()},
+	                    num_components);
+
+	for (int c = 0; c < num_components; c++) {
+		INFO("component: " << c);
+		LocalData<2> ld0 = vec.getLocalData(c, 0);
+		LocalData<2> ld1 = vec.getLocalData(c, 1);
+		CHECK(ld1[{-1, 1}] == (1 + c) + 0.5 * (3 + c));
+		CHECK(ld0[{2, 3}] == 100 + 2 * (13 + c));
+	}
+}
+TEST_CASE("GhostFillTable assigns with the first contributor", "[GhostFillTable]")
+{
+	int               n = 3;
+	ValVector<2>      vec(MPI_COMM_WORLD, {n, n}, 1, 1, 1);
+	LocalData<2>      ld = vec.getLocalData(0, 0);
+	GhostFillTable<2> table;
+
+	ld[{0, 0}]  = 2;
+	ld[{1, 0}]  = 3;
+	ld[{-1, 0}] = 100;
+	ld[{-1, 1}] = 100;
+
+	// the second term is the first contributor to {-1, 1}, it is moved in front of the first term
+	table.addBlock(0, 0,
+	               {{{0, 0}, {-1, 0}, 1}, {{1, 0}, {-1, 1}, 1}, {{1, 0}, {-1, 0}, 0.5}},
+	               {false, true, false});
+	table.compile(ld.getStrides());
+	table.apply<double>({ld.getPtr()});
+
+	CHECK(ld[{-1, 0}] == 100 + 2 + 1.5);
+	CHECK(ld[{-1, 1}] == 3);
+}
@@ -31,4 +31,91 @@ TEST_CASE("LocalData constructor", "[DomainTools]")
 		CHECK(ld.getGhostEnd()[i] == lengths[i] - 1 + num_ghost);
 	}
 	CHECK(ld.getPtr(ld.getGhostStart()) == vec.data());
-}
\ No newline at end of file
+}
+TEST_CASE("LocalData<2> forEachLine visits each interior line once", "[LocalData]")
+{
+	auto nx        = GENERATE(1, 2, 10, 13);
+	auto ny        = GENERATE(1, 2, 10, 13);
+	auto num_ghost = GENERATE(0, 1, 2);
+
+	array<int, 2>  lengths = {nx, ny};
+	array<int, 2>  strides = {1, nx + 2 * num_ghost};
+	vector<double> vec((nx + 2 * num_ghost) * (ny + 2 * num_ghost));
+	iota(vec.begin(), vec.end(), 0);
+
+	LocalData<2> ld(vec.data() + num_ghost * strides[0] + num_ghost * strides[1], strides, lengths,
+	                num_ghost);
+
+	int num_lines = 0;
+	ld.forEachLine([&](const array<int, 2> &coord, double *line) {
+		CHECK(coord[0] == 0);
+		CHECK(coord[1] == num_lines);
+		CHECK(line == ld.getPtr(coord));
+		num_lines++;
+	});
+	CHECK(num_lines == ny);
+
+	const LocalData<2> &const_ld = ld;
+	const_ld.forEachLine([&](const array<int, 2> &coord, const double *line) {
+		for (int i = 0; i < nx; i++) {
+			double expected = const_ld[{i, coord[1]}];
+			CHECK(line[i * strides[0]] == expected);
+		}
+	});
+}
+TEST_CASE("LocalData<2> forEachLineWithGhosts visits each line once", "[LocalData]")
+{
+	auto nx        = GENERATE(1, 2, 10, 13);
+	auto ny        = GENERATE(1, 2, 10, 13);
+	auto num_ghost = GENERATE(0, 1, 2);
+
+	array<int, 2>  lengths = {nx, ny};
+	array<int, 2>  strides = {1, nx + 2 * num_ghost};
+	vector<double> vec((nx + 2 * num_ghost) * (ny + 2 * num_ghost));
+
+	LocalData<2> ld(vec.data() + num_ghost * strides[0] + num_ghost * strides[1], strides, lengths,
+	                num_ghost);
+
+	int num_lines = 0;
+	ld.forEachLineWithGhosts([&](const array<int, 2> &coord, double *line) {
+		CHECK(coord[0] == -num_ghost);
+		CHECK(coord[1] == num_lines - num_ghost);
+		CHECK(line == ld.getPtr(coord));
+		for (int i = 0; i < nx + 2 * num_ghost; i++) {
+			line[i * strides[0]] += 1;
+		}
+		num_lines++;
+	});
+	CHECK(num_lines == ny + 2 * num_ghost);
+	for (double value : vec) {
+		CHECK(value == 1);
+	}
+}
+TEST_CASE("LocalData<3> forEachLine on a slice follows the slice strides", "[LocalData]")
+{
+	auto nx = GENERATE(1, 2, 5);
+	auto ny = GENERATE(1, 2, 5);
+	auto nz = GENERATE(1, 2, 5);
+
+	array<int, 3>  lengths = {nx, ny, nz};
+	array<int, 3>  strides = {1, nx, nx * ny};
+	vector<double> vec(nx * ny * nz);
+	iota(vec.begin(), vec.end(), 0);
+
+	LocalData<3> ld(vec.data(), strides, lengths, 0);
+
+	for (Side<3> s : Side<3>::getValues()) {
+		LocalData<2> slice     = ld.getSliceOnSide(s);
+		int          n         = slice.getLengths()[0];
+		int          stride    = slice.getStrides()[0];
+		int          num_cells = 0;
+		slice.forEachLine([&](const array<int, 2> &coord, double *line) {
+			for (int i = 0; i < n; i++) {
+				double expected = slice[{i, coord[1]}];
+				CHECK(line[i * stride] == expected);
+				num_cells++;
+			}
+		});
+		CHECK(num_cells == slice.getLengths()[0] * slice.getLengths()[1]);
+	}
+}
@@ -209,8 +209,10 @@ template <int D> class ExchangeMockMPIGhostFiller : public MPIGhostFiller<D>
 	{
 	}
 
-	ExchangeMockMPIGhostFiller(std::shared_ptr<const Domain<D>> domain_in, int side_cases_in)
-	: MPIGhostFiller<D>(domain_in, side_cases_in)
+	ExchangeMockMPIGhostFiller(
+	std::shared_ptr<const Domain<D>> domain_in, int side_cases_in,
+	GhostExchangeBackend backend = GhostExchangeBackend::PointToPoint)
+	: MPIGhostFiller<D>(domain_in, side_cases_in, backend)
 	{
 	}
 
@@ -12,6 +12,32 @@ constexpr auto single_mesh_file  = "mesh_inputs/2d_uniform_2x2_mpi1.json";
 constexpr auto refined_mesh_file = "mesh_inputs/2d_uniform_2x2_refined_nw_mpi1.json";
 constexpr auto cross_mesh_file   = "mesh_inputs/2d_uniform_8x8_refined_cross_mpi1.json";
 
+namespace
+{
+/**
+ * @brief Throws from getLocalPatchStencil the first time it is called
+ */
+class ThrowOnceMockMPIGhostFiller : public CallMockMPIGhostFiller<2>
+{
+	private:
+	mutable bool thrown = false;
+
+	public:
+	ThrowOnceMockMPIGhostFiller(std::shared_ptr<const Domain<2>> domain_in, int num_components)
+	: CallMockMPIGhostFiller<2>(domain_in, num_components, 1)
+	{
+	}
+	bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<2>> pinfo,
+	                          std::vector<GhostFillTerm<2>> &     terms) const override
+	{
+		if (!thrown) {
+			thrown = true;
+			throw RuntimeError("stencil failure");
+		}
+		return false;
+	}
+};
+} // namespace
 TEST_CASE("No calls for 1 patch domain", "[MPIGhostFiller]")
 {
 	auto                  num_components = GENERATE(1, 2, 3);
@@ -106,4 +132,113 @@ TEST_CASE("Two Exchanges for various domains 1-side cases", "[MPIGhostFiller]")
 	mgf.fillGhost(vec);
 
 	mgf.checkVector(vec);
-}
\ No newline at end of file
+}
+TEST_CASE("Neighbor collective exchange for various domains 1-side cases", "[MPIGhostFiller]")
+{
+	auto num_components = GENERATE(1, 2, 3);
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		for (int c = 0; c < num_components; c++) {
+			auto data = vec->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(data.getStart(), data.getEnd(),
+			               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+		}
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::NeighborCollective);
+
+	mgf.fillGhost(vec);
+
+	mgf.checkVector(vec);
+}
+
+TEST_CASE("Shared memory exchange for various domains 1-side cases", "[MPIGhostFiller]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::SharedMemory);
+
+	for (int num_components : {1, 3, 3, 3, 2}) {
+		INFO("num_components: " << num_components);
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhostStart(vec);
+		mgf.fillGhostFinish(vec);
+
+		mgf.checkVector(vec);
+	}
+}
+TEST_CASE("Batched exchange of several vectors for various domains 1-side cases",
+          "[MPIGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	vector<shared_ptr<const Vector<2>>> vecs;
+	for (int num_components : {1, 3, 2}) {
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+		vecs.push_back(vec);
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, backend);
+
+	mgf.fillGhost(vecs);
+	mgf.fillGhost(vecs);
+
+	for (auto vec : vecs) {
+		INFO("num_components: " << vec->getNumComponents());
+		mgf.checkVector(vec);
+	}
+}
+TEST_CASE("A failed fillGhostStart does not block later fills", "[MPIGhostFiller]")
+{
+	DomainReader<2>       domain_reader(cross_mesh_file, {4, 4}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto vec = ValVector<2>::GetNewVector(d_fine, 1);
+
+	ThrowOnceMockMPIGhostFiller mgf(d_fine, 1);
+
+	CHECK_THROWS_AS(mgf.fillGhostStart(vec), RuntimeError);
+	CHECK_NOTHROW(mgf.fillGhost(vec));
+}
@@ -84,4 +84,269 @@ TEST_CASE("Two Exchanges for various domains 1-side cases MPI2", "[MPIGhostFille
 	mgf.fillGhost(vec);
 
 	mgf.checkVector(vec);
-}
\ No newline at end of file
+}
+TEST_CASE("Split exchange for various domains 1-side cases MPI2", "[MPIGhostFiller]")
+{
+	auto num_components = GENERATE(1, 2, 3);
+	auto mesh_file      = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	auto vec      = ValVector<2>::GetNewVector(d_fine, num_components);
+	auto expected = ValVector<2>::GetNewVector(d_fine, num_components);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		for (int c = 0; c < num_components; c++) {
+			auto data          = vec->getLocalData(c, pinfo->local_index);
+			auto expected_data = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(data.getStart(), data.getEnd(), [&](const std::array<int, 2> &coord) {
+				data[coord]          = pinfo->id;
+				expected_data[coord] = pinfo->id;
+			});
+		}
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1);
+
+	mgf.fillGhost(expected);
+
+	mgf.fillGhostStart(vec);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("id: " << pinfo->id);
+		std::deque<int> nbr_ranks;
+		for (Side<2> s : Side<2>::getValues()) {
+			if (pinfo->hasNbr(s)) {
+				pinfo->nbr_info[s.getIndex()]->getNbrRanks(nbr_ranks);
+			}
+		}
+		bool has_remote_nbr = false;
+		for (int nbr_rank : nbr_ranks) {
+			has_remote_nbr = has_remote_nbr || nbr_rank != rank;
+		}
+		CHECK(mgf.isRemoteDependent(pinfo) == has_remote_nbr);
+		if (!mgf.isRemoteDependent(pinfo)) {
+			// the ghost cells of this patch should already be filled
+			for (int c = 0; c < num_components; c++) {
+				auto data          = vec->getLocalData(c, pinfo->local_index);
+				auto expected_data = expected->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getGhostStart(), data.getGhostEnd(),
+				               [&](const std::array<int, 2> &coord) {
+					               CHECK(data[coord] == expected_data[coord]);
+				               });
+			}
+		}
+	}
+	mgf.fillGhostFinish(vec);
+
+	mgf.checkVector(vec);
+}
+TEST_CASE("Split exchange has to be started and finished in order MPI2", "[MPIGhostFiller]")
+{
+	DomainReader<2>       domain_reader(uniform, {2, 2}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto vec = ValVector<2>::GetNewVector(d_fine, 1);
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1);
+
+	CHECK_THROWS_AS(mgf.fillGhostFinish(vec), RuntimeError);
+	mgf.fillGhostStart(vec);
+	CHECK_THROWS_AS(mgf.fillGhostStart(vec), RuntimeError);
+	CHECK_THROWS_AS(mgf.fillGhost(vec), RuntimeError);
+	mgf.fillGhostFinish(vec);
+	mgf.fillGhost(vec);
+}
+TEST_CASE("Exchanges for vectors with different numbers of components MPI2", "[MPIGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1);
+
+	for (int num_components : {1, 3, 1, 2}) {
+		INFO("num_components: " << num_components);
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhost(vec);
+		mgf.fillGhost(vec);
+
+		mgf.checkVector(vec);
+	}
+}
+TEST_CASE("Neighbor collective exchange for various domains 1-side cases MPI2", "[MPIGhostFiller]")
+{
+	auto num_components = GENERATE(1, 2, 3);
+	auto mesh_file      = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		for (int c = 0; c < num_components; c++) {
+			auto data = vec->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(data.getStart(), data.getEnd(),
+			               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+		}
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::NeighborCollective);
+	CHECK(mgf.getExchangeBackend() == GhostExchangeBackend::NeighborCollective);
+
+	mgf.fillGhost(vec);
+	mgf.fillGhost(vec);
+
+	mgf.checkVector(vec);
+}
+TEST_CASE("Split neighbor collective exchange with different numbers of components MPI2",
+          "[MPIGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::NeighborCollective);
+
+	for (int num_components : {1, 3, 1, 2}) {
+		INFO("num_components: " << num_components);
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhostStart(vec);
+		mgf.fillGhostFinish(vec);
+
+		mgf.checkVector(vec);
+	}
+}
+
+TEST_CASE("Shared memory exchange for various domains 1-side cases MPI2", "[MPIGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::SharedMemory);
+
+	for (int num_components : {1, 3, 3, 3, 2}) {
+		INFO("num_components: " << num_components);
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhostStart(vec);
+		mgf.fillGhostFinish(vec);
+
+		mgf.checkVector(vec);
+	}
+}
+TEST_CASE("Exchanges alternating between numbers of components reuse the buffers MPI2",
+          "[MPIGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, backend);
+
+	auto vec_1 = ValVector<2>::GetNewVector(d_fine, 1);
+	auto vec_2 = ValVector<2>::GetNewVector(d_fine, 2);
+	for (int i = 0; i < 5; i++) {
+		INFO("EXCHANGE: " << i);
+		auto vec = i % 2 == 0 ? vec_1 : vec_2;
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < vec->getNumComponents(); c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhostStart(vec);
+		mgf.fillGhostFinish(vec);
+
+		mgf.checkVector(vec);
+	}
+}
+TEST_CASE("Batched exchange of several vectors for various domains 1-side cases MPI2",
+          "[MPIGhostFiller]")
+{
+	auto backend = GENERATE(GhostExchangeBackend::PointToPoint,
+	                        GhostExchangeBackend::NeighborCollective,
+	                        GhostExchangeBackend::SharedMemory);
+	INFO("BACKEND: " << backend);
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	vector<shared_ptr<const Vector<2>>> vecs;
+	for (int num_components : {1, 3, 2}) {
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+		vecs.push_back(vec);
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, backend);
+
+	mgf.fillGhost(vecs);
+	mgf.fillGhost(vecs);
+
+	for (auto vec : vecs) {
+		INFO("num_components: " << vec->getNumComponents());
+		mgf.checkVector(vec);
+	}
+}
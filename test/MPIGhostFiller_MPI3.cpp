@@ -84,4 +84,62 @@ TEST_CASE("Two Exchanges for various domains 1-side cases MPI3", "[MPIGhostFille
 	mgf.fillGhost(vec);
 
 	mgf.checkVector(vec);
-}
\ No newline at end of file
+}
+TEST_CASE("Neighbor collective exchange for various domains 1-side cases MPI3",
+          "[MPIGhostFiller]")
+{
+	auto num_components = GENERATE(1, 2, 3);
+	auto mesh_file      = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		for (int c = 0; c < num_components; c++) {
+			auto data = vec->getLocalData(c, pinfo->local_index);
+			nested_loop<2>(data.getStart(), data.getEnd(),
+			               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+		}
+	}
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::NeighborCollective);
+
+	mgf.fillGhost(vec);
+	mgf.fillGhost(vec);
+
+	mgf.checkVector(vec);
+}
+
+TEST_CASE("Shared memory exchange for various domains 1-side cases MPI3", "[MPIGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, uniform, refined);
+	INFO("MESH: " << mesh_file);
+	auto                  nx        = GENERATE(2, 5);
+	auto                  ny        = GENERATE(2, 5);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {nx, ny}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ExchangeMockMPIGhostFiller<2> mgf(d_fine, 1, GhostExchangeBackend::SharedMemory);
+
+	for (int num_components : {1, 3, 3, 3, 2}) {
+		INFO("num_components: " << num_components);
+		auto vec = ValVector<2>::GetNewVector(d_fine, num_components);
+		for (auto pinfo : d_fine->getPatchInfoVector()) {
+			for (int c = 0; c < num_components; c++) {
+				auto data = vec->getLocalData(c, pinfo->local_index);
+				nested_loop<2>(data.getStart(), data.getEnd(),
+				               [&](const std::array<int, 2> &coord) { data[coord] = pinfo->id; });
+			}
+		}
+
+		mgf.fillGhostStart(vec);
+		mgf.fillGhostFinish(vec);
+
+		mgf.checkVector(vec);
+	}
+}
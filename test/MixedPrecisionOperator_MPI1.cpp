@@ -0,0 +1,164 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "catch.hpp"
+#include "utils/DomainReader.h"
+#include <ThunderEgg/BiCGStab.h>
+#include <ThunderEgg/BiLinearGhostFiller.h>
+#include <ThunderEgg/DomainTools.h>
+#include <ThunderEgg/GMG/CycleBuilder.h>
+#include <ThunderEgg/GMG/DirectInterpolator.h>
+#include <ThunderEgg/GMG/LinearRestrictor.h>
+#include <ThunderEgg/MixedPrecisionOperator.h>
+#include <ThunderEgg/Poisson/StarPatchOperator.h>
+#include <ThunderEgg/ValVectorGenerator.h>
+using namespace std;
+using namespace ThunderEgg;
+
+namespace
+{
+/**
+ * @brief Get a two level V-cycle for the poisson problem, with the given scalar type
+ */
+template <typename T>
+shared_ptr<GMG::Cycle<2, T>> GetTwoLevelCycle(shared_ptr<Domain<2>> d_fine,
+                                              shared_ptr<Domain<2>> d_coarse)
+{
+	GMG::CycleOpts opts;
+	opts.smoother_types = {"rbgs"};
+	GMG::CycleBuilder<2, T> builder(opts);
+
+	auto fine_gf      = make_shared<BasicBiLinearGhostFiller<T>>(d_fine);
+	auto fine_op      = make_shared<Poisson::StarPatchOperator<2, T>>(d_fine, fine_gf);
+	auto fine_vg      = make_shared<ValVectorGenerator<2, T>>(d_fine, 1);
+	auto restrictor   = make_shared<GMG::LinearRestrictor<2, T>>(d_fine, d_coarse, 1, true);
+	auto coarse_gf    = make_shared<BasicBiLinearGhostFiller<T>>(d_coarse);
+	auto coarse_op    = make_shared<Poisson::StarPatchOperator<2, T>>(d_coarse, coarse_gf);
+	auto coarse_vg    = make_shared<ValVectorGenerator<2, T>>(d_coarse, 1);
+	auto interpolator = make_shared<GMG::DirectInterpolator<2, T>>(d_coarse, d_fine, 1);
+	builder.addFinestLevel(fine_op, nullptr, restrictor, fine_vg);
+	builder.addCoarsestLevel(coarse_op, nullptr, interpolator, coarse_vg);
+	return builder.getCycle();
+}
+} // namespace
+TEST_CASE("MixedPrecisionOperator matches the double operator to single precision",
+          "[MixedPrecisionOperator]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, "mesh_inputs/2d_uniform_4x4_mpi1.json",
+	                          "mesh_inputs/2d_uniform_2x2_refined_nw_mpi1.json");
+	INFO("MESH FILE " << mesh_file);
+	DomainReader<2>       domain_reader(mesh_file, {16, 16}, 1);
+	shared_ptr<Domain<2>> domain = domain_reader.getFinerDomain();
+
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sin(M_PI * y) * cos(2 * M_PI * x);
+	};
+
+	auto g_vec = ValVector<2>::GetNewVector(domain, 1);
+	DomainTools::SetValues<2>(domain, g_vec, gfun);
+	auto f_expected = ValVector<2>::GetNewVector(domain, 1);
+	auto f_vec      = ValVector<2>::GetNewVector(domain, 1);
+
+	auto gf       = make_shared<BiLinearGhostFiller>(domain);
+	auto op       = make_shared<Poisson::StarPatchOperator<2>>(domain, gf);
+	auto gf_float = make_shared<BasicBiLinearGhostFiller<float>>(domain);
+	auto op_float = make_shared<Poisson::StarPatchOperator<2, float>>(domain, gf_float);
+
+	MixedPrecisionOperator<2, float> mixed_op(op_float,
+	                                          make_shared<ValVectorGenerator<2, float>>(domain, 1));
+	op->apply(g_vec, f_expected);
+	mixed_op.apply(g_vec, f_vec);
+
+	double scale = f_expected->infNorm();
+	for (auto pinfo : domain->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> f_ld          = f_vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> f_expected_ld = f_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(f_ld.getStart(), f_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(f_ld[coord] == Approx(f_expected_ld[coord]).margin(1e-5 * scale));
+		});
+	}
+}
+TEST_CASE("MixedPrecisionOperator throws with nullptr arguments", "[MixedPrecisionOperator]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {4, 4}, 1);
+	shared_ptr<Domain<2>> domain = domain_reader.getFinerDomain();
+
+	auto gf_float = make_shared<BasicBiLinearGhostFiller<float>>(domain);
+	auto op_float = make_shared<Poisson::StarPatchOperator<2, float>>(domain, gf_float);
+	auto vg_float = make_shared<ValVectorGenerator<2, float>>(domain, 1);
+
+	CHECK_THROWS_AS((MixedPrecisionOperator<2, float>(nullptr, vg_float)), RuntimeError);
+	CHECK_THROWS_AS((MixedPrecisionOperator<2, float>(op_float, nullptr)), RuntimeError);
+}
+TEST_CASE("single precision GMG preconditions a double precision BiCGStab solve",
+          "[MixedPrecisionOperator]")
+{
+	string mesh_file = "mesh_inputs/2d_uniform_4x4_mpi1.json";
+	INFO("MESH FILE " << mesh_file);
+	DomainReader<2>       domain_reader(mesh_file, {16, 16}, 1);
+	shared_ptr<Domain<2>> d_fine   = domain_reader.getFinerDomain();
+	shared_ptr<Domain<2>> d_coarse = domain_reader.getCoarserDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sin(M_PI * y) * cos(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sin(M_PI * y) * cos(2 * M_PI * x);
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto g_vec    = ValVector<2>::GetNewVector(d_fine, 1);
+	auto residual = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto gf = make_shared<BiLinearGhostFiller>(d_fine);
+	auto op = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	op->addDrichletBCToRHS(f_vec, gfun);
+
+	auto cycle_float = GetTwoLevelCycle<float>(d_fine, d_coarse);
+	auto vg_float    = make_shared<ValVectorGenerator<2, float>>(d_fine, 1);
+	auto prec        = make_shared<MixedPrecisionOperator<2, float>>(cycle_float, vg_float);
+
+	double tolerance = 1e-9;
+
+	auto vg         = make_shared<ValVectorGenerator<2>>(d_fine, 1);
+	int  iterations = BiCGStab<2>::solve(vg, op, g_vec, f_vec, prec, 1000, tolerance);
+
+	auto g_double_prec = ValVector<2>::GetNewVector(d_fine, 1);
+	auto cycle_double  = GetTwoLevelCycle<double>(d_fine, d_coarse);
+	int  double_prec_iterations
+	= BiCGStab<2>::solve(vg, op, g_double_prec, f_vec, cycle_double, 1000, tolerance);
+
+	CHECK(iterations <= double_prec_iterations + 1);
+
+	op->apply(g_vec, residual);
+	residual->addScaled(-1, f_vec);
+	CHECK(residual->twoNorm() / f_vec->twoNorm() <= tolerance);
+}
@@ -0,0 +1,123 @@
+#include "catch.hpp"
+#include "utils/DomainReader.h"
+#include <ThunderEgg/PatchLoop.h>
+#include <ThunderEgg/RuntimeError.h>
+#include <ThunderEgg/ValVector.h>
+using namespace std;
+using namespace ThunderEgg;
+
+constexpr auto single_mesh_file  = "mesh_inputs/2d_uniform_2x2_mpi1.json";
+constexpr auto refined_mesh_file = "mesh_inputs/2d_uniform_2x2_refined_nw_mpi1.json";
+constexpr auto cross_mesh_file   = "mesh_inputs/2d_uniform_8x8_refined_cross_mpi1.json";
+
+namespace
+{
+class SplitGhostFiller : public GhostFiller<2>
+{
+	private:
+	mutable bool started  = false;
+	mutable bool finished = false;
+
+	public:
+	void fillGhost(std::shared_ptr<const Vector<2>> u) const override
+	{
+		started  = true;
+		finished = true;
+	}
+	void fillGhostStart(std::shared_ptr<const Vector<2>> u) const override
+	{
+		started = true;
+	}
+	void fillGhostFinish(std::shared_ptr<const Vector<2>> u) const override
+	{
+		finished = true;
+	}
+	bool isRemoteDependent(std::shared_ptr<const PatchInfo<2>> pinfo) const override
+	{
+		return pinfo->local_index % 2 == 1;
+	}
+	bool wasStarted() const
+	{
+		return started;
+	}
+	bool wasFinished() const
+	{
+		return finished;
+	}
+};
+} // namespace
+TEST_CASE("ParallelPatchLoop calls the function once for each patch", "[PatchLoop]")
+{
+	auto threaded    = GENERATE(false, true);
+	auto schedule    = GENERATE(PatchSchedule::Dynamic, PatchSchedule::Static);
+	auto num_patches = GENERATE(0, 1, 7, 64);
+	INFO("THREADED: " << threaded);
+	INFO("NUM PATCHES: " << num_patches);
+
+	vector<int> num_calls(num_patches, 0);
+	ParallelPatchLoop(
+	num_patches, threaded, [&](int p) { num_calls[p]++; }, schedule);
+
+	for (int p = 0; p < num_patches; p++) {
+		INFO("PATCH: " << p);
+		CHECK(num_calls[p] == 1);
+	}
+}
+TEST_CASE("ParallelPatchLoop rethrows exceptions", "[PatchLoop]")
+{
+	auto threaded = GENERATE(false, true);
+	INFO("THREADED: " << threaded);
+
+	auto func = [](int p) {
+		if (p == 3) {
+			throw RuntimeError("patch 3");
+		}
+	};
+	CHECK_THROWS_AS(ParallelPatchLoop(8, threaded, func), RuntimeError);
+}
+TEST_CASE("InThreadedPatchLoop is false outside of patch loops", "[PatchLoop]")
+{
+	CHECK_FALSE(InThreadedPatchLoop());
+	CHECK(GetNumPatchLoopThreads() >= 1);
+}
+TEST_CASE("ForEachPatchWithGhosts does patches without remote ghosts while ghosts are exchanged",
+          "[PatchLoop]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto threaded = GENERATE(false, true);
+	INFO("THREADED: " << threaded);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u  = ValVector<2>::GetNewVector(d_fine, 1);
+	auto gf = make_shared<SplitGhostFiller>();
+
+	vector<int> num_calls(d_fine->getNumLocalPatches(), 0);
+	vector<int> called_after_finish(d_fine->getNumLocalPatches(), 0);
+	ForEachPatchWithGhosts<2, double>(d_fine, gf, u, threaded,
+	                                  [&](std::shared_ptr<const PatchInfo<2>> pinfo) {
+		                                  num_calls[pinfo->local_index]++;
+		                                  called_after_finish[pinfo->local_index]
+		                                  = gf->wasFinished();
+	                                  });
+
+	CHECK(gf->wasStarted());
+	CHECK(gf->wasFinished());
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("LOCAL_INDEX: " << pinfo->local_index);
+		CHECK(num_calls[pinfo->local_index] == 1);
+		CHECK(called_after_finish[pinfo->local_index] == gf->isRemoteDependent(pinfo));
+	}
+}
+TEST_CASE("ValVector has thread safe LocalData", "[PatchLoop]")
+{
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(single_mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	CHECK(u->hasThreadSafeLocalData());
+}
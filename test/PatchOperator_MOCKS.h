@@ -47,6 +47,46 @@ template <int D> class MockGhostFiller : public GhostFiller<D>
 		return called;
 	}
 };
+template <int D> class SplitMockGhostFiller : public GhostFiller<D>
+{
+	private:
+	mutable bool started  = false;
+	mutable bool finished = false;
+
+	public:
+	void fillGhost(std::shared_ptr<const Vector<D>> u) const override
+	{
+		started  = true;
+		finished = true;
+	}
+	void fillGhostStart(std::shared_ptr<const Vector<D>> u) const override
+	{
+		CHECK_FALSE(started);
+		started = true;
+	}
+	void fillGhostFinish(std::shared_ptr<const Vector<D>> u) const override
+	{
+		CHECK(started);
+		finished = true;
+	}
+	bool isRemoteDependent(std::shared_ptr<const PatchInfo<D>> pinfo) const override
+	{
+		return pinfo->local_index % 2 == 1;
+	}
+	/**
+	 * @brief Check that the ghost cells of the patch have been filled
+	 */
+	void checkGhostsFilled(std::shared_ptr<const PatchInfo<D>> pinfo) const
+	{
+		INFO("LOCAL_INDEX: " << pinfo->local_index);
+		CHECK(started);
+		CHECK(finished == isRemoteDependent(pinfo));
+	}
+	bool wasFinished()
+	{
+		return finished;
+	}
+};
 template <int D> class MockPatchOperator : public PatchOperator<D>
 {
 	private:
@@ -69,6 +109,11 @@ template <int D> class MockPatchOperator : public PatchOperator<D>
 	                      bool treat_interior_boundary_as_dirichlet) const override
 	{
 		CHECK_FALSE(treat_interior_boundary_as_dirichlet);
+		auto split_ghost_filler
+		= std::dynamic_pointer_cast<const SplitMockGhostFiller<D>>(this->ghost_filler);
+		if (split_ghost_filler != nullptr) {
+			split_ghost_filler->checkGhostsFilled(pinfo);
+		}
 		CHECK(patches_to_be_called.count(pinfo) == 1);
 		patches_to_be_called.erase(pinfo);
 		INFO("LOCAL_INDEX: " << pinfo->local_index);
@@ -36,6 +36,49 @@ TEST_CASE("Check PatchOperator calls for various domains", "[PatchOperator]")
 	CHECK(mgf->wasCalled());
 	CHECK(mpo.allPatchesCalled());
 }
+TEST_CASE("PatchOperator applies patches without remote ghosts while ghosts are exchanged",
+          "[PatchOperator]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto                 mgf = make_shared<SplitMockGhostFiller<2>>();
+	MockPatchOperator<2> mpo(d_fine, mgf, u, f);
+
+	mpo.apply(u, f);
+
+	CHECK(mgf->wasFinished());
+	CHECK(mpo.allPatchesCalled());
+}
+TEST_CASE("PatchOperator residual calls every patch while ghosts are exchanged",
+          "[PatchOperator]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+	auto r = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto                 mgf = make_shared<SplitMockGhostFiller<2>>();
+	MockPatchOperator<2> mpo(d_fine, mgf, u, r);
+
+	mpo.residual(f, u, r);
+
+	CHECK(mgf->wasFinished());
+	CHECK(mpo.allPatchesCalled());
+}
 TEST_CASE("PatchOperator check getDomain", "[PatchOperator]")
 {
 	auto mesh_file
@@ -75,4 +118,18 @@ TEST_CASE("PatchOperator check getGhostFiller", "[PatchOperator]")
 	MockPatchOperator<2> mpo(d_fine, mgf, u, f);
 
 	CHECK(mpo.getGhostFiller() == mgf);
-}
\ No newline at end of file
+}
+TEST_CASE("PatchOperator is not thread safe by default", "[PatchOperator]")
+{
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(single_mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto                 mgf = make_shared<MockGhostFiller<2>>();
+	MockPatchOperator<2> mpo(d_fine, mgf, u, f);
+
+	CHECK_FALSE(mpo.isThreadSafe());
+}
@@ -44,18 +44,60 @@ template <int D> class MockGhostFiller : public GhostFiller<D>
 		return called;
 	}
 };
+template <int D> class SplitMockGhostFiller : public GhostFiller<D>
+{
+	private:
+	mutable bool started  = false;
+	mutable bool finished = false;
+
+	public:
+	void fillGhost(std::shared_ptr<const Vector<D>> u) const override
+	{
+		started  = true;
+		finished = true;
+	}
+	void fillGhostStart(std::shared_ptr<const Vector<D>> u) const override
+	{
+		CHECK_FALSE(started);
+		started = true;
+	}
+	void fillGhostFinish(std::shared_ptr<const Vector<D>> u) const override
+	{
+		CHECK(started);
+		finished = true;
+	}
+	bool isRemoteDependent(std::shared_ptr<const PatchInfo<D>> pinfo) const override
+	{
+		return pinfo->local_index % 2 == 1;
+	}
+	/**
+	 * @brief Check that the ghost cells of the patch have been filled
+	 */
+	void checkGhostsFilled(std::shared_ptr<const PatchInfo<D>> pinfo) const
+	{
+		INFO("LOCAL_INDEX: " << pinfo->local_index);
+		CHECK(started);
+		CHECK(finished == isRemoteDependent(pinfo));
+	}
+	bool wasFinished()
+	{
+		return finished;
+	}
+};
 template <int D> class MockPatchSolver : public PatchSolver<D>
 {
 	private:
 	std::shared_ptr<Vector<D>>                            u_vec;
 	std::shared_ptr<Vector<D>>                            f_vec;
 	mutable std::set<std::shared_ptr<const PatchInfo<D>>> patches_to_be_called;
+	mutable int                                           num_batches_called = 0;
 
 	public:
 	MockPatchSolver(std::shared_ptr<const Domain<D>>      domain_in,
 	                std::shared_ptr<const GhostFiller<D>> ghost_filler_in,
-	                std::shared_ptr<Vector<D>> u_in, std::shared_ptr<Vector<D>> f_in)
-	: PatchSolver<D>(domain_in, ghost_filler_in), u_vec(u_in), f_vec(f_in)
+	                std::shared_ptr<Vector<D>> u_in, std::shared_ptr<Vector<D>> f_in,
+	                int batch_size_in = 1)
+	: PatchSolver<D>(domain_in, ghost_filler_in, batch_size_in), u_vec(u_in), f_vec(f_in)
 	{
 		for (auto pinfo : this->domain->getPatchInfoVector()) {
 			patches_to_be_called.insert(pinfo);
@@ -65,6 +107,11 @@ template <int D> class MockPatchSolver : public PatchSolver<D>
 	                      const std::vector<LocalData<D>> &   fs,
 	                      std::vector<LocalData<D>> &         us) const override
 	{
+		auto split_ghost_filler
+		= std::dynamic_pointer_cast<const SplitMockGhostFiller<D>>(this->ghost_filler);
+		if (split_ghost_filler != nullptr) {
+			split_ghost_filler->checkGhostsFilled(pinfo);
+		}
 		CHECK(patches_to_be_called.count(pinfo) == 1);
 		patches_to_be_called.erase(pinfo);
 		for (int c = 0; c < u_vec->getNumComponents(); c++) {
@@ -74,10 +121,28 @@ template <int D> class MockPatchSolver : public PatchSolver<D>
 			CHECK(f_vec->getLocalData(c, pinfo->local_index).getPtr() == fs[c].getPtr());
 		}
 	}
+	void solveBatch(const std::vector<std::shared_ptr<const PatchInfo<D>>> &batch,
+	                std::shared_ptr<const Vector<D>> f,
+	                std::shared_ptr<Vector<D>>       u) const override
+	{
+		CHECK(this->batch_size > 1);
+		CHECK(batch.size() >= 1);
+		CHECK(batch.size() <= (size_t) this->batch_size);
+		for (auto pinfo : batch) {
+			CHECK(pinfo->neumann == batch[0]->neumann);
+			CHECK(pinfo->spacings == batch[0]->spacings);
+		}
+		num_batches_called++;
+		PatchSolver<D>::solveBatch(batch, f, u);
+	}
 	bool allPatchesCalled()
 	{
 		return patches_to_be_called.empty();
 	}
+	int getNumBatchesCalled()
+	{
+		return num_batches_called;
+	}
 };
 } // namespace
 } // namespace ThunderEgg
\ No newline at end of file
@@ -119,6 +119,27 @@ TEST_CASE("PatchSolver smooth for various domains", "[PatchSolver]")
 	CHECK(ss.str().find("Total Patch") != string::npos);
 	CHECK(ss.str().find("Single Patch") != string::npos);
 }
+TEST_CASE("PatchSolver smooths patches without remote ghosts while ghosts are exchanged",
+          "[PatchSolver]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto               mgf = make_shared<SplitMockGhostFiller<2>>();
+	MockPatchSolver<2> mps(d_fine, mgf, u, f);
+
+	mps.smooth(f, u);
+
+	CHECK(mgf->wasFinished());
+	CHECK(mps.allPatchesCalled());
+}
 TEST_CASE("PatchSolver smooth for various domains with timer", "[PatchSolver]")
 {
 	auto mesh_file
@@ -188,4 +209,81 @@ TEST_CASE("PatchSolver getGhostFiller", "[PatchSolver]")
 	MockPatchSolver<2> mps(d_fine, mgf, u, f);
 
 	CHECK(mps.getGhostFiller() == mgf);
-}
\ No newline at end of file
+}
+TEST_CASE("PatchSolver apply passes batches of patches to solveBatch", "[PatchSolver]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto batch_size = GENERATE(2, 3, 100);
+	INFO("BATCH_SIZE: " << batch_size);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto               mgf = make_shared<MockGhostFiller<2>>();
+	MockPatchSolver<2> mps(d_fine, mgf, u, f, batch_size);
+
+	u->setWithGhost(1);
+	mps.apply(f, u);
+
+	CHECK(u->infNorm() == 0);
+	CHECK_FALSE(mgf->wasCalled());
+	CHECK(mps.allPatchesCalled());
+	CHECK(mps.getBatchSize() == batch_size);
+	int num_patches = d_fine->getNumLocalPatches();
+	CHECK(mps.getNumBatchesCalled() >= (num_patches + batch_size - 1) / batch_size);
+	CHECK(mps.getNumBatchesCalled() < num_patches);
+}
+TEST_CASE("PatchSolver smooth passes batches of patches to solveBatch while ghosts are exchanged",
+          "[PatchSolver]")
+{
+	auto mesh_file
+	= GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file, cross_mesh_file);
+	INFO("MESH: " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto               mgf = make_shared<SplitMockGhostFiller<2>>();
+	MockPatchSolver<2> mps(d_fine, mgf, u, f, 4);
+
+	mps.smooth(f, u);
+
+	CHECK(mgf->wasFinished());
+	CHECK(mps.allPatchesCalled());
+	CHECK(mps.getNumBatchesCalled() > 0);
+}
+TEST_CASE("PatchSolver throws exception for a batch size less than 1", "[PatchSolver]")
+{
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(single_mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto mgf        = make_shared<MockGhostFiller<2>>();
+	auto batch_size = GENERATE(0, -1);
+	CHECK_THROWS_AS(MockPatchSolver<2>(d_fine, mgf, u, f, batch_size), RuntimeError);
+}
+TEST_CASE("PatchSolver is not thread safe by default", "[PatchSolver]")
+{
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(single_mesh_file, {5, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f = ValVector<2>::GetNewVector(d_fine, 1);
+
+	auto               mgf = make_shared<MockGhostFiller<2>>();
+	MockPatchSolver<2> mps(d_fine, mgf, u, f);
+
+	CHECK_FALSE(mps.isThreadSafe());
+}
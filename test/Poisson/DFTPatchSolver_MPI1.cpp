@@ -26,6 +26,7 @@
 #include <ThunderEgg/GMG/LinearRestrictor.h>
 #include <ThunderEgg/Poisson/DFTPatchSolver.h>
 #include <ThunderEgg/Poisson/StarPatchOperator.h>
+#include <ThunderEgg/TriLinearGhostFiller.h>
 #include <ThunderEgg/ValVector.h>
 using namespace std;
 using namespace ThunderEgg;
@@ -202,4 +203,171 @@ TEST_CASE(
 	}
 	INFO("Errors: " << errors[0] << ", " << errors[1]);
 	CHECK(log(errors[0] / errors[1]) / log(2) > 1.8);
-}
\ No newline at end of file
+}
+TEST_CASE("Test Poisson::DFTPatchSolver solveSinglePatch inverts the operator in 3D",
+          "[Poisson::DFTPatchSolver]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, "mesh_inputs/3d_uniform_2x2x2_mpi1.json",
+	                          "mesh_inputs/3d_refined_bnw_2x2x2_mpi1.json");
+	INFO("MESH FILE " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<3>       domain_reader(mesh_file, {6, 4, 8}, num_ghost);
+	shared_ptr<Domain<3>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 3> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		double z = coord[2];
+		return sin(M_PI * x) * cos(2 * M_PI * y) + z;
+	};
+
+	auto f_vec = ValVector<3>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<3>(d_fine, f_vec, ffun);
+
+	auto gf         = make_shared<TriLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<3>>(d_fine, gf);
+	auto p_solver   = make_shared<Poisson::DFTPatchSolver<3>>(p_operator);
+
+	// with zero ghost values, the patches are solved with zero Dirichlet boundary conditions
+	auto u_vec = ValVector<3>::GetNewVector(d_fine, 1);
+	auto r_vec = ValVector<3>::GetNewVector(d_fine, 1);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		auto fs = f_vec->getLocalDatas(pinfo->local_index);
+		auto us = u_vec->getLocalDatas(pinfo->local_index);
+		auto rs = r_vec->getLocalDatas(pinfo->local_index);
+		p_solver->solveSinglePatch(pinfo, fs, us);
+		p_operator->applySinglePatch(pinfo, us, rs, true);
+		nested_loop<3>(fs[0].getStart(), fs[0].getEnd(), [&](const array<int, 3> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			INFO("zi:    " << coord[2]);
+			CHECK(rs[0][coord] == Approx(fs[0][coord]).margin(1e-8));
+		});
+	}
+}
+TEST_CASE("Test Poisson::DFTPatchSolver batched apply and smooth match unbatched",
+          "[Poisson::DFTPatchSolver]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto batch_size = GENERATE(2, 3, 64);
+	INFO("BATCH SIZE " << batch_size);
+	auto use_smooth = GENERATE(false, true);
+	INFO("SMOOTH " << use_smooth);
+	auto neumann = GENERATE(false, true);
+	INFO("NEUMANN " << neumann);
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sinl(M_PI * y) * cosl(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sinl(M_PI * y) * cosl(2 * M_PI * x) + x * y;
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto u_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, u_expected, gfun);
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	u->copy(u_expected);
+
+	auto gf           = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator   = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf, neumann);
+	auto p_solver     = make_shared<Poisson::DFTPatchSolver<2>>(p_operator);
+	auto batch_solver = make_shared<Poisson::DFTPatchSolver<2>>(p_operator, batch_size);
+	CHECK(p_solver->getBatchSize() == 1);
+	CHECK(batch_solver->getBatchSize() == batch_size);
+
+	if (use_smooth) {
+		p_solver->smooth(f_vec, u_expected);
+		batch_solver->smooth(f_vec, u);
+	} else {
+		p_solver->apply(f_vec, u_expected);
+		batch_solver->apply(f_vec, u);
+	}
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> u_ld          = u->getLocalData(0, pinfo->local_index);
+		LocalData<2> u_expected_ld = u_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(u_ld[coord] == Approx(u_expected_ld[coord]).margin(1e-12));
+		});
+	}
+}
+TEST_CASE("Test Poisson::DFTPatchSolver smooth matches solving the patches one at a time",
+          "[Poisson::DFTPatchSolver]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto batch_size = GENERATE(1, 4);
+	INFO("BATCH SIZE " << batch_size);
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sinl(M_PI * y) * cosl(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sinl(M_PI * y) * cosl(2 * M_PI * x) + x * y;
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	auto p_solver   = make_shared<Poisson::DFTPatchSolver<2>>(p_operator, batch_size);
+	CHECK(p_solver->isThreadSafe());
+
+	auto u_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	u_expected->copy(g_vec);
+	gf->fillGhost(u_expected);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		auto fs = f_vec->getLocalDatas(pinfo->local_index);
+		auto us = u_expected->getLocalDatas(pinfo->local_index);
+		p_solver->solveSinglePatch(pinfo, fs, us);
+	}
+
+	p_solver->smooth(f_vec, g_vec);
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> u_ld          = g_vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> u_expected_ld = u_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(u_ld[coord] == Approx(u_expected_ld[coord]).margin(1e-12));
+		});
+	}
+}
+TEST_CASE("Test Poisson::DFTPatchSolver throws with batch size less than 1",
+          "[Poisson::DFTPatchSolver]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {10, 10}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	CHECK_THROWS_AS(Poisson::DFTPatchSolver<2>(p_operator, 0), RuntimeError);
+}
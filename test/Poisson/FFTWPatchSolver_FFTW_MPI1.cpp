@@ -25,8 +25,11 @@
 #include <ThunderEgg/DomainTools.h>
 #include <ThunderEgg/GMG/LinearRestrictor.h>
 #include <ThunderEgg/Poisson/FFTWPatchSolver.h>
+#include <ThunderEgg/Poisson/FFTWWisdom.h>
 #include <ThunderEgg/Poisson/StarPatchOperator.h>
 #include <ThunderEgg/ValVector.h>
+#include <cstdio>
+#include <fstream>
 using namespace std;
 using namespace ThunderEgg;
 #define MESHES                                                                                     \
@@ -203,4 +206,200 @@ TEST_CASE(
 	}
 	INFO("Errors: " << errors[0] << ", " << errors[1]);
 	CHECK(log(errors[0] / errors[1]) / log(2) > 1.8);
-}
\ No newline at end of file
+}
+TEST_CASE("Test Poisson::FFTWPatchSolver smooth matches solving the patches one at a time",
+          "[Poisson::FFTWPatchSolver]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sinl(M_PI * y) * cosl(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sinl(M_PI * y) * cosl(2 * M_PI * x) + x * y;
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	auto p_solver   = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator);
+	CHECK(p_solver->isThreadSafe());
+
+	auto u_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	u_expected->copy(g_vec);
+	gf->fillGhost(u_expected);
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		auto fs = f_vec->getLocalDatas(pinfo->local_index);
+		auto us = u_expected->getLocalDatas(pinfo->local_index);
+		p_solver->solveSinglePatch(pinfo, fs, us);
+	}
+
+	p_solver->smooth(f_vec, g_vec);
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> u_ld          = g_vec->getLocalData(0, pinfo->local_index);
+		LocalData<2> u_expected_ld = u_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(u_ld[coord] == u_expected_ld[coord]);
+		});
+	}
+}
+TEST_CASE("Test Poisson::FFTWPatchSolver batched apply and smooth match unbatched",
+          "[Poisson::FFTWPatchSolver]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto batch_size = GENERATE(2, 3, 64);
+	INFO("BATCH SIZE " << batch_size);
+	auto use_smooth = GENERATE(false, true);
+	INFO("SMOOTH " << use_smooth);
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sinl(M_PI * y) * cosl(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sinl(M_PI * y) * cosl(2 * M_PI * x) + x * y;
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto u_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, u_expected, gfun);
+	auto u = ValVector<2>::GetNewVector(d_fine, 1);
+	u->copy(u_expected);
+
+	auto gf           = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator   = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	auto p_solver     = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator);
+	auto batch_solver = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator, batch_size);
+	CHECK(p_solver->getBatchSize() == 1);
+	CHECK(batch_solver->getBatchSize() == batch_size);
+
+	if (use_smooth) {
+		p_solver->smooth(f_vec, u_expected);
+		batch_solver->smooth(f_vec, u);
+	} else {
+		p_solver->apply(f_vec, u_expected);
+		batch_solver->apply(f_vec, u);
+	}
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> u_ld          = u->getLocalData(0, pinfo->local_index);
+		LocalData<2> u_expected_ld = u_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(u_ld[coord] == Approx(u_expected_ld[coord]).margin(1e-12));
+		});
+	}
+}
+TEST_CASE("Test Poisson::FFTWPatchSolver throws with batch size less than 1",
+          "[Poisson::FFTWPatchSolver]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {10, 10}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+	CHECK_THROWS_AS(Poisson::FFTWPatchSolver<2>(p_operator, 0), RuntimeError);
+}
+TEST_CASE("Test Poisson::FFTWPatchSolver planner flag", "[Poisson::FFTWPatchSolver]")
+{
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {10, 10}, 1);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	auto default_solver = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator);
+	CHECK(default_solver->getPlannerFlag() == FFTW_MEASURE);
+
+	auto planner_flag = GENERATE(FFTW_ESTIMATE, FFTW_MEASURE, FFTW_PATIENT);
+	auto p_solver     = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator, 1, planner_flag);
+	CHECK(p_solver->getPlannerFlag() == planner_flag);
+
+	CHECK_THROWS_AS(Poisson::FFTWPatchSolver<2>(p_operator, 1, FFTW_WISDOM_ONLY), RuntimeError);
+}
+TEST_CASE("Test Poisson::FFTWWisdom import of a missing file", "[Poisson::FFTWPatchSolver]")
+{
+	std::remove("fftw_wisdom_missing_test");
+	CHECK_FALSE(Poisson::FFTWWisdom::Import("fftw_wisdom_missing_test", MPI_COMM_SELF));
+}
+TEST_CASE("Test Poisson::FFTWWisdom import of an empty file", "[Poisson::FFTWPatchSolver]")
+{
+	std::ofstream("fftw_wisdom_empty_test");
+	CHECK_FALSE(Poisson::FFTWWisdom::Import("fftw_wisdom_empty_test", MPI_COMM_SELF));
+	std::remove("fftw_wisdom_empty_test");
+}
+TEST_CASE("Test Poisson::FFTWPatchSolver wisdom file", "[Poisson::FFTWPatchSolver]")
+{
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader("mesh_inputs/2d_uniform_2x2_mpi1.json", {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sinl(M_PI * y) * cosl(2 * M_PI * x);
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	std::string wisdom_file = "fftw_wisdom_test";
+	std::remove(wisdom_file.c_str());
+	CHECK_FALSE(Poisson::FFTWWisdom::Import(wisdom_file, MPI_COMM_WORLD));
+	auto p_solver = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator, 1, FFTW_MEASURE);
+	Poisson::FFTWWisdom::Export(wisdom_file, MPI_COMM_WORLD);
+
+	// planning again uses the saved wisdom
+	fftw_forget_wisdom();
+	CHECK(Poisson::FFTWWisdom::Import(wisdom_file, MPI_COMM_WORLD));
+	auto wisdom_solver = make_shared<Poisson::FFTWPatchSolver<2>>(p_operator, 1, FFTW_MEASURE);
+
+	auto u          = ValVector<2>::GetNewVector(d_fine, 1);
+	auto u_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	p_solver->apply(f_vec, u_expected);
+	wisdom_solver->apply(f_vec, u);
+	std::remove(wisdom_file.c_str());
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> u_ld          = u->getLocalData(0, pinfo->local_index);
+		LocalData<2> u_expected_ld = u_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(u_ld.getStart(), u_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(u_ld[coord] == Approx(u_expected_ld[coord]).margin(1e-12));
+		});
+	}
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019  ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+
+#include "catch.hpp"
+#include <ThunderEgg/Poisson/FFTWWisdom.h>
+#include <cstdio>
+#include <fftw3.h>
+#include <vector>
+using namespace std;
+using namespace ThunderEgg;
+TEST_CASE("Test Poisson::FFTWWisdom export saves the wisdom of every rank",
+          "[Poisson::FFTWWisdom]")
+{
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	// each rank plans a transform size that the other rank does not
+	fftw_r2r_kind kind = FFTW_RODFT10;
+	int           n    = 16 + rank;
+	vector<double> in(n);
+	vector<double> out(n);
+	fftw_destroy_plan(fftw_plan_r2r(1, &n, in.data(), out.data(), &kind, FFTW_MEASURE));
+
+	string wisdom_file = "fftw_wisdom_mpi2_test";
+	Poisson::FFTWWisdom::Export(wisdom_file, MPI_COMM_WORLD);
+
+	fftw_forget_wisdom();
+	CHECK(Poisson::FFTWWisdom::Import(wisdom_file, MPI_COMM_WORLD));
+	if (rank == 0) {
+		remove(wisdom_file.c_str());
+	}
+
+	// the plans of both ranks can be created from the wisdom alone
+	for (int size : {16, 17}) {
+		INFO("SIZE: " << size);
+		vector<double> size_in(size);
+		vector<double> size_out(size);
+		fftw_plan      plan = fftw_plan_r2r(1, &size, size_in.data(), size_out.data(), &kind,
+                                       FFTW_MEASURE | FFTW_WISDOM_ONLY);
+		CHECK(plan != nullptr);
+		if (plan != nullptr) {
+			fftw_destroy_plan(plan);
+		}
+	}
+}
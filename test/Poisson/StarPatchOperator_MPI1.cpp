@@ -305,6 +305,195 @@ TEST_CASE("Test Poisson::StarPatchOperator gets 2nd order convergence with neuma
 	INFO("Errors: " << errors[0] << ", " << errors[1]);
 	CHECK(log(errors[0] / errors[1]) / log(2) > 1.8);
 }
+TEST_CASE("Test Poisson::StarPatchOperator residual matches apply then subtract",
+          "[Poisson::StarPatchOperator]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto neumann = GENERATE(false, true);
+	INFO("NEUMANN " << neumann);
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost, neumann);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sin(M_PI * y) * cos(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sin(M_PI * y) * cos(2 * M_PI * x) + x * x;
+	};
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf, neumann);
+
+	auto r_expected = ValVector<2>::GetNewVector(d_fine, 1);
+	p_operator->apply(g_vec, r_expected);
+	r_expected->scaleThenAdd(-1, f_vec);
+
+	auto r = ValVector<2>::GetNewVector(d_fine, 1);
+	p_operator->residual(f_vec, g_vec, r);
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> r_ld          = r->getLocalData(0, pinfo->local_index);
+		LocalData<2> r_expected_ld = r_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(r_ld.getStart(), r_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(r_ld[coord] == r_expected_ld[coord]);
+		});
+	}
+}
+TEST_CASE("Test Poisson::StarPatchOperator uses fixed size kernels for registered patch sizes",
+          "[Poisson::StarPatchOperator]")
+{
+	auto                  n         = GENERATE(8, 16, 32);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	CHECK(p_operator->usesFixedSizeKernels());
+}
+TEST_CASE("Test Poisson::StarPatchOperator uses generic kernels for other patch sizes",
+          "[Poisson::StarPatchOperator]")
+{
+	auto                  ns        = GENERATE(array<int, 2>{10, 10}, array<int, 2>{8, 16});
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, ns, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	CHECK_FALSE(p_operator->usesFixedSizeKernels());
+}
+TEST_CASE("Test Poisson::StarPatchOperator RegisterPatchSize", "[Poisson::StarPatchOperator]")
+{
+	int                   n         = 6;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	Poisson::StarPatchOperator<2>::RegisterPatchSize<6>();
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	CHECK(p_operator->usesFixedSizeKernels());
+}
+TEST_CASE("Test Poisson::StarPatchOperator fixed size kernels match generic kernels",
+          "[Poisson::StarPatchOperator]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto neumann = GENERATE(false, true);
+	INFO("NEUMANN " << neumann);
+	auto n = GENERATE(8, 16);
+	INFO("N " << n);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost, neumann);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto ffun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return -5 * M_PI * M_PI * sin(M_PI * y) * cos(2 * M_PI * x);
+	};
+	auto gfun = [](const std::array<double, 2> &coord) {
+		double x = coord[0];
+		double y = coord[1];
+		return sin(M_PI * y) * cos(2 * M_PI * x) + x * x;
+	};
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf, neumann);
+	REQUIRE(p_operator->usesFixedSizeKernels());
+
+	// interleaving two components gives a stride of 2, which takes the generic path
+	ValVectorStorage storage;
+	storage.interleaved = true;
+
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, f_vec, ffun);
+	auto g_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	DomainTools::SetValues<2>(d_fine, g_vec, gfun);
+	auto f_generic = ValVector<2>::GetNewVector(d_fine, 2, storage);
+	DomainTools::SetValues<2>(d_fine, f_generic, ffun, gfun);
+	auto g_generic = ValVector<2>::GetNewVector(d_fine, 2, storage);
+	DomainTools::SetValues<2>(d_fine, g_generic, gfun, ffun);
+
+	auto f_fixed = ValVector<2>::GetNewVector(d_fine, 1);
+	p_operator->apply(g_vec, f_fixed);
+	auto r_fixed = ValVector<2>::GetNewVector(d_fine, 1);
+	p_operator->residual(f_vec, g_vec, r_fixed);
+
+	auto f_expected = ValVector<2>::GetNewVector(d_fine, 2, storage);
+	p_operator->apply(g_generic, f_expected);
+	auto r_expected = ValVector<2>::GetNewVector(d_fine, 2, storage);
+	p_operator->residual(f_generic, g_generic, r_expected);
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<2> f_ld          = f_fixed->getLocalData(0, pinfo->local_index);
+		LocalData<2> f_expected_ld = f_expected->getLocalData(0, pinfo->local_index);
+		LocalData<2> r_ld          = r_fixed->getLocalData(0, pinfo->local_index);
+		LocalData<2> r_expected_ld = r_expected->getLocalData(0, pinfo->local_index);
+		nested_loop<2>(f_ld.getStart(), f_ld.getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			CHECK(f_ld[coord] == f_expected_ld[coord]);
+			CHECK(r_ld[coord] == r_expected_ld[coord]);
+		});
+	}
+}
+TEST_CASE("Test Poisson::StarPatchOperator diagonal matches applying to unit vectors",
+          "[Poisson::StarPatchOperator]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	auto neumann = GENERATE(false, true);
+	INFO("NEUMANN " << neumann);
+	int                   n         = 4;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost, neumann);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiLinearGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf, neumann);
+
+	auto u_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	auto f_vec = ValVector<2>::GetNewVector(d_fine, 1);
+	auto d_vec = ValVector<2>::GetNewVector(d_fine, 1);
+
+	for (auto pinfo : d_fine->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		auto ds = d_vec->getLocalDatas(pinfo->local_index);
+		p_operator->getDiagonalSinglePatch(pinfo, ds);
+		nested_loop<2>(ds[0].getStart(), ds[0].getEnd(), [&](const array<int, 2> &coord) {
+			INFO("xi:    " << coord[0]);
+			INFO("yi:    " << coord[1]);
+			u_vec->setWithGhost(0);
+			auto us      = u_vec->getLocalDatas(pinfo->local_index);
+			auto fs      = f_vec->getLocalDatas(pinfo->local_index);
+			us[0][coord] = 1;
+			p_operator->applySinglePatch(pinfo, us, fs, false);
+			CHECK(fs[0][coord] == Approx(ds[0][coord]));
+		});
+	}
+}
 TEST_CASE("Test Poisson::StarPatchOperator constructor throws exception with no ghost cells",
           "[Poisson::StarPatchOperator]")
 {
@@ -319,4 +508,16 @@ TEST_CASE("Test Poisson::StarPatchOperator constructor throws exception with no
 	auto gf = make_shared<BiLinearGhostFiller>(d_fine);
 	CHECK_THROWS_AS(make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf),
 	                ThunderEgg::RuntimeError);
-}
\ No newline at end of file
+}
+TEST_CASE("Test Poisson::StarPatchOperator is thread safe", "[Poisson::StarPatchOperator]")
+{
+	int                   n         = 10;
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {n, n}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	auto gf         = make_shared<BiQuadraticGhostFiller>(d_fine);
+	auto p_operator = make_shared<Poisson::StarPatchOperator<2>>(d_fine, gf);
+
+	CHECK(p_operator->isThreadSafe());
+}
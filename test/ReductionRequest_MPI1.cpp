@@ -0,0 +1,40 @@
+#include "catch.hpp"
+#include <ThunderEgg/ReductionRequest.h>
+#include <utility>
+using namespace std;
+using namespace ThunderEgg;
+
+TEST_CASE("ReductionRequest reduces the given values", "[ReductionRequest]")
+{
+	double values[] = {1, 2, 3, 4};
+
+	ReductionRequest request(values, 4, MPI_SUM, MPI_COMM_WORLD);
+	values[0] = 100;
+
+	REQUIRE(request.getNumValues() == 4);
+	const double *result = request.wait();
+	CHECK(result[0] == 1);
+	CHECK(result[1] == 2);
+	CHECK(result[2] == 3);
+	CHECK(result[3] == 4);
+}
+TEST_CASE("ReductionRequest move constructor keeps the reduced values", "[ReductionRequest]")
+{
+	double values[] = {5, 6};
+
+	ReductionRequest request(values, 2, MPI_MAX, MPI_COMM_WORLD);
+	ReductionRequest moved(std::move(request));
+
+	REQUIRE(moved.getNumValues() == 2);
+	const double *result = moved.wait();
+	CHECK(result[0] == 5);
+	CHECK(result[1] == 6);
+}
+TEST_CASE("ReductionRequest throws with too many values", "[ReductionRequest]")
+{
+	double values[ReductionRequest::max_values + 1] = {};
+
+	CHECK_THROWS_AS(
+	ReductionRequest(values, ReductionRequest::max_values + 1, MPI_SUM, MPI_COMM_WORLD),
+	RuntimeError);
+}
@@ -49,6 +49,19 @@ TEST_CASE("Schur::PatchIfaceScatter<2> throws exception for non-square patches",
 
 	CHECK_THROWS_AS(Schur::PatchIfaceScatter<2>(iface_domain), RuntimeError);
 }
+TEST_CASE("Schur::PatchIfaceScatter<2> throws exception for SharedMemory backend",
+          "[Schur::PatchIfaceScatter]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH: " << mesh_file);
+	DomainReader<2> domain_reader(mesh_file, {5, 5}, 0);
+	auto            domain       = domain_reader.getFinerDomain();
+	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
+
+	CHECK_THROWS_AS(
+	(Schur::PatchIfaceScatter<2>(iface_domain, GhostExchangeBackend::SharedMemory)),
+	RuntimeError);
+}
 TEST_CASE("Schur::PatchIfaceScatter<2> scatterStart throws exception when called twice",
           "[Schur::PatchIfaceScatter]")
 {
@@ -356,4 +369,17 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter with local vector already filled"
 			}
 		}
 	}
-}
\ No newline at end of file
+}TEST_CASE("Schur::PatchIfaceScatter<2> getExchangeBackend", "[Schur::PatchIfaceScatter]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH: " << mesh_file);
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
+	DomainReader<2> domain_reader(mesh_file, {5, 5}, 0);
+	auto            domain       = domain_reader.getFinerDomain();
+	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
+
+	Schur::PatchIfaceScatter<2> scatter(iface_domain, backend);
+	CHECK(scatter.getExchangeBackend() == backend);
+}
@@ -242,6 +242,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter local interfaces are copied",
 }
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -251,7 +254,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
@@ -284,6 +287,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 }
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -293,7 +299,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatte
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
@@ -329,6 +335,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatte
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter with local vector already filled",
           "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -338,7 +347,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter with local vector already filled"
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
@@ -239,6 +239,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter local interfaces are copied",
 }
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -248,7 +251,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
@@ -281,6 +284,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter", "[Schur::PatchIfaceScatter]")
 }
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -290,7 +296,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatte
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
@@ -326,6 +332,9 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter twice", "[Schur::PatchIfaceScatte
 TEST_CASE("Schur::PatchIfaceScatter<2> scatter with local vector already filled",
           "[Schur::PatchIfaceScatter]")
 {
+	auto backend
+	= GENERATE(GhostExchangeBackend::PointToPoint, GhostExchangeBackend::NeighborCollective);
+	INFO("BACKEND: " << backend);
 	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
 	INFO("MESH: " << mesh_file);
 	auto n = GENERATE(5, 10);
@@ -335,7 +344,7 @@ TEST_CASE("Schur::PatchIfaceScatter<2> scatter with local vector already filled"
 	auto            domain       = domain_reader.getFinerDomain();
 	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
 
-	Schur::PatchIfaceScatter<2>  scatter(iface_domain);
+	Schur::PatchIfaceScatter<2>  scatter(iface_domain, backend);
 	Schur::ValVectorGenerator<1> vg(iface_domain);
 
 	auto global_vector = vg.getNewVector();
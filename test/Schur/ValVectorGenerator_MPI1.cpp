@@ -41,6 +41,25 @@ TEST_CASE("Schur::ValVectorGenerator<2> works for various meshes", "[Schur::ValV
 	CHECK(vector->getNumLocalPatches() == iface_domain->getNumLocalInterfaces());
 	CHECK(vector->getNumLocalCells() == 10 * iface_domain->getNumLocalInterfaces());
 }
+TEST_CASE("Schur::ValVectorGenerator<2> reuses released vectors", "[Schur::ValVectorGenerator]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH: " << mesh_file);
+	DomainReader<2> domain_reader(mesh_file, {10, 10}, 0);
+	auto            domain       = domain_reader.getFinerDomain();
+	auto            iface_domain = make_shared<Schur::InterfaceDomain<2>>(domain);
+
+	Schur::ValVectorGenerator<1> vg(iface_domain);
+
+	auto       vector  = vg.getNewVector();
+	Vector<1> *address = vector.get();
+	vector->set(2);
+	vector = nullptr;
+
+	auto recycled = vg.getNewVector();
+	CHECK(recycled.get() == address);
+	CHECK(recycled->infNorm() == 0);
+}
 TEST_CASE("Schur::ValVectorGenerator<2> throws exception for non-square patches",
           "[Schur::ValVectorGenerator]")
 {
@@ -303,4 +303,223 @@ TEST_CASE("TriLinearGhostFiller constructor throws error with odd number of cell
 	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
 
 	CHECK_THROWS_AS(TriLinearGhostFiller(d), RuntimeError);
-}
\ No newline at end of file
+}
+TEST_CASE("exchange various meshes 3D TriLinearGhostFiller fills edge and corner ghosts",
+          "[TriLinearGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	auto nz        = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<3>       domain_reader(mesh_file, {nx, ny, nz}, num_ghost);
+	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<3>> vec      = ValVector<3>::GetNewVector(d, 1);
+	shared_ptr<ValVector<3>> expected = ValVector<3>::GetNewVector(d, 1);
+
+	// values from neighbors on the same level are copied, so a linear function is exact on a
+	// uniform mesh. Across refinement levels only a constant function is exact.
+	bool uniform_mesh = mesh_file == single_mesh_file;
+	auto f            = [&](const std::array<double, 3> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		double z = coord[2];
+		return uniform_mesh ? 1 + x * 0.3 + y + z * 0.7 : 2.5;
+	};
+
+	DomainTools::SetValues<3>(d, vec, f);
+	DomainTools::SetValuesWithGhost<3>(d, expected, f);
+
+	TriLinearGhostFiller tlgf(d, GhostExchangeBackend::PointToPoint, true);
+	tlgf.fillGhost(vec);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<3> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<3> expected_ld = expected->getLocalData(0, pinfo->local_index);
+		auto check_diagonal_ghost = [&](const array<int, 3> &coord) {
+			int num_outside = 0;
+			for (int i = 0; i < 3; i++) {
+				num_outside += coord[i] < 0 || coord[i] >= pinfo->ns[i];
+			}
+			std::array<double, 3> real_coord;
+			DomainTools::GetRealCoordGhost<3>(pinfo, coord, real_coord);
+			bool in_domain = true;
+			for (double x : real_coord) {
+				in_domain = in_domain && x > 0 && x < 1;
+			}
+			if (num_outside >= 2 && in_domain) {
+				INFO("coord: " << coord[0] << " " << coord[1] << " " << coord[2]);
+				CHECK(vec_ld[coord] == Approx(expected_ld[coord]));
+			}
+		};
+		nested_loop<3>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(), check_diagonal_ghost);
+	}
+}
+
+namespace
+{
+/**
+ * @brief a TriLinearGhostFiller that fills ghosts without the compiled table
+ */
+class NoStencilTriLinearGhostFiller : public TriLinearGhostFiller
+{
+	public:
+	using TriLinearGhostFiller::TriLinearGhostFiller;
+	bool getLocalPatchStencil(std::shared_ptr<const PatchInfo<3>> pinfo,
+	                          std::vector<GhostFillTerm<3>> &     terms) const override
+	{
+		return false;
+	}
+};
+} // namespace
+TEST_CASE("TriLinearGhostFiller compiled table matches the ghost fill", "[TriLinearGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	auto nz        = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<3>       domain_reader(mesh_file, {nx, ny, nz}, num_ghost);
+	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<3>> vec      = ValVector<3>::GetNewVector(d, 2);
+	shared_ptr<ValVector<3>> expected = ValVector<3>::GetNewVector(d, 2);
+
+	auto f = [&](const std::array<double, 3> coord) -> double {
+		double value = 1;
+		for (double x : coord) {
+			value = value * exp(x) + 1.0 / 3.0;
+		}
+		return value;
+	};
+	auto g = [&](const std::array<double, 3> coord) -> double {
+		return sin(coord[0] + 2 * coord[1]);
+	};
+
+	DomainTools::SetValues<3>(d, vec, f, g);
+	DomainTools::SetValues<3>(d, expected, f, g);
+
+	TriLinearGhostFiller          filler(d);
+	NoStencilTriLinearGhostFiller no_stencil_filler(d);
+	filler.fillGhost(vec);
+	no_stencil_filler.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		for (int c = 0; c < 2; c++) {
+			LocalData<3> vec_ld      = vec->getLocalData(c, pinfo->local_index);
+			LocalData<3> expected_ld = expected->getLocalData(c, pinfo->local_index);
+			nested_loop<3>(vec_ld.getGhostStart(), vec_ld.getGhostEnd(),
+			               [&](const array<int, 3> &coord) {
+				               CHECK(vec_ld[coord] == expected_ld[coord]);
+			               });
+		}
+	}
+}
+TEST_CASE("TriLinearGhostFiller overwrites stale ghost values", "[TriLinearGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	auto nz        = GENERATE(2, 4);
+	int  num_ghost = GENERATE(1, 2);
+
+	DomainReader<3>       domain_reader(mesh_file, {nx, ny, nz}, num_ghost);
+	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<3>> vec      = ValVector<3>::GetNewVector(d, 1);
+	shared_ptr<ValVector<3>> expected = ValVector<3>::GetNewVector(d, 1);
+
+	auto f = [&](const std::array<double, 3> coord) -> double {
+		double value = 1;
+		for (double x : coord) {
+			value = value * exp(x) + 1.0 / 3.0;
+		}
+		return value;
+	};
+	auto stale = [&](const std::array<double, 3> coord) -> double {
+		return 1e10;
+	};
+
+	DomainTools::SetValuesWithGhost<3>(d, vec, stale);
+	DomainTools::SetValues<3>(d, vec, f);
+	DomainTools::SetValues<3>(d, expected, f);
+
+	TriLinearGhostFiller filler(d);
+	filler.fillGhost(vec);
+	filler.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<3> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<3> expected_ld = expected->getLocalData(0, pinfo->local_index);
+		for (Side<3> s : Side<3>::getValues()) {
+			if (pinfo->hasNbr(s)) {
+				INFO("side:      " << s);
+				for (int i = 0; i < num_ghost; i++) {
+					LocalData<2> vec_ghost      = vec_ld.getGhostSliceOnSide(s, i + 1);
+					LocalData<2> expected_ghost = expected_ld.getGhostSliceOnSide(s, i + 1);
+					nested_loop<2>(vec_ghost.getStart(), vec_ghost.getEnd(),
+					               [&](const array<int, 2> &coord) {
+						               CHECK(vec_ghost[coord] == expected_ghost[coord]);
+					               });
+				}
+			}
+		}
+	}
+}
+TEST_CASE("TriLinearGhostFiller in single precision matches double", "[TriLinearGhostFiller]")
+{
+	auto mesh_file = GENERATE(as<std::string>{}, single_mesh_file, refined_mesh_file);
+	INFO("MESH: " << mesh_file);
+	auto nx        = GENERATE(2, 4);
+	auto ny        = GENERATE(2, 4);
+	auto nz        = GENERATE(2, 4);
+	int  num_ghost = 1;
+
+	DomainReader<3>       domain_reader(mesh_file, {nx, ny, nz}, num_ghost);
+	shared_ptr<Domain<3>> d = domain_reader.getFinerDomain();
+
+	shared_ptr<ValVector<3, float>> vec      = ValVector<3, float>::GetNewVector(d, 1);
+	shared_ptr<ValVector<3>>        expected = ValVector<3>::GetNewVector(d, 1);
+
+	auto f = [&](const std::array<double, 3> coord) -> double {
+		double x = coord[0];
+		double y = coord[1];
+		double z = coord[2];
+		return 1 + 0.5 * x + y + 7 * z;
+	};
+
+	DomainTools::SetValues<3>(d, expected, f);
+	vec->copyWithConversion(*expected);
+
+	BasicTriLinearGhostFiller<float> float_filler(d);
+	float_filler.fillGhost(vec);
+	TriLinearGhostFiller filler(d);
+	filler.fillGhost(expected);
+
+	for (auto pinfo : d->getPatchInfoVector()) {
+		INFO("Patch: " << pinfo->id);
+		LocalData<3, float> vec_ld      = vec->getLocalData(0, pinfo->local_index);
+		LocalData<3>        expected_ld = expected->getLocalData(0, pinfo->local_index);
+		for (Side<3> s : Side<3>::getValues()) {
+			if (pinfo->hasNbr(s)) {
+				INFO("side:      " << s);
+				LocalData<2, float> vec_ghost      = vec_ld.getGhostSliceOnSide(s, 1);
+				LocalData<2>        expected_ghost = expected_ld.getGhostSliceOnSide(s, 1);
+				nested_loop<2>(vec_ghost.getStart(), vec_ghost.getEnd(),
+				               [&](const array<int, 2> &coord) {
+					               CHECK(vec_ghost[coord]
+					                     == Approx(expected_ghost[coord]).epsilon(1e-6));
+				               });
+			}
+		}
+	}
+}
@@ -48,4 +48,69 @@ TEST_CASE("ValVectorGenerator getNewVector", "[ValVectorGenerator]")
 	CHECK(val_vector->getMPIComm() == MPI_COMM_WORLD);
 	CHECK(val_vector->getLocalData(0, 0).getLengths()[0] == nx);
 	CHECK(val_vector->getLocalData(0, 0).getLengths()[1] == ny);
-}
\ No newline at end of file
+}
+TEST_CASE("ValVectorGenerator reuses released vectors", "[ValVectorGenerator]")
+{
+	int  num_components = GENERATE(1, 2);
+	auto mesh_file      = GENERATE(as<std::string>{}, MESHES);
+	INFO("MESH FILE " << mesh_file);
+	int                   num_ghost = 1;
+	DomainReader<2>       domain_reader(mesh_file, {4, 5}, num_ghost);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ValVectorGenerator<2> vg(d_fine, num_components);
+	auto                  vec     = vg.getNewVector();
+	Vector<2> *           address = vec.get();
+	vec->setWithGhost(3);
+	vec = nullptr;
+
+	CHECK(vg.getPool()->getNumFreeVectors() == 1);
+
+	auto recycled = vg.getNewVector();
+	CHECK(recycled.get() == address);
+	CHECK(vg.getPool()->getNumFreeVectors() == 0);
+	for (int c = 0; c < num_components; c++) {
+		for (int p = 0; p < recycled->getNumLocalPatches(); p++) {
+			LocalData<2> ld = recycled->getLocalData(c, p);
+			nested_loop<2>(ld.getGhostStart(), ld.getGhostEnd(),
+			               [&](const std::array<int, 2> &coord) { CHECK(ld[coord] == 0); });
+		}
+	}
+
+	auto other = vg.getNewVector();
+	CHECK(other.get() != address);
+}
+TEST_CASE("ValVectorGenerator pool clear keeps vectors that are in use", "[ValVectorGenerator]")
+{
+	auto                  mesh_file = GENERATE(as<std::string>{}, MESHES);
+	DomainReader<2>       domain_reader(mesh_file, {4, 4}, 0);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	ValVectorGenerator<2> vg(d_fine, 1);
+	auto                  in_use   = vg.getNewVector();
+	auto                  released = vg.getNewVector();
+	released                       = nullptr;
+	in_use->set(2);
+
+	CHECK(vg.getPool()->getNumFreeVectors() == 1);
+	vg.getPool()->clear();
+	CHECK(vg.getPool()->getNumFreeVectors() == 0);
+
+	CHECK(in_use->infNorm() == 2);
+	auto other = vg.getNewVector();
+	CHECK(other.get() != in_use.get());
+}
+TEST_CASE("ValVectorGenerator vectors outlive the generator", "[ValVectorGenerator]")
+{
+	auto                  mesh_file = GENERATE(as<std::string>{}, MESHES);
+	DomainReader<2>       domain_reader(mesh_file, {4, 4}, 0);
+	shared_ptr<Domain<2>> d_fine = domain_reader.getFinerDomain();
+
+	shared_ptr<Vector<2>> vec;
+	{
+		ValVectorGenerator<2> vg(d_fine, 1);
+		vec = vg.getNewVector();
+	}
+	vec->set(1);
+	CHECK(vec->infNorm() == 1);
+}
@@ -111,7 +111,7 @@ TEST_CASE("ValVector<1> getNumLocalCells", "[ValVector]")
 
 	CHECK(val_vector->getNumLocalCells() == nx * num_local_patches);
 }
-TEST_CASE("ValVector<1> getValArray", "[ValVector]")
+TEST_CASE("ValVector<1> getSize", "[ValVector]")
 {
 	int           num_components    = GENERATE(1, 2, 3);
 	auto          num_ghost_cells   = GENERATE(0, 1, 5);
@@ -127,7 +127,7 @@ TEST_CASE("ValVector<1> getValArray", "[ValVector]")
 	auto val_vector = make_shared<ValVector<1>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	CHECK(val_vector->getValArray().size() == size);
+	CHECK(val_vector->getSize() == size);
 }
 TEST_CASE("ValVector<2> getNumGhostCells", "[ValVector]")
 {
@@ -224,7 +224,7 @@ TEST_CASE("ValVector<2> getNumLocalCells", "[ValVector]")
 
 	CHECK(val_vector->getNumLocalCells() == nx * ny * num_local_patches);
 }
-TEST_CASE("ValVector<2> getValArray", "[ValVector]")
+TEST_CASE("ValVector<2> getSize", "[ValVector]")
 {
 	int           num_components    = GENERATE(1, 2, 3);
 	auto          num_ghost_cells   = GENERATE(0, 1, 5);
@@ -243,7 +243,165 @@ TEST_CASE("ValVector<2> getValArray", "[ValVector]")
 	auto val_vector = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	CHECK(val_vector->getValArray().size() == size);
+	CHECK(val_vector->getSize() == size);
+}
+TEST_CASE("ValVector<2> first non-ghost cell is aligned", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto val_vector = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                            num_local_patches);
+
+	LocalData<2> ld = val_vector->getLocalData(0, 0);
+	CHECK(reinterpret_cast<uintptr_t>(&ld[{0, 0}]) % 64 == 0);
+	size_t size
+	= (nx + 2 * num_ghost_cells) * (ny + 2 * num_ghost_cells) * num_local_patches * num_components;
+	CHECK(val_vector->getSize() == size);
+}
+TEST_CASE("ValVector<2> padded storage aligns every line", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5, 8);
+	int           ny                = GENERATE(1, 4, 5);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = GENERATE(1, 13);
+	bool          first_touch       = GENERATE(false, true);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("num_local_patches: " << num_local_patches);
+	INFO("first_touch:       " << first_touch);
+
+	ValVectorStorage storage;
+	storage.padded      = true;
+	storage.first_touch = first_touch;
+
+	auto val_vector = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                            num_local_patches, storage);
+
+	CHECK(val_vector->getNumLocalCells() == nx * ny * num_local_patches);
+	for (int p = 0; p < num_local_patches; p++) {
+		for (int c = 0; c < num_components; c++) {
+			LocalData<2> ld = val_vector->getLocalData(c, p);
+			CHECK(ld.getLengths()[0] == nx);
+			CHECK(ld.getLengths()[1] == ny);
+			CHECK(ld.getStrides()[1] % 8 == 0);
+			CHECK(ld.getStrides()[1] >= nx + 2 * num_ghost_cells);
+			for (int yi = 0; yi < ny; yi++) {
+				CHECK(reinterpret_cast<uintptr_t>(&ld[{0, yi}]) % 64 == 0);
+			}
+			nested_loop<2>(ld.getGhostStart(), ld.getGhostEnd(),
+			               [&](const std::array<int, 2> &coord) { CHECK(ld[coord] == 0); });
+		}
+	}
+
+	val_vector->set(2);
+	CHECK(val_vector->infNorm() == 2);
+	CHECK(val_vector->dot(val_vector) == 4 * nx * ny * num_local_patches * num_components);
+}
+TEST_CASE("ValVector<2> interleaved storage stores the components of a cell together",
+          "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = GENERATE(1, 13);
+	bool          padded            = GENERATE(false, true);
+
+	INFO("num_components:    " << num_components);
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("num_local_patches: " << num_local_patches);
+	INFO("padded:            " << padded);
+
+	ValVectorStorage storage;
+	storage.interleaved = true;
+	storage.padded      = padded;
+
+	auto val_vector = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                            num_local_patches, storage);
+
+	CHECK(val_vector->getNumLocalCells() == nx * ny * num_local_patches);
+	CHECK(reinterpret_cast<uintptr_t>(val_vector->getLocalData(0, 0).getPtr()) % 64 == 0);
+	for (int p = 0; p < num_local_patches; p++) {
+		LocalData<2> first_ld = val_vector->getLocalData(0, p);
+		for (int c = 0; c < num_components; c++) {
+			LocalData<2> ld = val_vector->getLocalData(c, p);
+			CHECK(ld.getLengths()[0] == nx);
+			CHECK(ld.getLengths()[1] == ny);
+			CHECK(ld.getStrides()[0] == num_components);
+			CHECK(ld.getStrides()[1] >= num_components * (nx + 2 * num_ghost_cells));
+			nested_loop<2>(ld.getGhostStart(), ld.getGhostEnd(), [&](const array<int, 2> &coord) {
+				CHECK(&ld[coord] == &first_ld[coord] + c);
+				CHECK(ld[coord] == 0);
+			});
+		}
+	}
+}
+TEST_CASE("ValVector<2> interleaved storage gives the same results as separate components",
+          "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = 3;
+
+	INFO("num_components:    " << num_components);
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+
+	ValVectorStorage interleaved;
+	interleaved.interleaved = true;
+
+	shared_ptr<ValVector<2>> a[2];
+	shared_ptr<ValVector<2>> b[2];
+	for (int l = 0; l < 2; l++) {
+		ValVectorStorage storage = l == 0 ? ValVectorStorage() : interleaved;
+		a[l] = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+		                                 num_local_patches, storage);
+		b[l] = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+		                                 num_local_patches, storage);
+		for (int p = 0; p < num_local_patches; p++) {
+			for (int c = 0; c < num_components; c++) {
+				LocalData<2> a_ld = a[l]->getLocalData(c, p);
+				LocalData<2> b_ld = b[l]->getLocalData(c, p);
+				nested_loop<2>(a_ld.getStart(), a_ld.getEnd(), [&](const array<int, 2> &coord) {
+					a_ld[coord] = 0.5 + p + 3 * c + coord[0] - 2 * coord[1];
+					b_ld[coord] = 1.5 - p + c * coord[0] + coord[1];
+				});
+			}
+		}
+	}
+
+	for (int l = 0; l < 2; l++) {
+		a[l]->scaleThenAddScaled(0.5, 2, b[l]);
+		a[l]->shift(1);
+	}
+	CHECK(a[1]->dot(b[1]) == Approx(a[0]->dot(b[0])));
+	CHECK(a[1]->twoNorm() == Approx(a[0]->twoNorm()));
+	CHECK(a[1]->infNorm() == Approx(a[0]->infNorm()));
+	// mixing layouts uses the generic implementation
+	CHECK(a[1]->dot(b[0]) == Approx(a[0]->dot(b[0])));
+	a[1]->addScaled(-1, a[0]);
+	CHECK(a[1]->infNorm() == 0);
 }
 TEST_CASE("ValVector<3> getNumGhostCells", "[ValVector]")
 {
@@ -350,7 +508,7 @@ TEST_CASE("ValVector<3> getNumLocalCells", "[ValVector]")
 
 	CHECK(val_vector->getNumLocalCells() == nx * ny * nz * num_local_patches);
 }
-TEST_CASE("ValVector<3> getValArray", "[ValVector]")
+TEST_CASE("ValVector<3> getSize", "[ValVector]")
 {
 	int           num_components    = GENERATE(1, 2, 3);
 	auto          num_ghost_cells   = GENERATE(0, 1, 5);
@@ -371,7 +529,7 @@ TEST_CASE("ValVector<3> getValArray", "[ValVector]")
 	auto val_vector = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	CHECK(val_vector->getValArray().size() == size);
+	CHECK(val_vector->getSize() == size);
 }
 
 TEST_CASE("ValVector<1> getLocalData", "[ValVector]")
@@ -391,7 +549,7 @@ TEST_CASE("ValVector<1> getLocalData", "[ValVector]")
 	auto val_vector = make_shared<ValVector<1>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -421,7 +579,7 @@ TEST_CASE("ValVector<1> getLocalData const", "[ValVector]")
 	                                            num_local_patches);
 	auto const_val_vector = std::const_pointer_cast<const ValVector<1>>(val_vector);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -452,7 +610,7 @@ TEST_CASE("ValVector<2> getLocalData", "[ValVector]")
 	auto val_vector = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -484,7 +642,7 @@ TEST_CASE("ValVector<2> getLocalData const", "[ValVector]")
 	                                            num_local_patches);
 	auto const_val_vector = std::const_pointer_cast<const ValVector<2>>(val_vector);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -518,7 +676,7 @@ TEST_CASE("ValVector<3> getLocalData", "[ValVector]")
 	auto val_vector = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
 	                                            num_local_patches);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -552,7 +710,7 @@ TEST_CASE("ValVector<3> getLocalData const", "[ValVector]")
 	                                            num_local_patches);
 	auto const_val_vector = std::const_pointer_cast<const ValVector<3>>(val_vector);
 
-	double *view = &val_vector->getValArray()[0];
+	double *view = val_vector->getData();
 	for (int i = 0; i < num_local_patches; i++) {
 		INFO("i:                 " << i);
 		for (int c = 0; c < num_components; c++) {
@@ -586,4 +744,274 @@ TEST_CASE("ValVector getNewVector works", "[ValVector]")
 	CHECK(val_vector->getMPIComm() == MPI_COMM_WORLD);
 	CHECK(val_vector->getLocalData(0, 0).getLengths()[0] == nx);
 	CHECK(val_vector->getLocalData(0, 0).getLengths()[1] == ny);
-}
\ No newline at end of file
+}
+TEST_CASE("ValVector<3> set", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto val_vector = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                            num_local_patches);
+
+	val_vector->set(28);
+
+	for (int i = 0; i < num_local_patches; i++) {
+		for (int c = 0; c < num_components; c++) {
+			LocalData<3> ld = val_vector->getLocalData(c, i);
+			nested_loop<3>(ld.getGhostStart(), ld.getGhostEnd(), [&](std::array<int, 3> &coord) {
+				bool is_ghost = false;
+				for (size_t axis = 0; axis < 3; axis++) {
+					is_ghost = is_ghost || coord[axis] < 0 || coord[axis] >= ns[axis];
+				}
+				if (is_ghost) {
+					CHECK(ld[coord] == 0);
+				} else {
+					CHECK(ld[coord] == 28);
+				}
+			});
+		}
+	}
+}
+TEST_CASE("ValVector<3> scaleThenAddScaled two vectors", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto a = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto b = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto c = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+
+	size_t size = a->getSize();
+	for (size_t i = 0; i < size; i++) {
+		double x        = (i + 0.5) / size;
+		a->getData()[i] = 10 - (x - 0.75) * (x - 0.75);
+		b->getData()[i] = (x - 0.5) * (x - 0.5);
+		c->getData()[i] = 3 * x;
+	}
+	std::vector<double> a_copy(a->getData(), a->getData() + size);
+
+	a->scaleThenAddScaled(0.3, 0.7, b, -1.2, c);
+
+	for (int i = 0; i < num_local_patches; i++) {
+		for (int comp = 0; comp < num_components; comp++) {
+			LocalData<3> a_ld        = a->getLocalData(comp, i);
+			LocalData<3> b_ld        = b->getLocalData(comp, i);
+			LocalData<3> c_ld        = c->getLocalData(comp, i);
+			size_t       first_index = a_ld.getPtr() - a->getData();
+			nested_loop<3>(a_ld.getGhostStart(), a_ld.getGhostEnd(), [&](std::array<int, 3> &coord) {
+				size_t index    = first_index;
+				bool   is_ghost = false;
+				for (size_t axis = 0; axis < 3; axis++) {
+					index += a_ld.getStrides()[axis] * coord[axis];
+					is_ghost = is_ghost || coord[axis] < 0 || coord[axis] >= ns[axis];
+				}
+				if (is_ghost) {
+					CHECK(a_ld[coord] == a_copy[index]);
+				} else {
+					CHECK(a_ld[coord]
+					      == Approx(0.3 * a_copy[index] + 0.7 * b_ld[coord] - 1.2 * c_ld[coord]));
+				}
+			});
+		}
+	}
+}
+TEST_CASE("ValVector<3> twoNorm and dot", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto a = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto b = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+
+	size_t size = a->getSize();
+	for (size_t i = 0; i < size; i++) {
+		double x        = (i + 0.5) / size;
+		a->getData()[i] = 10 - (x - 0.75) * (x - 0.75);
+		b->getData()[i] = (x - 0.5) * (x - 0.5);
+	}
+
+	double expected_norm = 0;
+	double expected_dot  = 0;
+	for (int i = 0; i < num_local_patches; i++) {
+		for (int c = 0; c < num_components; c++) {
+			LocalData<3> a_ld = a->getLocalData(c, i);
+			LocalData<3> b_ld = b->getLocalData(c, i);
+			nested_loop<3>(a_ld.getStart(), a_ld.getEnd(), [&](std::array<int, 3> &coord) {
+				expected_norm += a_ld[coord] * a_ld[coord];
+				expected_dot += a_ld[coord] * b_ld[coord];
+			});
+		}
+	}
+	expected_norm = sqrt(expected_norm);
+
+	CHECK(a->twoNorm() == Approx(expected_norm));
+	CHECK(a->dot(b) == Approx(expected_dot));
+}
+TEST_CASE("ValVector<3> multiDotAndTwoNorm", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto a = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto b = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto c = make_shared<ValVector<3>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+
+	size_t size = a->getSize();
+	for (size_t i = 0; i < size; i++) {
+		double x        = (i + 0.5) / size;
+		a->getData()[i] = 10 - (x - 0.75) * (x - 0.75);
+		b->getData()[i] = (x - 0.5) * (x - 0.5);
+		c->getData()[i] = 3 * x;
+	}
+
+	vector<double> dots = a->multiDotAndTwoNorm({b, c});
+	REQUIRE(dots.size() == 3);
+	CHECK(dots[0] == Approx(a->Vector<3>::dot(b)));
+	CHECK(dots[1] == Approx(a->Vector<3>::dot(c)));
+	CHECK(dots[2] == Approx(a->Vector<3>::twoNorm()));
+}
+TEST_CASE("ValVector<2, float> line kernels match the generic implementation", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2);
+	auto          num_ghost_cells   = GENERATE(0, 1);
+	int           nx                = GENERATE(1, 5, 16);
+	int           ny                = GENERATE(1, 4);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = GENERATE(1, 13);
+	bool          padded            = GENERATE(false, true);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("num_local_patches: " << num_local_patches);
+	INFO("padded:            " << padded);
+
+	ValVectorStorage storage;
+	storage.padded = padded;
+
+	auto a = make_shared<ValVector<2, float>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                          num_local_patches, storage);
+	auto b = make_shared<ValVector<2, float>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                          num_local_patches, storage);
+	auto expected = make_shared<ValVector<2, float>>(MPI_COMM_WORLD, ns, num_ghost_cells,
+	                                                 num_components, num_local_patches, storage);
+
+	LocalData<2, float> first = a->getLocalData(0, 0);
+	CHECK(reinterpret_cast<uintptr_t>(&first[{0, 0}]) % 64 == 0);
+
+	size_t size = a->getSize();
+	for (size_t i = 0; i < size; i++) {
+		double x               = (i + 0.5) / size;
+		a->getData()[i]        = 10 - (x - 0.75) * (x - 0.75);
+		b->getData()[i]        = (x - 0.5) * (x - 0.5);
+		expected->getData()[i] = a->getData()[i];
+	}
+
+	CHECK(a->twoNorm() == Approx(a->Vector<2, float>::twoNorm()));
+	CHECK(a->dot(b) == Approx(a->Vector<2, float>::dot(b)));
+
+	a->addScaled(0.5, b);
+	expected->Vector<2, float>::addScaled(0.5, b);
+	for (int p = 0; p < num_local_patches; p++) {
+		for (int c = 0; c < num_components; c++) {
+			LocalData<2, float> a_ld        = a->getLocalData(c, p);
+			LocalData<2, float> expected_ld = expected->getLocalData(c, p);
+			nested_loop<2>(a_ld.getStart(), a_ld.getEnd(), [&](const array<int, 2> &coord) {
+				CHECK(a_ld[coord] == Approx(expected_ld[coord]));
+			});
+		}
+	}
+}
+TEST_CASE("ValVector<2> copyWithConversion between double and float", "[ValVector]")
+{
+	int           num_components    = GENERATE(1, 2);
+	auto          num_ghost_cells   = GENERATE(0, 1);
+	int           nx                = GENERATE(1, 5);
+	int           ny                = GENERATE(1, 4);
+	array<int, 2> ns                = {nx, ny};
+	int           num_local_patches = GENERATE(1, 13);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("num_local_patches: " << num_local_patches);
+
+	auto d = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                   num_local_patches);
+	auto f = make_shared<ValVector<2, float>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                          num_local_patches);
+	auto d_back = make_shared<ValVector<2>>(MPI_COMM_WORLD, ns, num_ghost_cells, num_components,
+	                                        num_local_patches);
+
+	size_t size = d->getSize();
+	for (size_t i = 0; i < size; i++) {
+		d->getData()[i] = 1.0 / (i + 3);
+	}
+
+	f->copyWithConversion(*d);
+	d_back->copyWithConversion(*f);
+
+	for (int p = 0; p < num_local_patches; p++) {
+		for (int c = 0; c < num_components; c++) {
+			LocalData<2>        d_ld      = d->getLocalData(c, p);
+			LocalData<2, float> f_ld      = f->getLocalData(c, p);
+			LocalData<2>        d_back_ld = d_back->getLocalData(c, p);
+			nested_loop<2>(d_ld.getStart(), d_ld.getEnd(), [&](const array<int, 2> &coord) {
+				CHECK(f_ld[coord] == static_cast<float>(d_ld[coord]));
+				CHECK(d_back_ld[coord] == static_cast<double>(f_ld[coord]));
+			});
+		}
+	}
+}
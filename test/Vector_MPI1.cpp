@@ -766,4 +766,85 @@ TEST_CASE("Vector<3> dot", "[Vector]")
 	}
 
 	CHECK(a->dot(b) == Approx(expected_value));
-}
\ No newline at end of file
+}
+TEST_CASE("Vector<3> multiDot", "[Vector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	auto a = make_shared<MockVector<3>>(MPI_COMM_WORLD, num_components, num_local_patches,
+	                                    num_ghost_cells, ns);
+	auto b = make_shared<MockVector<3>>(MPI_COMM_WORLD, num_components, num_local_patches,
+	                                    num_ghost_cells, ns);
+	auto c = make_shared<MockVector<3>>(MPI_COMM_WORLD, num_components, num_local_patches,
+	                                    num_ghost_cells, ns);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+	INFO("num_components:    " << num_components);
+
+	for (size_t i = 0; i < a->data.size(); i++) {
+		double x   = (i + 0.5) / a->data.size();
+		a->data[i] = 10 - (x - 0.75) * (x - 0.75);
+		b->data[i] = (x - 0.5) * (x - 0.5);
+		c->data[i] = 3 * x;
+	}
+
+	vector<double> dots = a->multiDot({b, c, a});
+	REQUIRE(dots.size() == 3);
+	CHECK(dots[0] == Approx(a->dot(b)));
+	CHECK(dots[1] == Approx(a->dot(c)));
+	CHECK(dots[2] == Approx(a->dot(a)));
+
+	vector<double> dots_and_norm = a->multiDotAndTwoNorm({c});
+	REQUIRE(dots_and_norm.size() == 2);
+	CHECK(dots_and_norm[0] == Approx(a->dot(c)));
+	CHECK(dots_and_norm[1] == Approx(a->twoNorm()));
+
+	vector<double> dots_and_self_dot = a->multiDotAndSelfDot({c});
+	REQUIRE(dots_and_self_dot.size() == 2);
+	CHECK(dots_and_self_dot[0] == Approx(a->dot(c)));
+	CHECK(dots_and_self_dot[1] == Approx(a->dot(a)));
+}
+TEST_CASE("Vector<3> dotStart and twoNormStart", "[Vector]")
+{
+	int           num_components    = GENERATE(1, 2, 3);
+	auto          num_ghost_cells   = GENERATE(0, 1, 5);
+	int           nx                = GENERATE(1, 4, 5);
+	int           ny                = GENERATE(1, 4, 5);
+	int           nz                = GENERATE(1, 4, 5);
+	array<int, 3> ns                = {nx, ny, nz};
+	int           num_local_patches = GENERATE(1, 13);
+
+	auto a = make_shared<MockVector<3>>(MPI_COMM_WORLD, num_components, num_local_patches,
+	                                    num_ghost_cells, ns);
+	auto b = make_shared<MockVector<3>>(MPI_COMM_WORLD, num_components, num_local_patches,
+	                                    num_ghost_cells, ns);
+
+	INFO("num_ghost_cells:   " << num_ghost_cells);
+	INFO("nx:                " << nx);
+	INFO("ny:                " << ny);
+	INFO("nz:                " << nz);
+	INFO("num_local_patches: " << num_local_patches);
+	INFO("num_components:    " << num_components);
+
+	for (size_t i = 0; i < a->data.size(); i++) {
+		double x   = (i + 0.5) / a->data.size();
+		a->data[i] = 10 - (x - 0.75) * (x - 0.75);
+		b->data[i] = (x - 0.5) * (x - 0.5);
+	}
+
+	ReductionRequest dot_request  = a->dotStart(b);
+	ReductionRequest norm_request = b->twoNormStart();
+
+	CHECK(b->twoNormFinish(norm_request) == Approx(b->twoNorm()));
+	CHECK(a->dotFinish(dot_request) == Approx(a->dot(b)));
+}
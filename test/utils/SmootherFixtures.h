@@ -0,0 +1,133 @@
+/***************************************************************************
+ *  ThunderEgg, a library for solving Poisson's equation on adaptively
+ *  refined block-structured Cartesian grids
+ *
+ *  Copyright (C) 2019-2020 ThunderEgg Developers. See AUTHORS.md file at the
+ *  top-level directory.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ ***************************************************************************/
+#include <ThunderEgg/BiLinearGhostFiller.h>
+#include <ThunderEgg/DomainTools.h>
+#include <ThunderEgg/Poisson/StarPatchOperator.h>
+#include <ThunderEgg/ValVector.h>
+#include <ThunderEgg/VarPoisson/StarPatchOperator.h>
+#include <map>
+#include <string>
+/*
+ * Problems shared by the tests for the GMG smoothers
+ */
+const std::string uniform_mesh_file = "mesh_inputs/2d_uniform_4x4_mpi1.json";
+const std::string refined_mesh_file = "mesh_inputs/2d_uniform_2x2_refined_nw_mpi1.json";
+/**
+ * @brief Get an operator to smooth with
+ *
+ * @param domain the domain
+ * @param type "Poisson", "Neumann", or "VarPoisson"
+ */
+inline std::shared_ptr<ThunderEgg::PatchOperator<2>>
+GetOperator(std::shared_ptr<ThunderEgg::Domain<2>> domain, const std::string &type)
+{
+	auto gf = std::make_shared<ThunderEgg::BiLinearGhostFiller>(domain);
+	if (type == "VarPoisson") {
+		auto hfun = [](const std::array<double, 2> &coord) {
+			return 1 + coord[0] * coord[1];
+		};
+		auto h_vec = ThunderEgg::ValVector<2>::GetNewVector(domain, 1);
+		ThunderEgg::DomainTools::SetValuesWithGhost<2>(domain, h_vec, hfun);
+		return std::make_shared<ThunderEgg::VarPoisson::StarPatchOperator<2>>(h_vec, domain, gf);
+	}
+	return std::make_shared<ThunderEgg::Poisson::StarPatchOperator<2>>(domain, gf,
+	                                                                   type == "Neumann");
+}
+/**
+ * @brief The exact solution used for the smoother problems
+ */
+inline double gfun(const std::array<double, 2> &coord)
+{
+	double x = coord[0];
+	double y = coord[1];
+	return sin(M_PI * y) * cos(2 * M_PI * x);
+}
+/**
+ * @brief Number of cells along each axis of the single patch domain
+ */
+constexpr int single_n = 3;
+/**
+ * @brief Cell spacing of the single patch domain
+ */
+constexpr double single_h = 0.5;
+/**
+ * @brief Get a domain with a single patch that has Dirichlet boundaries on all sides
+ */
+inline std::shared_ptr<ThunderEgg::Domain<2>> GetSinglePatchDomain()
+{
+	std::map<int, std::shared_ptr<ThunderEgg::PatchInfo<2>>> pinfo_map;
+	pinfo_map[0].reset(new ThunderEgg::PatchInfo<2>());
+	pinfo_map[0]->id              = 0;
+	pinfo_map[0]->ns              = {single_n, single_n};
+	pinfo_map[0]->spacings        = {single_h, single_h};
+	pinfo_map[0]->starts          = {0, 0};
+	pinfo_map[0]->num_ghost_cells = 1;
+	return std::shared_ptr<ThunderEgg::Domain<2>>(
+	new ThunderEgg::Domain<2>(pinfo_map, {single_n, single_n}, 1));
+}
+/**
+ * @brief Values on the single patch, indexed by [xi][yi]
+ */
+using SinglePatchValues = std::array<std::array<double, single_n>, single_n>;
+/**
+ * @brief The 5-point Laplacian at a cell of the single patch, the Dirichlet ghost values are minus
+ * the adjacent cell
+ */
+inline double HandLaplacian(const SinglePatchValues &u, int xi, int yi)
+{
+	auto value = [&](int nxi, int nyi) {
+		bool outside = nxi < 0 || nxi >= single_n || nyi < 0 || nyi >= single_n;
+		return outside ? -u[xi][yi] : u[nxi][nyi];
+	};
+	double sum = value(xi - 1, yi) + value(xi + 1, yi) + value(xi, yi - 1) + value(xi, yi + 1);
+	return (sum - 4 * u[xi][yi]) / (single_h * single_h);
+}
+/**
+ * @brief The diagonal of the Laplacian at a cell of the single patch
+ */
+inline double HandDiagonal(int xi, int yi)
+{
+	int num_boundary_sides = (xi == 0) + (xi == single_n - 1) + (yi == 0) + (yi == single_n - 1);
+	return (-4.0 - num_boundary_sides) / (single_h * single_h);
+}
+/**
+ * @brief Fill a vector on the single patch domain with values
+ */
+inline void SetSinglePatchValues(std::shared_ptr<ThunderEgg::Vector<2>> vec,
+                                 const SinglePatchValues &              values)
+{
+	ThunderEgg::LocalData<2> ld = vec->getLocalData(0, 0);
+	ThunderEgg::nested_loop<2>(ld.getStart(), ld.getEnd(), [&](const std::array<int, 2> &coord) {
+		ld[coord] = values[coord[0]][coord[1]];
+	});
+}
+/**
+ * @brief The initial guess and rhs for the single patch tests
+ */
+inline void GetSinglePatchProblem(SinglePatchValues &u, SinglePatchValues &f)
+{
+	for (int xi = 0; xi < single_n; xi++) {
+		for (int yi = 0; yi < single_n; yi++) {
+			u[xi][yi] = 1 + xi + 3 * yi + 0.25 * xi * yi;
+			f[xi][yi] = xi - 2 * yi;
+		}
+	}
+}